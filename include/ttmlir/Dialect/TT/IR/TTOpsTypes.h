@@ -28,4 +28,21 @@ inline bool isDeviceMemorySpace(MemorySpace memorySpace) {
 #define GET_TYPEDEF_CLASSES
 #include "ttmlir/Dialect/TT/IR/TTOpsTypes.h.inc"
 
+namespace mlir::tt {
+// Number of elements in a shape, 1 for a scalar.
+uint64_t getVolume(ArrayRef<int64_t> shape);
+
+// Bytes of one element of a memref. A tile is a single element covering all
+// of its scalars, so this times the volume of a tiled shape is its size.
+uint64_t getElementSizeBytes(Type elementType);
+
+// Bytes of a memref, for a layout memref that is the shard held by one core.
+uint64_t getMemrefSizeBytes(MemRefType memrefType);
+
+// Bytes a tensor occupies on device across all cores of its layout grid,
+// including any padding to whole tiles or grid blocks. Tensors without a
+// layout are sized by their element type.
+uint64_t getTensorSizeBytes(RankedTensorType tensorType);
+} // namespace mlir::tt
+
 #endif
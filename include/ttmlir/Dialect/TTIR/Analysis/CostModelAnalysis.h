@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTMLIR_DIALECT_TTIR_ANALYSIS_COSTMODELANALYSIS_H
+#define TTMLIR_DIALECT_TTIR_ANALYSIS_COSTMODELANALYSIS_H
+
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
+#include "ttmlir/Dialect/TTIR/Analysis/TTIRAnalysis.h"
+
+namespace mlir::tt::ttir {
+
+struct CostModelAnalysisInput {
+  ChipDescAttr chipDesc;
+  // Layout of the op result, its grid is replaced by the grid below.
+  LayoutAttr layout;
+  GridAttr grid;
+
+  CostModelAnalysisInput()
+      : chipDesc(nullptr), layout(nullptr), grid(nullptr) {}
+
+  CostModelAnalysisInput(ChipDescAttr chipDesc, LayoutAttr layout,
+                         GridAttr grid)
+      : chipDesc(chipDesc), layout(layout), grid(grid) {}
+
+  bool operator==(const CostModelAnalysisInput &rhs) const {
+    return chipDesc == rhs.chipDesc && layout == rhs.layout && grid == rhs.grid;
+  }
+
+  bool operator!=(const CostModelAnalysisInput &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+struct CostModelAnalysisResult {
+  // Estimated cycles from dispatch until the last core finishes.
+  uint64_t cycles = 0;
+  // Peak L1 bytes needed on a single core.
+  uint64_t l1Bytes = 0;
+  // Bytes moved over the NOC across all cores.
+  uint64_t nocBytes = 0;
+};
+
+// Analytical cost of running an op with its result placed on a given grid.
+// Covers eltwise, matmul, reduction and softmax ops, layout changes are
+// costed as pure data movement and allocations are free.
+//
+class CostModelAnalysis
+    : public TTIRAnalysis<CostModelAnalysisInput, CostModelAnalysisResult> {
+private:
+  void analysisImplementation() override;
+  bool applyOverrides() override;
+
+public:
+  CostModelAnalysis(Operation *op) : TTIRAnalysis(op) {}
+
+  // Cycles needed to move the given number of bytes over the NOC.
+  static uint64_t getNocCycles(ChipDescAttr chipDesc, uint64_t bytes);
+};
+
+} // namespace mlir::tt::ttir
+
+#endif // TTMLIR_DIALECT_TTIR_ANALYSIS_COSTMODELANALYSIS_H
@@ -11,16 +11,18 @@
 namespace mlir::tt::ttir {
 
 struct OptimalTargetGridAnalysisInput {
+  ChipDescAttr chipDesc;
   llvm::DenseMap<Operation *, std::vector<GridAttr>> legalGrids;
 
-  OptimalTargetGridAnalysisInput() : legalGrids() {}
+  OptimalTargetGridAnalysisInput() : chipDesc(nullptr), legalGrids() {}
 
   OptimalTargetGridAnalysisInput(
+      ChipDescAttr chipDesc,
       const llvm::DenseMap<Operation *, std::vector<GridAttr>> &&legalGrids)
-      : legalGrids(std::move(legalGrids)) {}
+      : chipDesc(chipDesc), legalGrids(std::move(legalGrids)) {}
 
   bool operator==(const OptimalTargetGridAnalysisInput &rhs) const {
-    return legalGrids == rhs.legalGrids;
+    return chipDesc == rhs.chipDesc && legalGrids == rhs.legalGrids;
   }
 
   bool operator!=(const OptimalTargetGridAnalysisInput &rhs) const {
@@ -30,6 +32,12 @@ struct OptimalTargetGridAnalysisInput {
 
 // Determine optimal target grid size for each op.
 //
+// Picks one legal grid per op minimizing the estimated compute cost of all ops
+// plus the cost of resharding tensors between producers and consumers that
+// end up on different grids. Solved exactly with dynamic programming on
+// chains, for ops with several consumers the producer cost is accounted once
+// per consumer which makes it a heuristic on general DAGs.
+//
 class OptimalTargetGridAnalysis
     : public TTIRAnalysis<OptimalTargetGridAnalysisInput,
                           llvm::DenseMap<Operation *, GridAttr>> {
@@ -38,6 +46,10 @@ private:
   void analysisImplementation() override;
   bool applyOverrides() override;
 
+  uint64_t getComputeCost(Operation *op, GridAttr grid) const;
+  uint64_t getReshardCost(OpOperand &operand, GridAttr producerGrid,
+                          GridAttr consumerGrid) const;
+
 public:
   OptimalTargetGridAnalysis(Operation *op) : TTIRAnalysis(op) {}
 };
@@ -123,12 +123,97 @@ public:
                   ConversionPatternRewriter &rewriter) const override {
     rewriter.replaceOpWithNewOp<ttnn::MatmulOp>(
         op, this->getTypeConverter()->convertType(op.getType()), adaptor.getA(),
-        adaptor.getB(), adaptor.getOutput());
+        adaptor.getB(), /*bias=*/Value(), adaptor.getOutput());
     return success();
   }
 };
 // ANCHOR_END: adding_an_op_matmul_op_rewriter
 
+// Returns the eltwise op consuming value as one of its inputs if that is the
+// only use of value and the op produces a result of the same type.
+//
+template <typename EltwiseOp>
+static EltwiseOp getSingleEltwiseUser(Value value) {
+  if (!value.hasOneUse()) {
+    return nullptr;
+  }
+  OpOperand &use = *value.getUses().begin();
+  auto eltwiseOp = dyn_cast<EltwiseOp>(use.getOwner());
+  if (!eltwiseOp || eltwiseOp.isDpsInit(&use) ||
+      eltwiseOp->getNumResults() != 1 ||
+      eltwiseOp->getResult(0).getType() != value.getType()) {
+    return nullptr;
+  }
+  return eltwiseOp;
+}
+
+// Returns true if bias is a single row, [N] or [1, ..., 1, N], matching the
+// columns of output. ttnn's matmul broadcasts its bias over the rows of the
+// product, so only such a bias computes the same sum as the add it replaces.
+//
+static bool isRowBroadcastBias(Value bias, Value output) {
+  auto biasType = mlir::cast<RankedTensorType>(bias.getType());
+  auto outputType = mlir::cast<RankedTensorType>(output.getType());
+  auto biasShape = biasType.getShape();
+  auto outputShape = outputType.getShape();
+  if (biasShape.empty() || biasShape.size() > outputShape.size() ||
+      biasShape.back() != outputShape.back()) {
+    return false;
+  }
+  return llvm::all_of(biasShape.drop_back(),
+                      [](int64_t dim) { return dim == 1; });
+}
+
+// Folds matmul -> add -> relu chains into a single ttnn.matmul with a bias and
+// activation epilogue, so the intermediate products never round trip through
+// memory. The relu is optional, and adds of anything but a row bias are left
+// unfused. Registered with a higher benefit than the plain matmul pattern so it
+// is tried first.
+//
+class MatmulBiasActivationConversionPattern
+    : public OpConversionPattern<ttir::MatmulOp> {
+public:
+  using OpConversionPattern<ttir::MatmulOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(ttir::MatmulOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto addOp = getSingleEltwiseUser<ttir::AddOp>(op.getResult());
+    if (!addOp || addOp.getInputs().size() != 2) {
+      return rewriter.notifyMatchFailure(op, "result is not biased by an add");
+    }
+    Value bias = addOp.getInputs()[0] == op.getResult() ? addOp.getInputs()[1]
+                                                        : addOp.getInputs()[0];
+    if (!isRowBroadcastBias(bias, op.getResult())) {
+      return rewriter.notifyMatchFailure(op, "bias is not a row broadcast");
+    }
+
+    Operation *epilogue = addOp;
+    Value output = addOp.getOutputs()[0];
+    auto activation = ttnn::MatmulActivation::None;
+    if (auto reluOp = getSingleEltwiseUser<ttir::ReluOp>(addOp->getResult(0))) {
+      epilogue = reluOp;
+      output = reluOp.getOutputs()[0];
+      activation = ttnn::MatmulActivation::Relu;
+    }
+
+    // The bias and epilogue output are only guaranteed to dominate the last op
+    // of the chain.
+    //
+    rewriter.setInsertionPoint(epilogue);
+    auto matmulOp = rewriter.create<ttnn::MatmulOp>(
+        epilogue->getLoc(),
+        this->getTypeConverter()->convertType(epilogue->getResult(0).getType()),
+        adaptor.getA(), adaptor.getB(), bias, output, activation);
+    rewriter.replaceOp(epilogue, matmulOp.getResult());
+    if (epilogue != addOp) {
+      rewriter.eraseOp(addOp);
+    }
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
 namespace mlir::tt {
 
 void populateTTIRToTTNNPatterns(MLIRContext *ctx, RewritePatternSet &patterns,
@@ -149,6 +234,8 @@ void populateTTIRToTTNNPatterns(MLIRContext *ctx, RewritePatternSet &patterns,
            >(typeConverter, ctx);
   // ANCHOR_END: adding_an_op_matmul_rewrite_pattern_set
   // clang-format on
+  patterns.add<MatmulBiasActivationConversionPattern>(typeConverter, ctx,
+                                                      /*benefit=*/2);
 }
 
 } // namespace mlir::tt
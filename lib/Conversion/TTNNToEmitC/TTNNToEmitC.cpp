@@ -74,6 +74,56 @@ public:
   }
 };
 
+// Matmul op conversion pattern. A plain matmul converts like any other op.
+// With a bias or an activation the fused overload is called the way the
+// runtime calls it: no destination, default program config, DRAM memory
+// config and dtype, then the activation name.
+//
+class MatmulOpConversionPattern
+    : public DefaultOpConversionPattern<ttnn::MatmulOp> {
+  using DefaultOpConversionPattern<ttnn::MatmulOp>::DefaultOpConversionPattern;
+
+public:
+  LogicalResult
+  matchAndRewrite(ttnn::MatmulOp srcOp, ttnn::MatmulOp::Adaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    bool hasActivation =
+        srcOp.getActivation() != ttnn::MatmulActivation::None;
+    if (not adaptor.getBias() and not hasActivation) {
+      return DefaultOpConversionPattern<ttnn::MatmulOp>::matchAndRewrite(
+          srcOp, adaptor, rewriter);
+    }
+
+    MLIRContext *ctx = rewriter.getContext();
+    SmallVector<Value> operands = {adaptor.getA(), adaptor.getB()};
+    SmallVector<Attribute> args = {rewriter.getIndexAttr(0),
+                                   rewriter.getIndexAttr(1)};
+    if (adaptor.getBias()) {
+      operands.push_back(adaptor.getBias());
+      args.push_back(rewriter.getIndexAttr(2));
+    } else {
+      args.push_back(emitc::OpaqueAttr::get(ctx, "std::nullopt"));
+    }
+    args.push_back(emitc::OpaqueAttr::get(ctx, "std::monostate{}"));
+    args.push_back(emitc::OpaqueAttr::get(ctx, "ttnn::DRAM_MEMORY_CONFIG"));
+    args.push_back(emitc::OpaqueAttr::get(ctx, "std::nullopt"));
+    args.push_back(emitc::OpaqueAttr::get(
+        ctx, hasActivation
+                 ? "\"" +
+                       ttnn::stringifyMatmulActivation(srcOp.getActivation())
+                           .str() +
+                       "\""
+                 : std::string("std::nullopt")));
+
+    auto resultTy = cast<emitc::OpaqueType>(
+        this->getTypeConverter()->convertType(srcOp.getResult().getType()));
+    rewriter.replaceOpWithNewOp<emitc::CallOpaqueOp>(
+        srcOp, resultTy, "ttnn::operations::matmul::matmul",
+        rewriter.getArrayAttr(args), nullptr, operands);
+    return success();
+  }
+};
+
 } // namespace
 
 namespace mlir::tt {
@@ -114,7 +164,7 @@ void populateTTNNToEmitCPatterns(mlir::MLIRContext *ctx,
 
   // Matmul ops
   //
-  patterns.add<DefaultOpConversionPattern<ttnn::MatmulOp>>(typeConverter, ctx);
+  patterns.add<MatmulOpConversionPattern>(typeConverter, ctx);
 
   // Reduction ops
   //
@@ -277,6 +277,13 @@ LayoutAttr LayoutAttr::withElementType(::mlir::MLIRContext *context,
       buildMemRef(context, getShardShape(), elementType, getMemorySpace()));
 }
 
+LayoutAttr LayoutAttr::withMemorySpace(::mlir::MLIRContext *context,
+                                       MemorySpace memorySpace) {
+  return LayoutAttr::get(
+      context, getLinear(), getOobVal(), getGrid(),
+      buildMemRef(context, getShardShape(), getElementType(), memorySpace));
+}
+
 MemorySpace LayoutAttr::getMemorySpace() const {
   return getMemref()
       .getMemorySpace()
@@ -368,6 +375,62 @@ TileType::getTiledShape(SmallVector<int64_t> scalarShape) const {
   return scalarShape;
 }
 
+uint64_t TileType::getSizeBytes() const {
+  uint64_t numElements = getHeight() * getWidth();
+  switch (getDataType()) {
+  case DataType::Float32:
+  case DataType::UInt32:
+    return numElements * 4;
+  case DataType::Float16:
+  case DataType::BFloat16:
+  case DataType::UInt16:
+    return numElements * 2;
+  case DataType::UInt8:
+    return numElements;
+  // Block floating point formats store a shared 8-bit exponent for every 16
+  // elements followed by the packed mantissas.
+  //
+  case DataType::BFP_Float8:
+  case DataType::BFP_BFloat8:
+    return numElements + numElements / 16;
+  case DataType::BFP_Float4:
+  case DataType::BFP_BFloat4:
+    return numElements / 2 + numElements / 16;
+  case DataType::BFP_Float2:
+  case DataType::BFP_BFloat2:
+    return numElements / 4 + numElements / 16;
+  }
+  llvm_unreachable("Unknown DataType");
+}
+
+uint64_t mlir::tt::getVolume(ArrayRef<int64_t> shape) {
+  return std::accumulate(shape.begin(), shape.end(), uint64_t(1),
+                         std::multiplies<uint64_t>());
+}
+
+uint64_t mlir::tt::getElementSizeBytes(Type elementType) {
+  if (auto tileType = elementType.dyn_cast<TileType>()) {
+    return tileType.getSizeBytes();
+  }
+  assert(elementType.isIntOrFloat() && "Unsupported element type");
+  return (elementType.getIntOrFloatBitWidth() + 7) / 8;
+}
+
+uint64_t mlir::tt::getMemrefSizeBytes(MemRefType memrefType) {
+  return getVolume(memrefType.getShape()) *
+         getElementSizeBytes(memrefType.getElementType());
+}
+
+uint64_t mlir::tt::getTensorSizeBytes(RankedTensorType tensorType) {
+  auto layout = tensorType.getEncoding().dyn_cast_or_null<LayoutAttr>();
+  if (not layout) {
+    return getVolume(tensorType.getShape()) *
+           getElementSizeBytes(tensorType.getElementType());
+  }
+  return getMemrefSizeBytes(layout.getMemref()) *
+         getVolume(layout.getGrid().getShape());
+}
+
 void TTDialect::registerTypes() {
   // NOLINTNEXTLINE
   addTypes<
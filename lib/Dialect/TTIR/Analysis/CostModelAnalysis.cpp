@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TTIR/Analysis/CostModelAnalysis.h"
+
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "ttmlir/Dialect/TTIR/IR/TTIROps.h"
+
+namespace mlir::tt::ttir {
+
+namespace {
+// Per architecture figures the chip description does not carry. Compute
+// figures are for a single core processing one 32x32 tile, bandwidth figures
+// are per NOC link and per DRAM channel. L1 size and DRAM channel count come
+// from the chip description.
+//
+struct ArchParams {
+  uint64_t launchCycles;
+  uint64_t fpuCyclesPerTile;
+  uint64_t sfpuCyclesPerTile;
+  uint64_t matmulCyclesPerTile;
+  uint64_t nocBytesPerCycle;
+  uint64_t dramBytesPerCycle;
+};
+} // namespace
+
+static constexpr int64_t kTileDim = 32;
+
+// NOC links are 256 bits wide up to Wormhole and 512 bits on Blackhole.
+//
+static constexpr uint64_t kNocBytesPerCycleGrayskull = 32;
+static constexpr uint64_t kNocBytesPerCycleWormhole = 32;
+static constexpr uint64_t kNocBytesPerCycleBlackhole = 64;
+
+static ArchParams getArchParams(Arch arch) {
+  switch (arch) {
+  case Arch::Grayskull:
+    return {10000, 32, 64, 128, kNocBytesPerCycleGrayskull, 16};
+  case Arch::WormholeB0:
+    return {10000, 32, 64, 64, kNocBytesPerCycleWormhole, 32};
+  case Arch::Blackhole:
+    return {10000, 16, 32, 32, kNocBytesPerCycleBlackhole, 64};
+  }
+  llvm_unreachable("Unknown Arch");
+}
+
+static uint64_t ceilDiv(uint64_t a, uint64_t b) { return (a + b - 1) / b; }
+
+// Bytes of one 32x32 tile worth of elements.
+//
+static uint64_t getTileSizeBytes(Type elementType) {
+  if (auto tileType = elementType.dyn_cast<TileType>()) {
+    return tileType.getSizeBytes();
+  }
+  return kTileDim * kTileDim * getElementSizeBytes(elementType);
+}
+
+// Number of tiles covering a shape, memrefs of tiles are already counted in
+// tiles.
+//
+static uint64_t getNumTiles(ArrayRef<int64_t> shape, Type elementType) {
+  if (elementType.isa<TileType>() or shape.empty()) {
+    return getVolume(shape);
+  }
+  if (shape.size() == 1) {
+    return ceilDiv(shape[0], kTileDim);
+  }
+  return getVolume(shape.drop_back(2)) *
+         ceilDiv(shape[shape.size() - 2], kTileDim) *
+         ceilDiv(shape[shape.size() - 1], kTileDim);
+}
+
+static bool isInL1(RankedTensorType tensorType) {
+  auto layout = tensorType.getEncoding().dyn_cast_or_null<LayoutAttr>();
+  return layout and layout.getMemorySpace() == MemorySpace::DeviceL1;
+}
+
+uint64_t CostModelAnalysis::getNocCycles(ChipDescAttr chipDesc,
+                                         uint64_t bytes) {
+  ArchParams params = getArchParams(chipDesc.getArch().getValue());
+  return params.launchCycles + ceilDiv(bytes, params.nocBytesPerCycle);
+}
+
+bool CostModelAnalysis::applyOverrides() {
+  // No overrides for the cost model.
+  //
+  return false;
+}
+
+void CostModelAnalysis::analysisImplementation() {
+  analysisResult = CostModelAnalysisResult();
+  if (isa<tensor::EmptyOp>(op) or op->getNumResults() == 0) {
+    return;
+  }
+  auto tensorType = op->getResult(0).getType().dyn_cast<RankedTensorType>();
+  if (not tensorType or not analysisInput.layout) {
+    return;
+  }
+
+  ChipDescAttr chipDesc = analysisInput.chipDesc;
+  ArchParams params = getArchParams(chipDesc.getArch().getValue());
+
+  LayoutAttr layout = analysisInput.layout.withGrid(
+      op->getContext(), tensorType.getShape(), analysisInput.grid);
+  MemRefType shard = layout.getMemref();
+  Type elementType = layout.getElementType();
+  uint64_t cores = getVolume(analysisInput.grid.getShape());
+  uint64_t shardSizeBytes = getMemrefSizeBytes(shard);
+  uint64_t shardTiles = getNumTiles(shard.getShape(), elementType);
+  uint64_t tileSizeBytes = getTileSizeBytes(elementType);
+
+  // Operands living outside of L1 are streamed in from DRAM or host.
+  //
+  uint64_t dramBytes = 0;
+  SmallVector<RankedTensorType> inputTypes;
+  auto dps = dyn_cast<DestinationStyleOpInterface>(op);
+  for (OpOperand &operand : op->getOpOperands()) {
+    auto operandType = operand.get().getType().dyn_cast<RankedTensorType>();
+    if (not operandType or (dps and dps.isDpsInit(&operand))) {
+      continue;
+    }
+    inputTypes.push_back(operandType);
+    if (not isInL1(operandType)) {
+      dramBytes += getTensorSizeBytes(operandType);
+    }
+  }
+
+  uint64_t computeCycles = 0;
+  uint64_t l1Bytes = shardSizeBytes;
+  uint64_t nocBytes = 0;
+  if (isa<ToLayoutOp>(op)) {
+    // Pure data movement, every byte of the tensor crosses the NOC.
+    //
+    nocBytes = getTensorSizeBytes(tensorType);
+    dramBytes = 0;
+  } else if (isa<MatmulOp>(op)) {
+    // Each core owns an output block and needs the full K extent of the
+    // matching row panel of A and column panel of B.
+    //
+    ArrayRef<int64_t> shardShape = shard.getShape();
+    uint64_t mTiles = getNumTiles(shardShape.take_back(2).take_front(),
+                                  elementType);
+    uint64_t nTiles = getNumTiles(shardShape.take_back(), elementType);
+    ArrayRef<int64_t> aShape = inputTypes.front().getShape();
+    uint64_t kTiles = ceilDiv(aShape[aShape.size() - 1], kTileDim);
+    uint64_t panelBytes = (mTiles + nTiles) * kTiles * tileSizeBytes;
+    computeCycles = mTiles * nTiles * kTiles * params.matmulCyclesPerTile;
+    l1Bytes += panelBytes;
+    nocBytes = cores * panelBytes;
+  } else if (isa<SumOp>(op)) {
+    // Every core reduces its slice of the input, partials are gathered into
+    // the output shards.
+    //
+    uint64_t inputTiles =
+        getNumTiles(inputTypes.front().getShape(), elementType);
+    uint64_t inputTilesPerCore = ceilDiv(inputTiles, cores);
+    computeCycles = inputTilesPerCore * params.fpuCyclesPerTile;
+    l1Bytes += inputTilesPerCore * tileSizeBytes;
+    nocBytes = cores > 1 ? cores * shardSizeBytes : 0;
+  } else if (auto softmax = dyn_cast<SoftmaxOp>(op)) {
+    // exp, row sum, reciprocal and scale. When the softmax dimension is split
+    // across cores the row partials have to be exchanged.
+    //
+    computeCycles =
+        shardTiles * (3 * params.fpuCyclesPerTile + params.sfpuCyclesPerTile);
+    l1Bytes += shardSizeBytes;
+    int64_t rank = tensorType.getRank();
+    int64_t dimension = softmax.getDimension();
+    dimension = dimension < 0 ? dimension + rank : dimension;
+    ArrayRef<int64_t> gridShape = analysisInput.grid.getShape();
+    if (dimension == rank - 1 and gridShape.back() > 1 and
+        shard.getRank() >= 2) {
+      uint64_t rows = shard.getShape()[shard.getRank() - 2];
+      nocBytes = cores * (gridShape.back() - 1) * rows * tileSizeBytes /
+                 (kTileDim * kTileDim);
+    }
+  } else {
+    // Eltwise and anything else is modelled as one pass over its tiles.
+    //
+    bool sfpu = isa<ReluOp, GreaterEqualOp>(op);
+    computeCycles = shardTiles * (sfpu ? params.sfpuCyclesPerTile
+                                       : params.fpuCyclesPerTile);
+    l1Bytes += inputTypes.size() * shardSizeBytes;
+  }
+
+  // Whatever does not fit in L1 is streamed through DRAM instead.
+  //
+  if (l1Bytes > chipDesc.getL1Size()) {
+    dramBytes += cores * (l1Bytes - chipDesc.getL1Size());
+  }
+
+  uint64_t dramCycles = ceilDiv(
+      dramBytes, params.dramBytesPerCycle * chipDesc.getNumDramChannels());
+  uint64_t nocCycles = ceilDiv(nocBytes, cores * params.nocBytesPerCycle);
+
+  analysisResult.cycles =
+      params.launchCycles + computeCycles + dramCycles + nocCycles;
+  analysisResult.l1Bytes = l1Bytes;
+  analysisResult.nocBytes = nocBytes + dramBytes;
+}
+} // namespace mlir::tt::ttir
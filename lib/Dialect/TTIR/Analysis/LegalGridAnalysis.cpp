@@ -4,6 +4,8 @@
 
 #include "ttmlir/Dialect/TTIR/Analysis/LegalGridAnalysis.h"
 
+#include <limits>
+
 namespace mlir::tt::ttir {
 
 bool LegalGridAnalysis::applyOverrides() {
@@ -27,11 +29,62 @@ bool LegalGridAnalysis::applyOverrides() {
 }
 
 void LegalGridAnalysis::analysisImplementation() {
-  // Placeholder, needs to be implemented. Go through all the grid sizes and
-  // check if they are legal based on tensor type and device/chip attributes.
-  // For now result of analysis is maximum supported grid size.
+  analysisResult.clear();
+  ArrayRef<int64_t> maxShape = analysisInput.maxGrid.getShape();
+  LayoutAttr layout = analysisInput.tensorType.getEncoding()
+                          .template dyn_cast_or_null<LayoutAttr>();
+
+  // Enumerate every grid up to the device grid that evenly divides the
+  // physical shape of the tensor. For tiled tensors divisibility is in units
+  // of whole tiles. Grids whose L1 shard would not fit are dropped.
   //
-  analysisResult.push_back(
-      GridAttr::get(op->getContext(), analysisInput.maxGrid.getShape()));
+  if (layout and layout.getGrid().getShape().size() == maxShape.size()) {
+    SmallVector<int64_t> physicalShape =
+        layout.getPhysicalShape(analysisInput.tensorType.getShape());
+    Type elementType = layout.getElementType();
+    if (auto tileType = elementType.dyn_cast<TileType>()) {
+      physicalShape = tileType.getTiledShape(physicalShape);
+    }
+    uint64_t elementSizeBytes = getElementSizeBytes(elementType);
+    uint64_t l1Size = layout.getMemorySpace() == MemorySpace::DeviceL1
+                          ? analysisInput.chipDesc.getL1Size()
+                          : std::numeric_limits<uint64_t>::max();
+
+    SmallVector<int64_t> grid(maxShape.begin(), maxShape.end());
+    while (true) {
+      bool divides = true;
+      uint64_t shardSizeBytes = elementSizeBytes;
+      for (size_t i = 0; i < grid.size(); ++i) {
+        divides &= physicalShape[i] % grid[i] == 0;
+        shardSizeBytes *= physicalShape[i] / grid[i];
+      }
+      if (divides and shardSizeBytes <= l1Size) {
+        analysisResult.push_back(GridAttr::get(op->getContext(), grid));
+      }
+
+      // Step to the next grid shape, counting down from the max grid.
+      //
+      size_t dim = grid.size();
+      while (dim > 0 and grid[dim - 1] == 1) {
+        grid[dim - 1] = maxShape[dim - 1];
+        --dim;
+      }
+      if (dim == 0) {
+        break;
+      }
+      --grid[dim - 1];
+    }
+
+    // Most parallel grids first.
+    //
+    llvm::stable_sort(analysisResult, [](GridAttr a, GridAttr b) {
+      return getVolume(a.getShape()) > getVolume(b.getShape());
+    });
+  }
+
+  if (analysisResult.empty()) {
+    analysisResult.push_back(
+        GridAttr::get(op->getContext(), analysisInput.maxGrid.getShape()));
+  }
 }
 } // namespace mlir::tt::ttir
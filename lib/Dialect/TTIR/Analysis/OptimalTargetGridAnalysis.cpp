@@ -4,6 +4,11 @@
 
 #include "ttmlir/Dialect/TTIR/Analysis/OptimalTargetGridAnalysis.h"
 
+#include "ttmlir/Dialect/TTIR/Analysis/CostModelAnalysis.h"
+#include "ttmlir/Dialect/TTIR/IR/TTIROps.h"
+
+#include <limits>
+
 namespace mlir::tt::ttir {
 
 bool OptimalTargetGridAnalysis::applyOverrides() {
@@ -13,19 +18,108 @@ bool OptimalTargetGridAnalysis::applyOverrides() {
   return false;
 }
 
+static RankedTensorType getResultTensorType(Operation *op) {
+  if (op->getNumResults() == 0) {
+    return nullptr;
+  }
+  return op->getResult(0).getType().dyn_cast<RankedTensorType>();
+}
+
+uint64_t OptimalTargetGridAnalysis::getComputeCost(Operation *op,
+                                                   GridAttr grid) const {
+  RankedTensorType tensorType = getResultTensorType(op);
+  if (not tensorType) {
+    return 0;
+  }
+  auto layout = tensorType.getEncoding().dyn_cast_or_null<LayoutAttr>();
+  CostModelAnalysis costModel(op);
+  costModel.init(CostModelAnalysisInput(analysisInput.chipDesc, layout, grid));
+  return costModel.getResult().cycles;
+}
+
+uint64_t
+OptimalTargetGridAnalysis::getReshardCost(OpOperand &operand,
+                                          GridAttr producerGrid,
+                                          GridAttr consumerGrid) const {
+  // to_layout is free to read any layout, resharding is what it does anyway.
+  // Destinations are retyped onto their op's grid by grid-set, not resharded.
+  //
+  auto toLayout = dyn_cast<ToLayoutOp>(operand.getOwner());
+  bool isLayoutInput = toLayout and &operand == &toLayout.getInputMutable();
+  auto dps = dyn_cast<DestinationStyleOpInterface>(operand.getOwner());
+  bool isDestination = dps and dps.isDpsInit(&operand);
+  if (producerGrid == consumerGrid or isLayoutInput or isDestination) {
+    return 0;
+  }
+
+  auto tensorType = operand.get().getType().dyn_cast<RankedTensorType>();
+  if (not tensorType) {
+    return 0;
+  }
+  return CostModelAnalysis::getNocCycles(analysisInput.chipDesc,
+                                         getTensorSizeBytes(tensorType));
+}
+
 void OptimalTargetGridAnalysis::analysisImplementation() {
+  auto const &legalGrids = analysisInput.legalGrids;
+
+  // Ops in program order, producers always precede their consumers.
+  //
+  SmallVector<Operation *> ops;
+  op->walk<WalkOrder::PreOrder>([&](Operation *nested) {
+    if (legalGrids.count(nested)) {
+      ops.push_back(nested);
+    }
+  });
 
-  // Implement GraphSolver like algorithm to eliminate illegal grid combinations
-  // from graph globaly.
-  // Entry point for graphsolving.
+  // Forward pass: cost[op][i] is the cheapest cost of computing op on its
+  // i-th legal grid including everything feeding into it.
   //
+  llvm::DenseMap<Operation *, SmallVector<uint64_t>> cost;
+  for (Operation *consumer : ops) {
+    auto const &grids = legalGrids.at(consumer);
+    SmallVector<uint64_t> &consumerCost = cost[consumer];
+    consumerCost.resize(grids.size());
+    for (size_t i = 0; i < grids.size(); ++i) {
+      consumerCost[i] = getComputeCost(consumer, grids[i]);
+      for (OpOperand &operand : consumer->getOpOperands()) {
+        Operation *producer = operand.get().getDefiningOp();
+        if (not producer or not cost.count(producer)) {
+          continue;
+        }
+        auto const &producerGrids = legalGrids.at(producer);
+        uint64_t best = std::numeric_limits<uint64_t>::max();
+        for (size_t j = 0; j < producerGrids.size(); ++j) {
+          best = std::min(best, cost[producer][j] +
+                                    getReshardCost(operand, producerGrids[j],
+                                                   grids[i]));
+        }
+        consumerCost[i] += best;
+      }
+    }
+  }
 
-  // Balancer/GridPicker implementation.
-  // Future entrypoint for balancing and picking optimal grid.
-  // Placeholder: pick the first legal grid.
+  // Backward pass: pick each op's grid given the grids already chosen for its
+  // consumers. Ties go to the earlier, more parallel, legal grid.
   //
-  for (auto opGrids : analysisInput.legalGrids) {
-    analysisResult[opGrids.first] = opGrids.second[0];
+  for (Operation *producer : llvm::reverse(ops)) {
+    auto const &grids = legalGrids.at(producer);
+    size_t bestIndex = 0;
+    uint64_t bestCost = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < grids.size(); ++i) {
+      uint64_t total = cost[producer][i];
+      for (OpOperand &use : producer->getUses()) {
+        auto consumerGrid = analysisResult.find(use.getOwner());
+        if (consumerGrid != analysisResult.end()) {
+          total += getReshardCost(use, grids[i], consumerGrid->second);
+        }
+      }
+      if (total < bestCost) {
+        bestCost = total;
+        bestIndex = i;
+      }
+    }
+    analysisResult[producer] = grids[bestIndex];
   }
 }
 } // namespace mlir::tt::ttir
@@ -10,25 +10,31 @@
 #include "mlir/Dialect/MLProgram/IR/MLProgram.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/Dialect/Tosa/IR/TosaOps.h"
+#include "mlir/IR/IRMapping.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Rewrite/FrozenRewritePatternSet.h"
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/Sequence.h"
 #include "ttmlir/Dialect/TT/IR/TT.h"
 #include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
 #include "ttmlir/Dialect/TTIR/IR/TTIROps.h"
 
+#include "ttmlir/Dialect/TTIR/Analysis/CostModelAnalysis.h"
 #include "ttmlir/Dialect/TTIR/Analysis/LegalGridAnalysis.h"
 #include "ttmlir/Dialect/TTIR/Analysis/OptimalTargetGridAnalysis.h"
 #include "ttmlir/Dialect/TTIR/Transforms/Passes.h"
 
 namespace mlir::tt::ttir {
+#define GEN_PASS_DEF_TTIRELTWISEFUSION
 #define GEN_PASS_DEF_TTIRGENERIC
 #define GEN_PASS_DEF_TTIRGENERICREGIONOPERANDSTOMEMREF
 #define GEN_PASS_DEF_TTIRLAYOUT
 #define GEN_PASS_DEF_TTIRALLOCATE
+#define GEN_PASS_DEF_TTIRSPILLTODRAM
 #define GEN_PASS_DEF_TTIRGRIDSET
 #define GEN_PASS_DEF_TTIRIMPLICITDEVICE
+#define GEN_PASS_DEF_TTIRCOSTMODELREPORT
 #include "ttmlir/Dialect/TTIR/Transforms/Passes.h.inc"
 
 class TTIRImplicitDevice
@@ -64,6 +70,28 @@ public:
   }
 };
 
+// Returns the kernel name and kind a named op lowers to, if any.
+//
+static std::optional<std::pair<StringRef, StringRef>>
+getKernelNameAndKind(Operation *op) {
+  if (isa<ttir::MultiplyOp>(op)) {
+    return std::make_pair("mulitply", "eltwise");
+  }
+  if (isa<ttir::AddOp>(op)) {
+    return std::make_pair("add", "eltwise");
+  }
+  if (isa<ttir::SubtractOp>(op)) {
+    return std::make_pair("subtract", "eltwise");
+  }
+  if (isa<ttir::GreaterEqualOp>(op)) {
+    return std::make_pair("ge", "eltwise");
+  }
+  if (isa<ttir::ReluOp>(op)) {
+    return std::make_pair("relu", "eltwise");
+  }
+  return std::nullopt;
+}
+
 template <typename TTIROpTy>
 class TTIRNamedToKernelRewriter : public OpRewritePattern<TTIROpTy> {
 public:
@@ -71,27 +99,12 @@ public:
 
   LogicalResult matchAndRewrite(TTIROpTy op,
                                 PatternRewriter &rewriter) const final {
-    StringRef kernelName;
-    StringRef kernelKind;
-    if constexpr (std::is_same<TTIROpTy, ttir::MultiplyOp>::value) {
-      kernelName = "mulitply";
-      kernelKind = "eltwise";
-    } else if constexpr (std::is_same<TTIROpTy, ttir::AddOp>::value) {
-      kernelName = "add";
-      kernelKind = "eltwise";
-    } else if constexpr (std::is_same<TTIROpTy, ttir::SubtractOp>::value) {
-      kernelName = "subtract";
-      kernelKind = "eltwise";
-    } else if constexpr (std::is_same<TTIROpTy, ttir::GreaterEqualOp>::value) {
-      kernelName = "ge";
-      kernelKind = "eltwise";
-    } else if constexpr (std::is_same<TTIROpTy, ttir::ReluOp>::value) {
-      kernelName = "relu";
-      kernelKind = "eltwise";
-    } else {
+    auto kernelNameAndKind = getKernelNameAndKind(op.getOperation());
+    if (not kernelNameAndKind) {
       return rewriter.notifyMatchFailure(op,
                                          "Unsupported Tosa operation for TTIR");
     }
+    auto [kernelName, kernelKind] = *kernelNameAndKind;
     assert(kernelName.size() > 0);
 
     auto kernel = rewriter.create<ttir::KernelOp>(
@@ -108,7 +121,7 @@ class TTIRKernelGenericRewriter : public OpRewritePattern<KernelOp> {
 public:
   using OpRewritePattern<KernelOp>::OpRewritePattern;
 
-  static bool sameRank(mlir::OperandRange operands) {
+  static bool sameRank(ValueRange operands) {
     if (operands.empty()) {
       return false;
     }
@@ -122,8 +135,7 @@ public:
   }
 
   static std::pair<ArrayAttr, ArrayAttr>
-  createEltwiseIndexingMaps(PatternRewriter &rewriter,
-                            mlir::OperandRange operands) {
+  createEltwiseIndexingMaps(OpBuilder &rewriter, ValueRange operands) {
     assert(sameRank(operands) &&
            "For now all operands must have the same rank");
     auto rank = operands[0].getType().cast<RankedTensorType>().getRank();
@@ -136,8 +148,7 @@ public:
   }
 
   static std::pair<ArrayAttr, ArrayAttr>
-  createMatmulIndexingMaps(PatternRewriter &rewriter,
-                           mlir::OperandRange operands) {
+  createMatmulIndexingMaps(OpBuilder &rewriter, ValueRange operands) {
     assert(sameRank(operands) &&
            "For now all operands must have the same rank");
     auto rank = operands[0].getType().cast<RankedTensorType>().getRank();
@@ -166,8 +177,8 @@ public:
   }
 
   static std::pair<ArrayAttr, ArrayAttr>
-  createIndexingMaps(PatternRewriter &rewriter, StringRef kind,
-                     mlir::OperandRange operands) {
+  createIndexingMaps(OpBuilder &rewriter, StringRef kind,
+                     ValueRange operands) {
     if (kind == "eltwise") {
       return createEltwiseIndexingMaps(rewriter, operands);
     }
@@ -177,9 +188,9 @@ public:
     llvm_unreachable("Unsupported kernel kind");
   }
 
-  static ArrayAttr createOperandConstraints(PatternRewriter &rewriter,
+  static ArrayAttr createOperandConstraints(OpBuilder &rewriter,
                                             StringRef kind,
-                                            mlir::OperandRange operands) {
+                                            ValueRange operands) {
     auto numOperands = operands.size();
     if (kind == "eltwise") {
       return rewriter.getArrayAttr(SmallVector<Attribute>(
@@ -255,6 +266,160 @@ public:
   }
 };
 
+class TTIREltwiseFusion
+    : public impl::TTIREltwiseFusionBase<TTIREltwiseFusion> {
+public:
+  using impl::TTIREltwiseFusionBase<TTIREltwiseFusion>::TTIREltwiseFusionBase;
+
+  // The TTMetal dispatch pushes the circular buffers of the first two
+  // generic operands only, so a fused chain reads at most two inputs.
+  //
+  static constexpr size_t kMaxFusedInputs = 2;
+
+  static bool isFusable(Operation *op) {
+    return isa<TTIR_ElementwiseOpInterface>(op) and op->getNumResults() == 1 and
+           getKernelNameAndKind(op) and
+           getKernelNameAndKind(op)->second == "eltwise";
+  }
+
+  // Returns the consumer op can be fused with, if op's result is read exactly
+  // once, as an input of a same typed eltwise op.
+  //
+  static Operation *getFusableConsumer(Operation *op) {
+    Value result = op->getResult(0);
+    if (not result.hasOneUse()) {
+      return nullptr;
+    }
+    OpOperand &use = *result.getUses().begin();
+    Operation *consumer = use.getOwner();
+    if (not isFusable(consumer) or consumer->getBlock() != op->getBlock() or
+        cast<DestinationStyleOpInterface>(consumer).isDpsInit(&use) or
+        consumer->getResult(0).getType() != result.getType()) {
+      return nullptr;
+    }
+    return consumer;
+  }
+
+  void fuse(IRRewriter &rewriter, ArrayRef<Operation *> chain) {
+    Operation *last = chain.back();
+    Value output =
+        cast<DestinationStyleOpInterface>(last).getDpsInitOperand(0)->get();
+
+    // Inputs coming from outside of the chain, the chained values never
+    // leave the destination register.
+    //
+    llvm::SetVector<Value> inputs;
+    llvm::SmallPtrSet<Operation *, 4> inChain(chain.begin(), chain.end());
+    for (Operation *op : chain) {
+      for (Value input : cast<DestinationStyleOpInterface>(op).getDpsInputs()) {
+        Operation *producer = input.getDefiningOp();
+        if (not producer or not inChain.contains(producer)) {
+          inputs.insert(input);
+        }
+      }
+    }
+
+    SmallVector<Value> operands(inputs.begin(), inputs.end());
+    operands.push_back(output);
+    rewriter.setInsertionPoint(last);
+    auto [indexingMaps, iteratorTypes] =
+        TTIRKernelGenericRewriter::createIndexingMaps(rewriter, "eltwise",
+                                                      operands);
+    auto constraints = TTIRKernelGenericRewriter::createOperandConstraints(
+        rewriter, "eltwise", operands);
+    auto generic = rewriter.create<GenericOp>(
+        last->getLoc(), TypeRange(output.getType()), inputs.getArrayRef(),
+        ValueRange(output), rewriter.getAttr<GridAttr>(), indexingMaps,
+        iteratorTypes, constraints);
+
+    Block *block = rewriter.createBlock(&generic.getRegion());
+    SmallVector<Location> blockArgumentLocs(operands.size(), generic.getLoc());
+    block->addArguments(TypeRange(ValueRange(operands)), blockArgumentLocs);
+    IRMapping mapping;
+    mapping.map(operands, block->getArguments());
+    Value dst = block->getArguments().back();
+
+    // Every kernel accumulates into the output block argument, consumers in
+    // the chain read their producer's result back from it.
+    //
+    Value result;
+    for (Operation *op : chain) {
+      SmallVector<Value> kernelInputs;
+      for (Value input : cast<DestinationStyleOpInterface>(op).getDpsInputs()) {
+        Operation *producer = input.getDefiningOp();
+        kernelInputs.push_back(producer and inChain.contains(producer)
+                                   ? dst
+                                   : mapping.lookup(input));
+      }
+      auto [kernelName, kernelKind] = *getKernelNameAndKind(op);
+      result = rewriter
+                   .create<KernelOp>(op->getLoc(), TypeRange(dst.getType()),
+                                     kernelName, kernelKind, kernelInputs,
+                                     ValueRange(dst))
+                   ->getResult(0);
+    }
+    rewriter.create<YieldOp>(generic.getLoc(), ValueRange(result));
+
+    rewriter.replaceOp(last, generic);
+    for (Operation *op : llvm::reverse(chain.drop_back())) {
+      Value init =
+          cast<DestinationStyleOpInterface>(op).getDpsInitOperand(0)->get();
+      rewriter.eraseOp(op);
+      if (auto empty = init.getDefiningOp<tensor::EmptyOp>();
+          empty and empty->use_empty()) {
+        rewriter.eraseOp(empty);
+      }
+    }
+  }
+
+  void runOnOperation() final {
+    IRRewriter rewriter(&getContext());
+    SmallVector<SmallVector<Operation *>> chains;
+    llvm::SmallPtrSet<Operation *, 16> visited;
+    getOperation()->walk([&](Operation *op) {
+      if (visited.contains(op) or not isFusable(op)) {
+        return;
+      }
+      SmallVector<Operation *> chain = {op};
+      visited.insert(op);
+      auto dpsInputs = cast<DestinationStyleOpInterface>(op).getDpsInputs();
+      llvm::SetVector<Value> inputs(dpsInputs.begin(), dpsInputs.end());
+      Operation *consumer = getFusableConsumer(op);
+      while (consumer and not visited.contains(consumer)) {
+        // Only the previous op of the chain feeds the consumer, its other
+        // inputs come from outside.
+        //
+        llvm::SetVector<Value> fusedInputs = inputs;
+        for (Value input :
+             cast<DestinationStyleOpInterface>(consumer).getDpsInputs()) {
+          if (input.getDefiningOp() != chain.back()) {
+            fusedInputs.insert(input);
+          }
+        }
+        if (fusedInputs.size() > kMaxFusedInputs) {
+          break;
+        }
+        inputs = std::move(fusedInputs);
+        chain.push_back(consumer);
+        visited.insert(consumer);
+        consumer = getFusableConsumer(consumer);
+      }
+      if (chain.size() > 1) {
+        chains.push_back(std::move(chain));
+      }
+    });
+
+    for (auto const &chain : chains) {
+      fuse(rewriter, chain);
+    }
+  }
+
+  void getDependentDialects(mlir::DialectRegistry &registry) const override {
+    registry.insert<mlir::tt::ttir::TTIRDialect>();
+    registry.insert<mlir::tt::TTDialect>();
+  }
+};
+
 class TTIRGenericOperandsToMemrefRewriter : public OpRewritePattern<GenericOp> {
 public:
   using OpRewritePattern<GenericOp>::OpRewritePattern;
@@ -559,128 +724,559 @@ public:
   }
 };
 
-inline uint64_t getElementSizeBytes(Type ty) {
-  assert(ty.isF32() && "Only support f32 for now");
-  return 4;
+inline uint64_t getTensorMemrefSizeBytes(RankedTensorType ty) {
+  assert(ty.getEncoding());
+  auto layout = ty.getEncoding().template cast<LayoutAttr>();
+  return getMemrefSizeBytes(layout.getMemref());
 }
 
-inline uint64_t getMemrefSizeBytes(MemRefType ty) {
-  auto shape = ty.getShape();
-  uint64_t size = getElementSizeBytes(ty.getElementType());
-  return std::accumulate(shape.begin(), shape.end(), size,
-                         std::multiplies<uint64_t>());
-  return size;
+// Follows a value through the chain of DPS ops it is the init operand of and
+// returns the first and the last operation of its live range within the
+// block.
+//
+inline std::pair<Operation *, Operation *>
+getStartEndOperationThroughDPSOps(const LivenessBlockInfo *livenessInfo,
+                                  Value value) {
+  auto *startOp = livenessInfo->getStartOperation(value);
+  auto *endOp = livenessInfo->getEndOperation(value, startOp);
+  auto *opOperandIter =
+      llvm::find_if(endOp->getOpOperands(), [&](OpOperand &opOperand) {
+        return opOperand.is(value);
+      });
+  assert(opOperandIter != endOp->getOpOperands().end());
+  while (
+      isa<DestinationStyleOpInterface>(endOp) and
+      cast<DestinationStyleOpInterface>(endOp).isDpsInit(&(*opOperandIter))) {
+    assert(endOp->getResults().size() == 1);
+    auto result = endOp->getResult(0);
+    endOp = livenessInfo->getEndOperation(result, endOp);
+    opOperandIter =
+        llvm::find_if(endOp->getOpOperands(), [&](OpOperand &opOperand) {
+          return opOperand.is(result);
+        });
+    assert(opOperandIter != endOp->getOpOperands().end());
+  }
+  return std::make_pair(startOp, endOp);
 }
 
-inline uint64_t getLayoutMemrefSizeBytes(LayoutAttr layout) {
-  return getMemrefSizeBytes(layout.getMemref());
+inline uint64_t getMemorySpaceAlignment(ChipDescAttr chipDesc,
+                                        MemorySpace memorySpace) {
+  switch (memorySpace) {
+  case MemorySpace::DeviceL1:
+    return chipDesc.getNocL1AddressAlignBytes();
+  case MemorySpace::DeviceDRAM:
+    return chipDesc.getNocDRAMAddressAlignBytes();
+  case MemorySpace::System:
+  case MemorySpace::SystemMMIO:
+    return 1;
+  }
+  llvm_unreachable("Unknown MemorySpace");
 }
 
-inline uint64_t getTensorMemrefSizeBytes(RankedTensorType ty) {
-  assert(ty.getEncoding());
-  auto layout = ty.getEncoding().template cast<LayoutAttr>();
-  return getLayoutMemrefSizeBytes(layout);
+inline uint64_t getMemorySpaceCapacity(ChipDescAttr chipDesc,
+                                       MemorySpace memorySpace) {
+  switch (memorySpace) {
+  case MemorySpace::DeviceL1:
+    return chipDesc.getL1Size();
+  case MemorySpace::DeviceDRAM:
+    return static_cast<uint64_t>(chipDesc.getNumDramChannels()) *
+           chipDesc.getDramChannelSize();
+  case MemorySpace::System:
+  case MemorySpace::SystemMMIO:
+    return std::numeric_limits<uint64_t>::max();
+  }
+  llvm_unreachable("Unknown MemorySpace");
 }
 
-class TTIRAllocate : public impl::TTIRAllocateBase<TTIRAllocate> {
-  struct SimpleAllocator {
-    static constexpr uint64_t kBaseAddress = 1llu << 18llu;
+// Static memory planner for a single memory space. Each buffer carries its
+// live range as a closed interval of operation indices within the function
+// block, two buffers may share addresses only if their live ranges are
+// disjoint. Buffers are placed largest first into the tightest gap left
+// between the already placed buffers they conflict with, so that space freed
+// by dead buffers is coalesced and reused.
+//
+struct MemoryPlanner {
+  static constexpr uint64_t kBaseAddress = 1llu << 18llu;
+
+  struct Buffer {
+    uint64_t size;
+    int64_t start;
+    int64_t end;
+    uint64_t address = 0;
+  };
 
-    SmallVector<uint64_t> currPtr = SmallVector<uint64_t>(
-        getMaxEnumValForMemorySpace() + 1llu, kBaseAddress);
+  static uint64_t alignUp(uint64_t ptr, uint64_t alignment) {
+    return (ptr + alignment - 1) & ~(alignment - 1);
+  }
 
-    uint64_t alignUp(uint64_t ptr, uint64_t alignment) {
-      return (ptr + alignment - 1) & ~(alignment - 1);
-    }
+  static bool overlaps(Buffer const &a, Buffer const &b) {
+    return a.start <= b.end and b.start <= a.end;
+  }
 
-    uint64_t allocate(uint64_t size, MemorySpace memorySpace) {
-      if (isSystemMemorySpace(memorySpace)) {
-        return 0;
+  // Assigns an address to every buffer and returns the end of the highest
+  // placed buffer.
+  //
+  static uint64_t plan(MutableArrayRef<Buffer> buffers, uint64_t alignment) {
+    auto order = llvm::to_vector(llvm::seq<unsigned>(0, buffers.size()));
+    llvm::stable_sort(order, [&](unsigned a, unsigned b) {
+      return buffers[a].size > buffers[b].size;
+    });
+
+    uint64_t top = kBaseAddress;
+    SmallVector<unsigned> placed;
+    SmallVector<std::pair<uint64_t, uint64_t>> conflicts;
+    for (unsigned i : order) {
+      Buffer &buffer = buffers[i];
+      conflicts.clear();
+      for (unsigned j : placed) {
+        if (overlaps(buffer, buffers[j])) {
+          conflicts.emplace_back(buffers[j].address,
+                                 buffers[j].address + buffers[j].size);
+        }
+      }
+      llvm::sort(conflicts);
+
+      uint64_t cursor = kBaseAddress;
+      std::optional<uint64_t> bestAddress;
+      uint64_t bestGap = std::numeric_limits<uint64_t>::max();
+      for (auto [begin, end] : conflicts) {
+        uint64_t candidate = alignUp(cursor, alignment);
+        if (candidate + buffer.size <= begin and begin - cursor < bestGap) {
+          bestGap = begin - cursor;
+          bestAddress = candidate;
+        }
+        cursor = std::max(cursor, end);
       }
 
-      uint32_t index = static_cast<uint32_t>(memorySpace);
-      assert(index < currPtr.size());
-      uint64_t &ptr = currPtr[index];
-      ptr = alignUp(ptr, 16);
-      auto result = ptr;
-      ptr += size;
-      return result;
+      buffer.address = bestAddress.value_or(alignUp(cursor, alignment));
+      top = std::max(top, buffer.address + buffer.size);
+      placed.push_back(i);
+    }
+    return top;
+  }
+
+  // Returns the operation index at which the sum of live buffer sizes peaks
+  // together with that sum. This is a lower bound for any plan.
+  //
+  static std::pair<int64_t, uint64_t> peakLiveBytes(ArrayRef<Buffer> buffers) {
+    SmallVector<std::pair<int64_t, int64_t>> events;
+    for (auto const &buffer : buffers) {
+      events.emplace_back(buffer.start, static_cast<int64_t>(buffer.size));
+      events.emplace_back(buffer.end + 1, -static_cast<int64_t>(buffer.size));
+    }
+    // Ties sort frees before allocations.
+    llvm::sort(events);
+
+    int64_t live = 0;
+    int64_t peak = 0;
+    int64_t peakIndex = 0;
+    for (auto [index, delta] : events) {
+      live += delta;
+      if (live > peak) {
+        peak = live;
+        peakIndex = index;
+      }
     }
+    return std::make_pair(peakIndex, static_cast<uint64_t>(peak));
+  }
+};
+
+class TTIRAllocate : public impl::TTIRAllocateBase<TTIRAllocate> {
+  struct Request {
+    tensor::EmptyOp empty;
+    Operation *startOp;
+    Operation *endOp;
+    MemorySpace memorySpace;
+    unsigned buffer;
   };
 
 public:
   using impl::TTIRAllocateBase<TTIRAllocate>::TTIRAllocateBase;
 
-  std::pair<Operation *, Operation *>
-  getStartEndOperationThroughDPSOps(const LivenessBlockInfo *livenessInfo,
-                                    Value value) {
-    auto *startOp = livenessInfo->getStartOperation(value);
-    auto *endOp = livenessInfo->getEndOperation(value, startOp);
-    auto *opOperandIter =
-        llvm::find_if(endOp->getOpOperands(), [&](OpOperand &opOperand) {
-          return opOperand.is(value);
-        });
-    assert(opOperandIter != endOp->getOpOperands().end());
-    while (
-        isa<DestinationStyleOpInterface>(endOp) and
-        cast<DestinationStyleOpInterface>(endOp).isDpsInit(&(*opOperandIter))) {
-      assert(endOp->getResults().size() == 1);
-      auto result = endOp->getResult(0);
-      endOp = livenessInfo->getEndOperation(result, endOp);
-      opOperandIter =
-          llvm::find_if(endOp->getOpOperands(), [&](OpOperand &opOperand) {
-            return opOperand.is(result);
-          });
-      assert(opOperandIter != endOp->getOpOperands().end());
-    }
-    return std::make_pair(startOp, endOp);
-  }
-
   void runOnOperation() final {
     ModuleOp module = getOperation();
     IRRewriter rewriter(&getContext());
 
-    module->walk([&](func::FuncOp func) {
+    assert(module->hasAttr(tt::SystemDescAttr::name));
+    ChipDescAttr chipDesc = module->getAttr(tt::SystemDescAttr::name)
+                                .cast<tt::SystemDescAttr>()
+                                .getChipDescs()[0];
+
+    module->walk([&](func::FuncOp func) -> WalkResult {
       assert(func.getBody().hasOneBlock());
-      SimpleAllocator allocator;
+      Block &block = func.getBody().front();
       Liveness liveness(func.getOperation());
-      const LivenessBlockInfo *livenessInfo =
-          liveness.getLiveness(&func.getBody().front());
-      func->walk([&](tensor::EmptyOp empty) {
+      const LivenessBlockInfo *livenessInfo = liveness.getLiveness(&block);
+
+      llvm::DenseMap<Operation *, int64_t> opIndex;
+      int64_t index = 0;
+      for (auto &op : block) {
+        opIndex[&op] = index++;
+      }
+
+      // Gather live ranges for all buffers before touching the IR.
+      //
+      SmallVector<Request> requests;
+      SmallVector<SmallVector<MemoryPlanner::Buffer>> buffers(
+          getMaxEnumValForMemorySpace() + 1llu);
+      for (auto empty : block.getOps<tensor::EmptyOp>()) {
         auto resultTy =
             empty.getResult().getType().template cast<RankedTensorType>();
         assert(resultTy.getEncoding());
 
         auto [startOp, endOp] =
             getStartEndOperationThroughDPSOps(livenessInfo, empty.getResult());
+        auto memorySpace = getMemorySpace(resultTy);
+        auto &spaceBuffers = buffers[static_cast<uint32_t>(memorySpace)];
+        requests.push_back(
+            {empty, startOp, endOp, memorySpace,
+             static_cast<unsigned>(spaceBuffers.size())});
+        spaceBuffers.push_back({getTensorMemrefSizeBytes(resultTy),
+                                opIndex.at(startOp), opIndex.at(endOp)});
+      }
+
+      // Plan every device memory space and check it against the chip.
+      //
+      bool overflow = false;
+      for (uint32_t i = 0; i < buffers.size(); ++i) {
+        auto memorySpace = static_cast<MemorySpace>(i);
+        if (isSystemMemorySpace(memorySpace) or buffers[i].empty()) {
+          continue;
+        }
+
+        uint64_t top = MemoryPlanner::plan(
+            buffers[i], getMemorySpaceAlignment(chipDesc, memorySpace));
+        uint64_t capacity = getMemorySpaceCapacity(chipDesc, memorySpace);
+        if (reportPeakUsage) {
+          func.emitRemark() << "peak " << stringifyMemorySpace(memorySpace)
+                            << " usage: "
+                            << MemoryPlanner::peakLiveBytes(buffers[i]).second
+                            << " bytes live, "
+                            << top - MemoryPlanner::kBaseAddress
+                            << " bytes planned, " << capacity
+                            << " bytes available";
+        }
+        if (top > capacity) {
+          func.emitError() << "planned " << stringifyMemorySpace(memorySpace)
+                           << " usage of " << top
+                           << " bytes exceeds the capacity of " << capacity
+                           << " bytes";
+          overflow = true;
+        }
+      }
+      if (overflow) {
+        signalPassFailure();
+        return WalkResult::interrupt();
+      }
+
+      for (auto &request : requests) {
+        auto resultTy = request.empty.getResult()
+                            .getType()
+                            .template cast<RankedTensorType>();
+        auto const &buffer =
+            buffers[static_cast<uint32_t>(request.memorySpace)]
+                   [request.buffer];
 
         // Replace empty with allocate
-        auto memorySpace = getMemorySpace(resultTy);
-        auto sizeBytes = getTensorMemrefSizeBytes(resultTy);
-        auto address = allocator.allocate(sizeBytes, memorySpace);
-        rewriter.setInsertionPoint(startOp);
-        auto alloc = rewriter.create<AllocOp>(startOp->getLoc(), resultTy,
-                                              address, sizeBytes, memorySpace);
-        rewriter.replaceOp(empty, alloc);
+        auto address =
+            isSystemMemorySpace(request.memorySpace) ? 0 : buffer.address;
+        rewriter.setInsertionPoint(request.startOp);
+        auto alloc = rewriter.create<AllocOp>(request.startOp->getLoc(),
+                                              resultTy, address, buffer.size,
+                                              request.memorySpace);
+        rewriter.replaceOp(request.empty, alloc);
 
         // Insert deallocate unless this value is being returned
-        if (isa<func::ReturnOp>(endOp)) {
-          return;
+        if (isa<func::ReturnOp>(request.endOp)) {
+          continue;
         }
-        rewriter.setInsertionPointAfter(endOp);
-        rewriter.create<DeallocOp>(endOp->getLoc(), alloc.getResult());
+        rewriter.setInsertionPointAfter(request.endOp);
+        rewriter.create<DeallocOp>(request.endOp->getLoc(), alloc.getResult());
+      }
+      return WalkResult::advance();
+    });
+  }
+};
+
+class TTIRSpillToDRAM : public impl::TTIRSpillToDRAMBase<TTIRSpillToDRAM> {
+  struct Candidate {
+    Value value;
+    tensor::EmptyOp empty;
+    Operation *producer;
+    SmallVector<OpOperand *> consumers;
+    uint64_t size;
+    // Extra bytes moved over the NOC if this value lives in DRAM.
+    uint64_t cost;
+    // The producer is a to_layout that can write straight to DRAM instead of
+    // going through L1 first.
+    bool retarget;
+  };
+
+public:
+  using impl::TTIRSpillToDRAMBase<TTIRSpillToDRAM>::TTIRSpillToDRAMBase;
+
+  // Returns the spill candidate for the value written into empty, if it is
+  // live across peakIndex but neither produced nor consumed there.
+  //
+  std::optional<Candidate>
+  getCandidate(tensor::EmptyOp empty, MemoryPlanner::Buffer const &buffer,
+               int64_t peakIndex,
+               llvm::DenseMap<Operation *, int64_t> const &opIndex) {
+    if (buffer.start >= peakIndex or buffer.end <= peakIndex) {
+      return std::nullopt;
+    }
+
+    // Follow the chain of DPS ops writing into this buffer.
+    //
+    Value value = empty.getResult();
+    Operation *producer = nullptr;
+    bool advanced = true;
+    while (advanced) {
+      advanced = false;
+      for (auto &use : value.getUses()) {
+        auto dps = dyn_cast<DestinationStyleOpInterface>(use.getOwner());
+        if (dps and dps.isDpsInit(&use)) {
+          producer = use.getOwner();
+          value = producer->getResult(0);
+          advanced = true;
+          break;
+        }
+      }
+    }
+    if (not producer or not opIndex.count(producer) or
+        opIndex.at(producer) >= peakIndex) {
+      return std::nullopt;
+    }
+
+    Candidate candidate = {value, empty, producer, {}, buffer.size, 0, false};
+    uint64_t fills = 0;
+    for (auto &use : value.getUses()) {
+      Operation *user = use.getOwner();
+      if (isa<func::ReturnOp>(user) or not opIndex.count(user) or
+          opIndex.at(user) <= peakIndex) {
+        return std::nullopt;
+      }
+      candidate.consumers.push_back(&use);
+      fills += isa<ToLayoutOp>(user) ? 0 : 1;
+    }
+    if (candidate.consumers.empty()) {
+      return std::nullopt;
+    }
+
+    auto toLayout = dyn_cast<ToLayoutOp>(producer);
+    candidate.retarget = toLayout and toLayout.getOutput().getDefiningOp() ==
+                                          empty.getOperation();
+    candidate.cost = buffer.size * (fills + (candidate.retarget ? 0 : 1));
+    return candidate;
+  }
+
+  // Moves candidate.value to DRAM. Consumers other than to_layout ops read it
+  // back into a fresh L1 buffer right before they execute.
+  //
+  void spill(IRRewriter &rewriter, Candidate const &candidate) {
+    auto l1Ty = candidate.value.getType().template cast<RankedTensorType>();
+    auto l1Layout = l1Ty.getEncoding().template cast<LayoutAttr>();
+    auto dramTy = RankedTensorType::get(
+        l1Ty.getShape(), l1Ty.getElementType(),
+        l1Layout.withMemorySpace(&getContext(), MemorySpace::DeviceDRAM));
+
+    Value spilled;
+    if (candidate.retarget) {
+      rewriter.modifyOpInPlace(candidate.empty, [&]() {
+        candidate.empty.getResult().setType(dramTy);
       });
+      rewriter.modifyOpInPlace(candidate.producer, [&]() {
+        candidate.producer->getResult(0).setType(dramTy);
+      });
+      spilled = candidate.value;
+    } else {
+      rewriter.setInsertionPointAfter(candidate.producer);
+      auto dramEmpty = rewriter.create<tensor::EmptyOp>(
+          candidate.producer->getLoc(), l1Ty.getShape(), l1Ty.getElementType(),
+          dramTy.getEncoding());
+      spilled = rewriter.create<ToLayoutOp>(candidate.producer->getLoc(),
+                                            dramTy, candidate.value, dramEmpty)
+                    ->getResult(0);
+    }
+
+    for (OpOperand *use : candidate.consumers) {
+      Operation *user = use->getOwner();
+      Value operand = spilled;
+      if (not isa<ToLayoutOp>(user)) {
+        rewriter.setInsertionPoint(user);
+        auto l1Empty = rewriter.create<tensor::EmptyOp>(
+            user->getLoc(), l1Ty.getShape(), l1Ty.getElementType(), l1Layout);
+        operand = rewriter
+                      .create<ToLayoutOp>(user->getLoc(), l1Ty, spilled,
+                                          l1Empty)
+                      ->getResult(0);
+      }
+      rewriter.modifyOpInPlace(user, [&]() { use->set(operand); });
+    }
+  }
+
+  void runOnOperation() final {
+    ModuleOp module = getOperation();
+    IRRewriter rewriter(&getContext());
+
+    assert(module->hasAttr(tt::SystemDescAttr::name));
+    ChipDescAttr chipDesc = module->getAttr(tt::SystemDescAttr::name)
+                                .cast<tt::SystemDescAttr>()
+                                .getChipDescs()[0];
+    uint64_t capacity = getMemorySpaceCapacity(chipDesc, MemorySpace::DeviceL1);
+    uint64_t alignment =
+        getMemorySpaceAlignment(chipDesc, MemorySpace::DeviceL1);
+
+    module->walk([&](func::FuncOp func) -> WalkResult {
+      assert(func.getBody().hasOneBlock());
+      Block &block = func.getBody().front();
+
+      // Spill one value at a time and replan, every spill shortens the live
+      // range of an L1 buffer that spans the current peak.
+      //
+      while (true) {
+        Liveness liveness(func.getOperation());
+        const LivenessBlockInfo *livenessInfo = liveness.getLiveness(&block);
+
+        llvm::DenseMap<Operation *, int64_t> opIndex;
+        int64_t index = 0;
+        for (auto &op : block) {
+          opIndex[&op] = index++;
+        }
+
+        SmallVector<tensor::EmptyOp> empties;
+        SmallVector<MemoryPlanner::Buffer> buffers;
+        for (auto empty : block.getOps<tensor::EmptyOp>()) {
+          auto resultTy =
+              empty.getResult().getType().template cast<RankedTensorType>();
+          assert(resultTy.getEncoding());
+          if (getMemorySpace(resultTy) != MemorySpace::DeviceL1) {
+            continue;
+          }
+          auto [startOp, endOp] = getStartEndOperationThroughDPSOps(
+              livenessInfo, empty.getResult());
+          empties.push_back(empty);
+          buffers.push_back({getTensorMemrefSizeBytes(resultTy),
+                             opIndex.at(startOp), opIndex.at(endOp)});
+        }
+
+        uint64_t top = MemoryPlanner::plan(buffers, alignment);
+        if (top <= capacity) {
+          break;
+        }
+
+        // Prefer the cheapest value that alone covers the overflow, otherwise
+        // the one that frees the most L1 per byte moved.
+        //
+        uint64_t overflow = top - capacity;
+        int64_t peakIndex = MemoryPlanner::peakLiveBytes(buffers).first;
+        std::optional<Candidate> best;
+        for (unsigned i = 0; i < empties.size(); ++i) {
+          auto candidate =
+              getCandidate(empties[i], buffers[i], peakIndex, opIndex);
+          if (not candidate) {
+            continue;
+          }
+          if (not best) {
+            best = candidate;
+            continue;
+          }
+          bool covers = candidate->size >= overflow;
+          bool bestCovers = best->size >= overflow;
+          if (covers != bestCovers) {
+            if (covers) {
+              best = candidate;
+            }
+          } else if (covers ? candidate->cost < best->cost
+                            : candidate->size * best->cost >
+                                  best->size * candidate->cost) {
+            best = candidate;
+          }
+        }
+
+        if (not best) {
+          func.emitError() << "planned l1 usage of " << top
+                           << " bytes exceeds the capacity of " << capacity
+                           << " bytes and no tensor can be spilled to dram";
+          signalPassFailure();
+          return WalkResult::interrupt();
+        }
+        spill(rewriter, *best);
+      }
+      return WalkResult::advance();
     });
   }
+
+  void getDependentDialects(mlir::DialectRegistry &registry) const override {
+    registry.insert<mlir::tt::ttir::TTIRDialect>();
+    registry.insert<mlir::tt::TTDialect>();
+    registry.insert<mlir::tensor::TensorDialect>();
+  }
 };
 
 class TTIRGridSet : public impl::TTIRGridSetBase<TTIRGridSet> {
 public:
   using impl::TTIRGridSetBase<TTIRGridSet>::TTIRGridSetBase;
+
+  // Moves every operand of op that is not on op's grid onto it with a
+  // to_layout. Destination operands only shape the result, so a tensor.empty
+  // used by op alone is retyped and any other init is swapped for a fresh
+  // tensor.empty on op's grid. to_layout inputs are left alone since reading
+  // any layout is what to_layout does.
+  //
+  void insertReshards(Operation *op) {
+    auto resultType = op->getResult(0).getType().dyn_cast<RankedTensorType>();
+    LayoutAttr resultLayout =
+        resultType ? resultType.getEncoding().dyn_cast_or_null<LayoutAttr>()
+                   : nullptr;
+    if (not resultLayout) {
+      return;
+    }
+    auto toLayout = dyn_cast<ToLayoutOp>(op);
+    auto dps = dyn_cast<DestinationStyleOpInterface>(op);
+    OpBuilder builder(op);
+    for (OpOperand &operand : op->getOpOperands()) {
+      if (toLayout and &operand == &toLayout.getInputMutable()) {
+        continue;
+      }
+      auto operandType = operand.get().getType().dyn_cast<RankedTensorType>();
+      LayoutAttr operandLayout =
+          operandType
+              ? operandType.getEncoding().dyn_cast_or_null<LayoutAttr>()
+              : nullptr;
+      if (not operandLayout or
+          operandLayout.getGrid() == resultLayout.getGrid()) {
+        continue;
+      }
+
+      if (dps and dps.isDpsInit(&operand)) {
+        auto empty = operand.get().getDefiningOp<tensor::EmptyOp>();
+        if (empty and empty->hasOneUse()) {
+          empty.getResult().setType(resultType);
+        } else {
+          operand.set(builder.create<tensor::EmptyOp>(
+              op->getLoc(), resultType.getShape(), resultType.getElementType(),
+              resultType.getEncoding()));
+        }
+        continue;
+      }
+
+      auto reshardType = RankedTensorType::get(
+          operandType.getShape(), operandType.getElementType(),
+          operandLayout.withGrid(&getContext(), operandType.getShape(),
+                                 resultLayout.getGrid()));
+      auto output = builder.create<tensor::EmptyOp>(
+          op->getLoc(), reshardType.getShape(), reshardType.getElementType(),
+          reshardType.getEncoding());
+      auto reshard = builder.create<ToLayoutOp>(op->getLoc(), reshardType,
+                                                operand.get(), output);
+      operand.set(reshard.getResult());
+    }
+  }
+
   void runOnOperation() final {
-    // Currently a placeholder pass for grid size optimization.
-    // Goes through all the operations and sets the grid size to max supported
-    // by target chip. Lacks:
+    // Goes through all the operations, collects the legal grids for each of
+    // them and lets the graph solver pick one grid per op. Lacks:
     // - Constraint checking, whether the grid size is supported by the current
     // OP based on inputs and op type.
     //
@@ -715,7 +1311,7 @@ public:
     OptimalTargetGridAnalysis optimalTargetGridAnalysis =
         getAnalysis<OptimalTargetGridAnalysis>();
     optimalTargetGridAnalysis.init(
-        OptimalTargetGridAnalysisInput(std::move(legalGrids)));
+        OptimalTargetGridAnalysisInput(chipDesc, std::move(legalGrids)));
 
     // Pure application of determined grid sizes to the operations.
     // No further analysis.
@@ -746,6 +1342,19 @@ public:
                             optimalTargetGridAnalysis.getResult().at(op))));
       });
 
+      // The solver priced in a reshard wherever an operand ended up on a
+      // different grid than its consumer, materialize those now.
+      //
+      SmallVector<Operation *> consumers;
+      func->walk([&](Operation *op) {
+        if (op->getNumResults() > 0) {
+          consumers.push_back(op);
+        }
+      });
+      for (Operation *op : consumers) {
+        insertReshards(op);
+      }
+
       // Update the function type to reflect the updated return operation's
       // result types.
       //
@@ -757,4 +1366,52 @@ public:
   }
 };
 
+class TTIRCostModelReport
+    : public impl::TTIRCostModelReportBase<TTIRCostModelReport> {
+public:
+  using impl::TTIRCostModelReportBase<
+      TTIRCostModelReport>::TTIRCostModelReportBase;
+
+  void runOnOperation() final {
+    ModuleOp moduleOp = getOperation();
+    auto systemDesc =
+        moduleOp->getAttrOfType<tt::SystemDescAttr>(tt::SystemDescAttr::name);
+    if (not systemDesc) {
+      moduleOp.emitError() << "expected a system descriptor";
+      signalPassFailure();
+      return;
+    }
+    ChipDescAttr chipDesc = systemDesc.getChipDescs()[0];
+
+    moduleOp->walk([&](Operation *op) {
+      if (op->getNumResults() == 0 or isa<tensor::EmptyOp>(op)) {
+        return;
+      }
+      auto tensorType = op->getResult(0).getType().dyn_cast<RankedTensorType>();
+      LayoutAttr layout =
+          tensorType ? tensorType.getEncoding().dyn_cast_or_null<LayoutAttr>()
+                     : nullptr;
+      if (not layout) {
+        return;
+      }
+
+      for (int64_t size : grids) {
+        SmallVector<int64_t> gridShape(layout.getGrid().getShape().size(),
+                                       size);
+        CostModelAnalysis costModel(op);
+        costModel.init(CostModelAnalysisInput(
+            chipDesc, layout, GridAttr::get(&getContext(), gridShape)));
+        CostModelAnalysisResult const &cost = costModel.getResult();
+        auto remark = op->emitRemark();
+        remark << op->getName() << " on ";
+        llvm::interleave(
+            gridShape, [&](int64_t dim) { remark << dim; },
+            [&]() { remark << "x"; });
+        remark << ": " << cost.cycles << " cycles, " << cost.l1Bytes
+               << " L1 bytes, " << cost.nocBytes << " NOC bytes";
+      }
+    });
+  }
+};
+
 } // namespace mlir::tt::ttir
@@ -250,6 +250,7 @@ public:
 };
 
 void createTTIRToTTMetalBackendPipeline(OpPassManager &pm) {
+  pm.addPass(mlir::tt::ttir::createTTIREltwiseFusion());
   pm.addPass(mlir::tt::ttir::createTTIRGeneric());
   pm.addPass(mlir::tt::ttir::createTTIRLayout());
   pm.addPass(mlir::tt::ttir::createTTIRGenericRegionOperandsToMemref());
@@ -83,6 +83,21 @@ namespace mlir::tt::ttnn {
     return emitOpError(
         "Output must have the same number of columns as input B");
   }
+  if (getBias()) {
+    // The bias is a single row broadcast over the rows of the product.
+    auto biasShape = getBias().getType().getShape();
+    if (biasShape.empty() || biasShape.size() > outputShape.size()) {
+      return emitOpError("Bias rank must be between 1 and the output rank");
+    }
+    if (biasShape.back() != outputShape.back()) {
+      return emitOpError(
+          "Bias must have the same number of columns as the output");
+    }
+    if (!llvm::all_of(biasShape.drop_back(),
+                      [](int64_t dim) { return dim == 1; })) {
+      return emitOpError("Bias must be a single row");
+    }
+  }
   return success();
 }
 // ANCHOR_END: adding_an_op_matmul_ttnn_verify
@@ -8,6 +8,8 @@
 #include "mlir/Dialect/EmitC/IR/EmitC.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Support/LogicalResult.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "ttmlir/Dialect/TT/IR/TT.h"
@@ -47,10 +49,15 @@ createDeviceRef(FlatbufferObjectCache &cache, Value device) {
 template <typename OpT>
 ::flatbuffers::Offset<::tt::target::ttnn::Operation>
 createOperation(FlatbufferObjectCache &cache, ::flatbuffers::Offset<OpT> op,
-                std::string const &debugString) {
+                std::string const &debugString, ArrayRef<Value> release) {
+  std::vector<::flatbuffers::Offset<::tt::target::TensorRef>> releaseRefs;
+  releaseRefs.reserve(release.size());
+  for (Value value : release) {
+    releaseRefs.push_back(cache.at<::tt::target::TensorRef>(value));
+  }
   return CreateOperationDirect(
       *cache.fbb, ::tt::target::ttnn::OpTypeTraits<OpT>::enum_value, op.Union(),
-      debugString.c_str());
+      debugString.c_str(), &releaseRefs);
 }
 
 ::flatbuffers::Offset<::tt::target::ttnn::OpenDeviceOp>
@@ -103,7 +110,22 @@ createOp(FlatbufferObjectCache &cache, MatmulOp op) {
       cache.at<::tt::target::TensorRef>(getOperandThroughDPSOps(op.getB()));
   auto output = cache.at<::tt::target::TensorRef>(
       getOperandThroughDPSOps(op.getResult()));
-  return ::tt::target::ttnn::CreateMatmulOp(*cache.fbb, in0, in1, output);
+  ::flatbuffers::Offset<::tt::target::TensorRef> bias = 0;
+  if (op.getBias()) {
+    bias = cache.at<::tt::target::TensorRef>(
+        getOperandThroughDPSOps(op.getBias()));
+  }
+  ::tt::target::ttnn::MatmulActivation activation;
+  switch (op.getActivation()) {
+  case MatmulActivation::None:
+    activation = ::tt::target::ttnn::MatmulActivation::None;
+    break;
+  case MatmulActivation::Relu:
+    activation = ::tt::target::ttnn::MatmulActivation::Relu;
+    break;
+  }
+  return ::tt::target::ttnn::CreateMatmulOp(*cache.fbb, in0, in1, output, bias,
+                                            activation);
 }
 // ANCHOR_END: adding_an_op_matmul_serialize_to_binary
 
@@ -171,52 +193,103 @@ createSoftmaxOp(FlatbufferObjectCache &cache, SoftmaxOp op) {
 
 ::flatbuffers::Offset<::tt::target::ttnn::Operation>
 emitTTNNOperation(FlatbufferObjectCache &cache, Operation *op,
-                  std::string const &debugString) {
+                  std::string const &debugString, ArrayRef<Value> release) {
   if (auto openDeviceOp = dyn_cast<OpenDeviceOp>(op); openDeviceOp) {
-    return createOperation(cache, createOp(cache, openDeviceOp), debugString);
+    return createOperation(cache, createOp(cache, openDeviceOp), debugString,
+                           release);
   }
   if (auto closeDeviceOp = dyn_cast<CloseDeviceOp>(op); closeDeviceOp) {
-    return createOperation(cache, createOp(cache, closeDeviceOp), debugString);
+    return createOperation(cache, createOp(cache, closeDeviceOp), debugString,
+                           release);
   }
   if (auto toMemoryConfigOp = dyn_cast<ToMemoryConfigOp>(op);
       toMemoryConfigOp) {
     return createOperation(cache, createOp(cache, toMemoryConfigOp),
-                           debugString);
+                           debugString, release);
   }
   if (auto fullOp = dyn_cast<FullOp>(op); fullOp) {
-    return createOperation(cache, createOp(cache, fullOp), debugString);
+    return createOperation(cache, createOp(cache, fullOp), debugString,
+                           release);
   }
   if (auto addOp = dyn_cast<AddOp>(op); addOp) {
-    return createOperation(cache, createEltwiseOp(cache, addOp), debugString);
+    return createOperation(cache, createEltwiseOp(cache, addOp), debugString,
+                           release);
   }
   if (auto multiplyOp = dyn_cast<MultiplyOp>(op); multiplyOp) {
     return createOperation(cache, createEltwiseOp(cache, multiplyOp),
-                           debugString);
+                           debugString, release);
   }
   if (auto subtractOp = dyn_cast<SubtractOp>(op); subtractOp) {
     return createOperation(cache, createEltwiseOp(cache, subtractOp),
-                           debugString);
+                           debugString, release);
   }
   if (auto geOp = dyn_cast<GreaterEqualOp>(op); geOp) {
-    return createOperation(cache, createEltwiseOp(cache, geOp), debugString);
+    return createOperation(cache, createEltwiseOp(cache, geOp), debugString,
+                           release);
   }
   if (auto reluOp = dyn_cast<ReluOp>(op); reluOp) {
-    return createOperation(cache, createEltwiseOp(cache, reluOp), debugString);
+    return createOperation(cache, createEltwiseOp(cache, reluOp), debugString,
+                           release);
   }
   if (auto matmulOp = dyn_cast<MatmulOp>(op); matmulOp) {
-    return createOperation(cache, createOp(cache, matmulOp), debugString);
+    return createOperation(cache, createOp(cache, matmulOp), debugString,
+                           release);
   }
   if (auto sumOp = dyn_cast<SumOp>(op); sumOp) {
-    return createOperation(cache, createReductionOp(cache, sumOp), debugString);
+    return createOperation(cache, createReductionOp(cache, sumOp), debugString,
+                           release);
   }
   if (auto softmaxOp = dyn_cast<SoftmaxOp>(op); softmaxOp) {
     return createOperation(cache, createSoftmaxOp(cache, softmaxOp),
-                           debugString);
+                           debugString, release);
   }
 
   llvm_unreachable("unhandled op in emitTTNNOperation");
 }
 
+// Maps every op to the tensors whose last use it is, so the runtime can free
+// intermediates as early as possible. Tensors are identified by the value at
+// the root of their DPS chain, same as in the flatbuffer. Program inputs and
+// outputs are owned by the caller and never released.
+static llvm::DenseMap<Operation *, SmallVector<Value>>
+getLastUses(func::FuncOp entry) {
+  llvm::DenseSet<Value> pinned;
+  for (Value input : entry.getBody().getArguments()) {
+    pinned.insert(input);
+  }
+
+  llvm::DenseMap<Value, Operation *> lastUse;
+  entry.getBody().walk([&](Operation *op) {
+    if (auto returnOp = dyn_cast<func::ReturnOp>(op); returnOp) {
+      for (Value output : returnOp.getOperands()) {
+        pinned.insert(getOperandThroughDPSOps(output));
+      }
+      return;
+    }
+    for (Value operand : op->getOperands()) {
+      if (isa<RankedTensorType>(operand.getType())) {
+        lastUse[getOperandThroughDPSOps(operand)] = op;
+      }
+    }
+  });
+
+  // Walk again to keep the release lists in program order.
+  llvm::DenseMap<Operation *, SmallVector<Value>> releases;
+  entry.getBody().walk([&](Operation *op) {
+    for (Value operand : op->getOperands()) {
+      if (not isa<RankedTensorType>(operand.getType())) {
+        continue;
+      }
+      Value tensor = getOperandThroughDPSOps(operand);
+      if (lastUse.lookup(tensor) == op and not pinned.contains(tensor) and
+          not llvm::is_contained(releases[op], tensor)) {
+        releases[op].push_back(tensor);
+      }
+    }
+  });
+  return releases;
+}
+
 std::shared_ptr<void> ttnnToFlatbuffer(Operation *op) {
   ModuleOp module = dyn_cast<ModuleOp>(op);
   assert(module && "Expected ModuleOp as top level operation");
@@ -232,26 +305,40 @@ std::shared_ptr<void> ttnnToFlatbuffer(Operation *op) {
       cache,
       module->getAttr(tt::SystemDescAttr::name).cast<tt::SystemDescAttr>());
 
-  func::FuncOp entry = dyn_cast<func::FuncOp>(*module.getRegion().op_begin());
-  assert(entry && "Expected an entry function");
-  Program<::tt::target::ttnn::Operation> program =
-      funcOpToProgram<::tt::target::ttnn::Operation>(cache, entry,
-                                                     emitTTNNOperation);
-
+  // The module text and generated C++ cover every program, so they are
+  // serialized once and shared.
+  //
   auto mlir = toDebugInfo(fbb, "ttnn", module);
   std::string cpp;
   llvm::raw_string_ostream os(cpp);
   auto result = mlir::tt::ttnn::emitTTNNAsCpp(module, os);
   (void)result;
-
   auto debugInfo = ::tt::target::CreateDebugInfoDirect(fbb, mlir, cpp.c_str());
-  auto programOffset = ::tt::target::ttnn::CreateProgramDirect(
-      fbb, program.name, &program.inputs, &program.outputs, &program.ops,
-      debugInfo);
 
-  std::vector<::flatbuffers::Offset<::tt::target::ttnn::Program>> programs = {
-      programOffset,
-  };
+  // Every public function becomes a program, in module order, so one binary
+  // can carry e.g. prefill and decode. They share one object cache, which
+  // keeps the system desc, layouts and other attributes serialized once.
+  //
+  std::vector<::flatbuffers::Offset<::tt::target::ttnn::Program>> programs;
+  for (auto func : module.getOps<func::FuncOp>()) {
+    if (func.isPrivate() || func.isExternal()) {
+      continue;
+    }
+    llvm::DenseMap<Operation *, SmallVector<Value>> releases =
+        getLastUses(func);
+    Program<::tt::target::ttnn::Operation> program =
+        funcOpToProgram<::tt::target::ttnn::Operation>(
+            cache, func,
+            [&releases](FlatbufferObjectCache &objectCache, Operation *op,
+                        std::string const &debugString) {
+              return emitTTNNOperation(objectCache, op, debugString,
+                                       releases.lookup(op));
+            });
+    programs.push_back(::tt::target::ttnn::CreateProgramDirect(
+        fbb, program.name, &program.inputs, &program.outputs, &program.ops,
+        debugInfo));
+  }
+  assert(!programs.empty() && "Expected at least one public function");
 
   auto binary = ::tt::target::ttnn::CreateTTNNBinaryDirect(
       fbb, &binaryVersion, ::ttmlir::getGitHash(), systemDesc, &programs);
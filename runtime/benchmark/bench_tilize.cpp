@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/tilize.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+using ::tt::runtime::detail::SimdLevel;
+using ::tt::runtime::detail::TiledShape;
+
+// Arguments: rows, cols, simd level. Rows and cols are tile aligned apart
+// from the last shape, which exercises the padding path.
+static void shapes(benchmark::internal::Benchmark *b) {
+  std::vector<std::pair<int, int>> shapes = {
+      {32, 32}, {256, 256}, {1024, 1024}, {4096, 4096}, {32, 32000},
+      {1000, 1000},
+  };
+  for (auto [rows, cols] : shapes) {
+    for (SimdLevel level :
+         {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+      b->Args({rows, cols, static_cast<int>(level)});
+    }
+  }
+  b->ArgNames({"rows", "cols", "simd"});
+}
+
+static TiledShape getShape(benchmark::State const &state) {
+  TiledShape shape;
+  shape.rows = state.range(0);
+  shape.cols = state.range(1);
+  shape.paddedRows = (shape.rows + 31) / 32 * 32;
+  shape.paddedCols = (shape.cols + 31) / 32 * 32;
+  return shape;
+}
+
+static bool selectSimdLevel(benchmark::State &state) {
+  auto level = static_cast<SimdLevel>(state.range(2));
+  if (level > ::tt::runtime::detail::getSupportedSimdLevel()) {
+    state.SkipWithError("simd level not supported by the host");
+    return false;
+  }
+  ::tt::runtime::detail::setSimdLevel(level);
+  return true;
+}
+
+// Reports throughput as bytes of row major data converted per second.
+template <typename T> static void BM_Tilize(benchmark::State &state) {
+  if (not selectSimdLevel(state)) {
+    return;
+  }
+  TiledShape shape = getShape(state);
+  std::vector<T> src(std::uint64_t(shape.rows) * shape.cols, T(1));
+  std::vector<T> dst(std::uint64_t(shape.paddedRows) * shape.paddedCols);
+  for (auto _ : state) {
+    ::tt::runtime::detail::tilize(src.data(), dst.data(), shape);
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * src.size() * sizeof(T));
+}
+
+template <typename T> static void BM_Untilize(benchmark::State &state) {
+  if (not selectSimdLevel(state)) {
+    return;
+  }
+  TiledShape shape = getShape(state);
+  std::vector<T> src(std::uint64_t(shape.paddedRows) * shape.paddedCols, T(1));
+  std::vector<T> dst(std::uint64_t(shape.rows) * shape.cols);
+  for (auto _ : state) {
+    ::tt::runtime::detail::untilize(src.data(), dst.data(), shape);
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * dst.size() * sizeof(T));
+}
+
+BENCHMARK(BM_Tilize<float>)->Apply(shapes);
+BENCHMARK(BM_Tilize<std::uint32_t>)->Apply(shapes);
+BENCHMARK(BM_Tilize<std::uint16_t>)->Apply(shapes);
+BENCHMARK(BM_Untilize<float>)->Apply(shapes);
+BENCHMARK(BM_Untilize<std::uint32_t>)->Apply(shapes);
+BENCHMARK(BM_Untilize<std::uint16_t>)->Apply(shapes);
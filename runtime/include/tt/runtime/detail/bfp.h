@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_BFP_H
+#define TT_RUNTIME_DETAIL_BFP_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tt::runtime::detail {
+
+// Block float formats, every 16 values share one 8 bit exponent and each
+// value keeps a sign bit and a mantissa, including the implicit leading one.
+//
+// A packed tile holds the 64 shared exponents of its face rows, in tiled
+// element order, followed by the sign and mantissa of its 1024 values. BFP8
+// stores one value per byte, sign in the top bit and a 7 bit mantissa. BFP4
+// stores two values per byte, the first one in the low nibble, each with the
+// sign above a 3 bit mantissa.
+//
+// Packing takes the largest exponent of the group, aligns every mantissa to
+// it and rounds to nearest even, saturating values that round past the
+// largest mantissa. Zeros and denormals pack to zero, Inf and NaN are not
+// representable.
+enum class BfpFormat {
+  Bfp8,
+  Bfp4,
+};
+
+constexpr std::uint32_t kBfpGroupSize = 16;
+
+// Packed size of one 32x32 tile.
+std::uint32_t getBfpTileSizeBytes(BfpFormat format);
+
+// Packs numTiles tiles of values, already in tiled element order, into dst.
+// bfloat16 values are passed as their raw bits.
+void packBfp(float const *src, std::byte *dst, std::uint64_t numTiles,
+             BfpFormat format);
+void packBfp(std::uint16_t const *src, std::byte *dst, std::uint64_t numTiles,
+             BfpFormat format);
+
+// Unpacks numTiles packed tiles into values in tiled element order. Every
+// packed value is exactly representable in either output type.
+void unpackBfp(std::byte const *src, float *dst, std::uint64_t numTiles,
+               BfpFormat format);
+void unpackBfp(std::byte const *src, std::uint16_t *dst,
+               std::uint64_t numTiles, BfpFormat format);
+
+} // namespace tt::runtime::detail
+
+#endif
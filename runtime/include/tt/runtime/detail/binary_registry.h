@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_BINARY_REGISTRY_H
+#define TT_RUNTIME_DETAIL_BINARY_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace tt::runtime::detail {
+
+// 64-bit XXH64 of a buffer.
+std::uint64_t hashBytes(void const *data, std::size_t size,
+                        std::uint64_t seed = 0);
+
+// Deduplicates loaded binaries by content. The first buffer interned with
+// given contents is kept together with the state attached to it, later
+// loads of the same contents get both back and drop their own copy. Buffers
+// are looked up by hash and compared byte for byte on a hit, a buffer whose
+// hash collides with a different registered one is not registered.
+// Entries are evicted least recently used first once their total size
+// exceeds the capacity, which only drops the registry's reference, handles
+// already given out stay valid. A capacity of 0 disables the registry.
+class BinaryRegistry {
+public:
+  struct Entry {
+    std::shared_ptr<void> handle;
+    std::shared_ptr<void> state;
+  };
+
+  using HashFn = std::uint64_t (*)(void const *, std::size_t, std::uint64_t);
+
+  explicit BinaryRegistry(std::size_t capacityBytes = getDefaultCapacity(),
+                          HashFn hash = hashBytes);
+
+  BinaryRegistry(BinaryRegistry const &) = delete;
+  BinaryRegistry &operator=(BinaryRegistry const &) = delete;
+
+  // Returns the registered entry with the same contents as the buffer, or
+  // registers the buffer with the state returned by create. create runs
+  // without the registry locked and may throw, e.g. when the buffer fails
+  // to verify, in which case nothing is registered.
+  Entry intern(std::shared_ptr<void> handle, std::size_t size,
+               std::function<std::shared_ptr<void>()> const &create);
+
+  void setCapacity(std::size_t capacityBytes);
+  std::size_t getCapacity();
+  std::size_t getSizeBytes();
+  std::size_t getNumEntries();
+  void clear();
+
+  // TT_RUNTIME_BINARY_CACHE_BYTES when set, 1 GiB otherwise.
+  static std::size_t getDefaultCapacity();
+
+private:
+  struct Key {
+    std::uint64_t hash;
+    std::size_t size;
+    bool operator==(Key const &other) const {
+      return hash == other.hash and size == other.size;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(Key const &key) const { return key.hash; }
+  };
+
+  struct Node {
+    Key key;
+    Entry entry;
+  };
+
+  void evict();
+  // Registered node with the same contents as the buffer, if any.
+  std::list<Node>::iterator find(Key const &key, void const *data);
+
+  HashFn hash;
+  std::mutex mutex;
+  std::size_t capacity;
+  std::size_t sizeBytes = 0;
+  // Most recently used first.
+  std::list<Node> order;
+  std::unordered_map<Key, std::list<Node>::iterator, KeyHash> index;
+};
+
+} // namespace tt::runtime::detail
+
+#endif
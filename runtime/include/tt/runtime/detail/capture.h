@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_CAPTURE_H
+#define TT_RUNTIME_DETAIL_CAPTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace tt::runtime::detail {
+
+// Capture files are a header followed by records, each starting with a
+// record header and padded so that the next one, and every tensor payload,
+// starts at a multiple of kCaptureAlignment in the file. Binaries are
+// written once, the first time a submission uses them, and referenced by
+// their content hash after that. Payloads can therefore be used in place
+// from a read-only mapping of the file.
+constexpr std::size_t kCaptureAlignment = 64;
+
+struct CaptureTensor {
+  std::vector<std::uint32_t> shape;
+  std::vector<std::uint32_t> stride;
+  std::uint32_t itemsize = 0;
+  // ::tt::target::DataType, kept as an integer so that this stays free of
+  // the flatbuffer headers.
+  std::uint32_t dataType = 0;
+  void const *data = nullptr;
+  std::uint64_t sizeBytes = 0;
+};
+
+struct CaptureSubmit {
+  // Steady clock nanoseconds at submission.
+  std::uint64_t timestampNs = 0;
+  std::uint64_t binaryHash = 0;
+  std::uint32_t programIndex = 0;
+  std::uint32_t stream = 0;
+  std::vector<CaptureTensor> inputs;
+};
+
+struct CaptureBinary {
+  std::uint64_t hash = 0;
+  void const *data = nullptr;
+  std::size_t size = 0;
+};
+
+// Bytes spanned by a tensor with the given shape and element strides.
+std::uint64_t getCaptureTensorSize(std::vector<std::uint32_t> const &shape,
+                                   std::vector<std::uint32_t> const &stride,
+                                   std::uint32_t itemsize);
+
+// Appends records to a capture file, safe to call from any thread.
+class CaptureWriter {
+public:
+  // Truncates the file, throws if it cannot be opened.
+  explicit CaptureWriter(char const *path);
+  ~CaptureWriter();
+
+  CaptureWriter(CaptureWriter const &) = delete;
+  CaptureWriter &operator=(CaptureWriter const &) = delete;
+
+  // Whether the binary with this hash was written already, the caller can
+  // skip serializing it then.
+  bool hasBinary(std::uint64_t hash);
+  void writeBinary(CaptureBinary const &binary);
+  void writeSubmit(CaptureSubmit const &submit);
+  void flush();
+
+  // Held by a submitter from taking its timestamp until its record is
+  // written, enqueueing in between. Records are then in timestamp order and
+  // those of one stream in the order they were queued, at the cost of
+  // serializing submitters while capturing.
+  std::unique_lock<std::mutex> orderSubmits() {
+    return std::unique_lock<std::mutex>(orderMutex);
+  }
+
+private:
+  void write(void const *data, std::size_t size);
+  void pad();
+
+  std::mutex orderMutex;
+  std::mutex mutex;
+  std::FILE *file = nullptr;
+  std::uint64_t offset = 0;
+  std::unordered_set<std::uint64_t> binaries;
+};
+
+// Maps a capture file read-only. Binaries and tensor data point into the
+// mapping, which lives as long as the reader or any handle from getMapping.
+// A truncated last record, e.g. from a process killed while capturing, is
+// dropped rather than treated as an error.
+class CaptureReader {
+public:
+  explicit CaptureReader(char const *path);
+
+  std::vector<CaptureBinary> const &getBinaries() const { return binaries; }
+  std::vector<CaptureSubmit> const &getSubmits() const { return submits; }
+  std::shared_ptr<void> const &getMapping() const { return mapping; }
+
+private:
+  std::shared_ptr<void> mapping;
+  std::vector<CaptureBinary> binaries;
+  std::vector<CaptureSubmit> submits;
+};
+
+} // namespace tt::runtime::detail
+
+#endif
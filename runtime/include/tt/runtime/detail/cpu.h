@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_CPU_H
+#define TT_RUNTIME_DETAIL_CPU_H
+
+#include "tt/runtime/types.h"
+#include "ttmlir/Target/TTNN/Target.h"
+
+// Reference backend interpreting TTNN binaries on the host, without any
+// Tenstorrent hardware. Every device tensor is a dense row major float32
+// buffer, conversions to and from the caller's data types happen at the
+// program boundary.
+namespace tt::runtime::cpu {
+
+// A caller owned host tensor, Tensor::data keeps the buffer alive.
+struct HostTensor {
+  void *data;
+  std::vector<std::uint32_t> shape;
+  // In elements.
+  std::vector<std::uint32_t> stride;
+  std::uint32_t itemsize;
+  ::tt::target::DataType dataType;
+};
+
+// Describes the chip the backend stands in for, a single Wormhole B0.
+std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc();
+
+Tensor createTensor(std::shared_ptr<void> data,
+                    std::vector<std::uint32_t> const &shape,
+                    std::vector<std::uint32_t> const &stride,
+                    std::uint32_t itemsize, ::tt::target::DataType dataType);
+
+Device openDevice(std::vector<int> deviceIds = {0});
+
+void closeDevice(Device device);
+
+Event submit(Device device, Binary executable, std::uint32_t programIndex,
+             std::vector<Tensor> const &inputs,
+             std::vector<Tensor> const &outputs, std::uint32_t stream);
+
+// A program decoded into a flat list of steps over dense tensor slots, see
+// the TTNN backend.
+struct ProgramExecutable;
+
+std::shared_ptr<ProgramExecutable>
+prepareProgram(::tt::target::ttnn::Program const *program);
+
+void runProgram(ProgramExecutable const &executable,
+                std::vector<HostTensor *> const &inputs,
+                std::vector<HostTensor *> const &outputs);
+
+} // namespace tt::runtime::cpu
+
+#endif
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_CPU_KERNELS_H
+#define TT_RUNTIME_DETAIL_CPU_KERNELS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace tt::runtime::detail {
+
+// Host kernels of the CPU reference backend. Tensors are dense row major
+// float32. Loops are split across the host thread pool and the inner loops
+// are compiled for the instruction set picked by getSimdLevel.
+using KernelShape = std::vector<std::uint32_t>;
+
+std::uint64_t getVolume(KernelShape const &shape);
+
+// Numpy style broadcast, shapes are aligned on their innermost dim and dims
+// of extent 1 stretch. Throws if the shapes are incompatible.
+KernelShape broadcastShapes(KernelShape const &lhs, KernelShape const &rhs);
+
+enum class BinaryKernel {
+  Add,
+  Multiply,
+  Subtract,
+  // 1.0 where lhs >= rhs, 0.0 elsewhere.
+  GreaterEqual,
+};
+
+enum class UnaryKernel {
+  Relu,
+};
+
+// out = lhs op rhs, with both operands broadcast to outShape. out may alias
+// an operand of the same shape.
+void binary(BinaryKernel kind, float const *lhs, KernelShape const &lhsShape,
+            float const *rhs, KernelShape const &rhsShape, float *out,
+            KernelShape const &outShape);
+
+// out may alias in.
+void unary(UnaryKernel kind, float const *in, float *out, std::uint64_t size);
+
+// Result shape of lhs [..., M, K] x rhs [..., K, N], [..., M, N] with the
+// outer dims broadcast. Throws if the shapes do not match up.
+KernelShape getMatmulShape(KernelShape const &lhs, KernelShape const &rhs);
+
+void matmul(float const *lhs, KernelShape const &lhsShape, float const *rhs,
+            KernelShape const &rhsShape, float *out);
+
+// Sums over dims, counted from the back when negative, or over every dim
+// when dims is empty. out holds the input shape with the reduced dims of
+// extent 1, which is also the layout without them.
+void sum(float const *in, KernelShape const &shape,
+         std::vector<std::int32_t> const &dims, float *out);
+
+// Softmax along dim, counted from the back when negative.
+void softmax(float const *in, KernelShape const &shape, std::int32_t dim,
+             float *out);
+
+// bfloat16 values are passed as their raw bits, narrowing rounds to nearest
+// even.
+void bf16ToFloat(std::uint16_t const *src, float *dst, std::uint64_t size);
+void floatToBf16(float const *src, std::uint16_t *dst, std::uint64_t size);
+
+} // namespace tt::runtime::detail
+
+#endif
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_DEVICE_MANAGER_H
+#define TT_RUNTIME_DETAIL_DEVICE_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tt::runtime::detail {
+
+// Keeps devices open across users. Every acquire takes a reference and the
+// device is closed when the last one is released. A device can also be
+// borrowed without a reference, e.g. to query it, in which case it stays
+// open idle so the next acquire does not pay for initialization again.
+class DeviceManager {
+public:
+  using OpenFn = std::function<void *(int deviceId)>;
+  using CloseFn = std::function<void(void *device)>;
+
+  DeviceManager(OpenFn open, CloseFn close);
+
+  // Closes idle devices, devices still referenced are left to their owners.
+  ~DeviceManager();
+
+  DeviceManager(DeviceManager const &) = delete;
+  DeviceManager &operator=(DeviceManager const &) = delete;
+
+  void *acquire(int deviceId);
+
+  // Drops a reference taken by acquire, closing the device with the last.
+  void release(void *device);
+
+  // Returns the device, opening it if needed, without taking a reference.
+  void *borrow(int deviceId);
+
+  void closeIdle();
+
+  std::uint32_t getRefCount(int deviceId);
+
+private:
+  struct Entry {
+    void *device = nullptr;
+    std::uint32_t refCount = 0;
+  };
+
+  Entry &getOrOpen(int deviceId);
+
+  OpenFn open;
+  CloseFn close;
+  std::mutex mutex;
+  std::unordered_map<int, Entry> devices;
+};
+
+// Process wide cache of serialized system descriptors keyed by a device
+// fingerprint, backed by a directory on disk when
+// TT_RUNTIME_SYSTEM_DESC_CACHE_DIR is set. Entries read from disk are
+// checked with verify before use and recreated when they fail.
+class SystemDescCache {
+public:
+  using Buffer = std::pair<std::shared_ptr<void>, std::size_t>;
+
+  explicit SystemDescCache(std::string directory = getDefaultDirectory());
+
+  Buffer getOrCreate(std::string const &fingerprint,
+                     std::function<Buffer()> const &create,
+                     std::function<bool(void const *, std::size_t)> const
+                         &verify);
+
+  static std::string getDefaultDirectory();
+
+private:
+  std::string directory;
+  std::mutex mutex;
+  std::unordered_map<std::string, Buffer> entries;
+};
+
+// Identifies the devices visible to this process together with the runtime
+// build. Changes whenever the devices are re-enumerated, e.g. after a reboot
+// or driver reload, which conservatively invalidates cached descriptors.
+std::string getDeviceFingerprint(std::vector<int> const &deviceIds,
+                                 std::string const &buildId);
+
+} // namespace tt::runtime::detail
+
+#endif
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_HOST_ARENA_H
+#define TT_RUNTIME_DETAIL_HOST_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace tt::runtime::detail {
+
+// Recycles host buffers by size class. Sizes are rounded up to one of four
+// classes per power of two, in multiples of 64 bytes, so that a buffer is at
+// most 25% larger than requested. Buffers are aligned to 64 bytes, or to the
+// page size from a page up. A buffer goes back to the free list of its class
+// when the last reference to it drops, and is handed out again without
+// touching the system allocator or clearing it. Free buffers are kept up to
+// the capacity, past it they are freed. Buffers may outlive the arena.
+class HostArena {
+public:
+  explicit HostArena(std::size_t capacityBytes = getDefaultCapacity());
+  ~HostArena();
+
+  HostArena(HostArena const &) = delete;
+  HostArena &operator=(HostArena const &) = delete;
+
+  // Contents are left as the previous user of the buffer left them.
+  std::shared_ptr<void> allocate(std::size_t size);
+
+  void setCapacity(std::size_t capacityBytes);
+  // Frees every free buffer.
+  void trim();
+  std::size_t getFreeBytes();
+  // Number of buffers ever taken from the system allocator.
+  std::uint64_t getNumSystemAllocations();
+
+  static std::size_t getSizeClass(std::size_t size);
+  // TT_RUNTIME_HOST_ARENA_BYTES when set, 1 GiB otherwise.
+  static std::size_t getDefaultCapacity();
+
+private:
+  struct State;
+  std::shared_ptr<State> state;
+};
+
+// Process wide arena backing runtime allocated outputs.
+HostArena &getHostArena();
+
+} // namespace tt::runtime::detail
+
+#endif
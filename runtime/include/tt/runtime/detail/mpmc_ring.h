@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_MPMC_RING_H
+#define TT_RUNTIME_DETAIL_MPMC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace tt::runtime::detail {
+
+// Bounded lock-free multi producer multi consumer queue (Vyukov). Every slot
+// carries a sequence number telling producers and consumers whose turn it
+// is, so a push or pop is a single compare and swap on the shared position
+// plus a store to the slot. Capacity must be a power of two.
+template <typename T> class MpmcRing {
+public:
+  explicit MpmcRing(std::size_t capacity)
+      : mask(capacity - 1), slots(new Slot[capacity]) {
+    if (capacity < 2 or (capacity & mask) != 0) {
+      throw std::invalid_argument("MpmcRing capacity must be a power of two");
+    }
+    for (std::size_t i = 0; i < capacity; ++i) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcRing(MpmcRing const &) = delete;
+  MpmcRing &operator=(MpmcRing const &) = delete;
+
+  // Returns false without touching value if the ring is full.
+  bool tryPush(T &value) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+      slot = &slots[pos & mask];
+      std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Returns false if the ring is empty.
+  bool tryPop(T &value) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+      slot = &slots[pos & mask];
+      std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(slot->value);
+    // Drop whatever the moved from value still holds on to.
+    slot->value = T();
+    slot->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Racy by nature, exact only while no push or pop is in flight.
+  bool empty() const {
+    return dequeuePos.load(std::memory_order_seq_cst) ==
+           enqueuePos.load(std::memory_order_seq_cst);
+  }
+
+  std::size_t capacity() const { return mask + 1; }
+
+private:
+  static constexpr std::size_t kCacheLine = 64;
+
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  std::size_t const mask;
+  std::unique_ptr<Slot[]> slots;
+  // Producers and consumers each own a cache line.
+  alignas(kCacheLine) std::atomic<std::size_t> enqueuePos = 0;
+  alignas(kCacheLine) std::atomic<std::size_t> dequeuePos = 0;
+};
+
+} // namespace tt::runtime::detail
+
+#endif
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_PERF_MODEL_H
+#define TT_RUNTIME_DETAIL_PERF_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "tt/runtime/perf.h"
+
+namespace tt::runtime::detail {
+
+// Chip parameters the cost model works from. The first group comes from the
+// system descriptor, the second are per architecture constants. Bandwidths
+// are in bytes per nanosecond, which is the same as GB/s.
+struct PerfChip {
+  std::uint32_t gridY = 8;
+  std::uint32_t gridX = 8;
+  std::uint64_t l1Size = 1 << 20;
+  std::uint32_t numDramChannels = 12;
+  std::uint32_t pcieAlign = 32;
+  std::uint32_t nocL1Align = 16;
+  std::uint32_t nocDramAlign = 32;
+
+  double clockGHz = 1.0;
+  double pcieBytesPerNs = 16.0;
+  double pcieLatencyNs = 1000.0;
+  double dramBytesPerNsPerChannel = 24.0;
+  double dramLatencyNs = 500.0;
+  // Per NOC link, Tensix cores have one link per NOC.
+  double nocBytesPerCycle = 32.0;
+  double nocHopCycles = 9.0;
+  // Fixed cost of launching a program and of loading each kernel onto its
+  // core range.
+  double dispatchLatencyNs = 5000.0;
+  double kernelLaunchNs = 500.0;
+  // Math engine throughput, one tile in flight per compute core.
+  double computeCyclesPerTile = 32.0;
+  // Host side bookkeeping for allocations.
+  double hostCommandNs = 50.0;
+};
+
+enum class PerfMemory {
+  Host,
+  DRAM,
+  L1,
+};
+
+struct PerfBuffer {
+  std::uint64_t bytes = 0;
+  PerfMemory memory = PerfMemory::DRAM;
+  // Number of tiles, the unit of work of compute kernels.
+  std::uint64_t tiles = 0;
+};
+
+enum class PerfCore {
+  Noc0,
+  Noc1,
+  Compute,
+  Ethernet,
+};
+
+struct PerfKernel {
+  PerfCore core = PerfCore::Compute;
+  std::uint32_t y = 0;
+  std::uint32_t x = 0;
+  std::uint32_t height = 1;
+  std::uint32_t width = 1;
+};
+
+// Operands follow destination passing style, the last one is the output.
+struct PerfDispatch {
+  std::vector<PerfBuffer> operands;
+  std::vector<PerfKernel> kernels;
+};
+
+// Host to device or device to host copy of a buffer over PCIe, the device
+// side written to or read from memory.
+PerfEstimate estimateHostTransfer(PerfChip const &chip,
+                                  PerfBuffer const &buffer);
+
+PerfEstimate estimateDispatch(PerfChip const &chip,
+                              PerfDispatch const &dispatch);
+
+// Allocations and deallocations, only touching host bookkeeping.
+PerfEstimate estimateHostCommand(PerfChip const &chip);
+
+// Waits for all outstanding work, one round trip to the device.
+PerfEstimate estimateFinish(PerfChip const &chip);
+
+} // namespace tt::runtime::detail
+
+#endif
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_STAGING_POOL_H
+#define TT_RUNTIME_DETAIL_STAGING_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace tt::runtime::detail {
+
+// Recycles the host buffers that host to device transfers are issued from.
+// Buffers are whole anonymous mappings, locked into memory so that neither
+// the tilizer writing them nor the transfer reading them takes a page fault.
+// Buffers of at least half a huge page are backed by reserved huge pages when
+// the host has them, by transparent huge pages otherwise. Either fallback, as
+// well as failing to lock, leaves a working, page aligned buffer. Sizes are
+// rounded like the host arena's, then up to the page or huge page, and free
+// buffers are kept up to the capacity. Buffers may outlive the pool.
+class StagingPool {
+public:
+  explicit StagingPool(std::size_t capacityBytes = getDefaultCapacity(),
+                       bool useHugePages = getDefaultUseHugePages());
+  ~StagingPool();
+
+  StagingPool(StagingPool const &) = delete;
+  StagingPool &operator=(StagingPool const &) = delete;
+
+  // Contents are left as the previous user of the buffer left them.
+  std::shared_ptr<void> allocate(std::size_t size);
+
+  void setCapacity(std::size_t capacityBytes);
+  // Unmaps every free buffer.
+  void trim();
+  std::size_t getFreeBytes();
+  // Number of buffers ever mapped, and how many of them are backed by
+  // reserved huge pages or locked.
+  std::uint64_t getNumMappings();
+  std::uint64_t getNumHugePageMappings();
+  std::uint64_t getNumPinnedMappings();
+
+  // Size of the mapping backing a buffer of the given size.
+  std::size_t getMappingSize(std::size_t size) const;
+
+  // TT_RUNTIME_STAGING_BYTES when set, 256 MiB otherwise.
+  static std::size_t getDefaultCapacity();
+  // False when TT_RUNTIME_STAGING_HUGEPAGES is 0.
+  static bool getDefaultUseHugePages();
+  // Default huge page size of the host, 2 MiB when it does not report one.
+  static std::size_t getHugePageSize();
+
+private:
+  struct State;
+  std::shared_ptr<State> state;
+  bool useHugePages;
+};
+
+// Process wide pool for tilized program inputs.
+StagingPool &getStagingPool();
+
+} // namespace tt::runtime::detail
+
+#endif
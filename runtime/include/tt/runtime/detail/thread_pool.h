@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_THREAD_POOL_H
+#define TT_RUNTIME_DETAIL_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tt::runtime::detail {
+
+// Fixed set of threads for host side data work such as layout conversions.
+// The calling thread always takes part in its own loop, so parallel loops can
+// be nested, e.g. a conversion splitting itself while several conversions run
+// side by side, without idle threads waiting on each other.
+class ThreadPool {
+public:
+  // numThreads counts the calling thread, a pool of one runs inline.
+  explicit ThreadPool(std::size_t numThreads);
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  std::size_t getNumThreads() const { return workers.size() + 1; }
+
+  // Splits [0, count) into chunks of at most grain indices and calls
+  // fn(begin, end) for each of them, returning once all have finished. The
+  // first exception thrown by fn is rethrown after the loop has drained.
+  void parallelFor(std::size_t count, std::size_t grain,
+                   std::function<void(std::size_t, std::size_t)> const &fn);
+
+private:
+  struct Loop;
+
+  void run();
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::shared_ptr<Loop>> loops;
+  bool stopping = false;
+  std::vector<std::thread> workers;
+};
+
+// Pool shared by the runtime's host side work. Sized from the
+// TT_RUNTIME_HOST_THREADS environment variable when set, otherwise from the
+// number of hardware threads.
+std::shared_ptr<ThreadPool> getHostThreadPool();
+
+// Resizes the shared pool, 0 restores the default size. Loops already running
+// finish on the pool they started on.
+void setHostThreadCount(std::size_t numThreads);
+
+} // namespace tt::runtime::detail
+
+#endif
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_TILIZE_H
+#define TT_RUNTIME_DETAIL_TILIZE_H
+
+#include <cstdint>
+
+namespace tt::runtime::detail {
+
+// Tile layout: the two innermost dims are split into 32x32 tiles stored in
+// row major tile order. Each tile holds four 16x16 faces, top left, top
+// right, bottom left, bottom right, each stored row major.
+constexpr std::uint32_t kTileHeight = 32;
+constexpr std::uint32_t kTileWidth = 32;
+constexpr std::uint32_t kFaceHeight = 16;
+constexpr std::uint32_t kFaceWidth = 16;
+
+struct TiledShape {
+  // Product of all dims outside of the two innermost ones.
+  std::uint64_t batch = 1;
+  // Logical extent of the row major tensor.
+  std::uint32_t rows = 0;
+  std::uint32_t cols = 0;
+  // Extent of the tiled tensor, multiples of the tile dims that are at least
+  // as large as the logical extent.
+  std::uint32_t paddedRows = 0;
+  std::uint32_t paddedCols = 0;
+};
+
+// Instruction sets the layout converters can use, picked at runtime from
+// what the host supports.
+enum class SimdLevel {
+  Scalar,
+  AVX2,
+  AVX512,
+};
+
+// Best level supported by the host.
+SimdLevel getSupportedSimdLevel();
+
+// Level currently used by the converters, defaults to the supported one.
+SimdLevel getSimdLevel();
+
+// Overrides the level, clamped to what the host supports. Meant for tests
+// and benchmarks comparing implementations.
+void setSimdLevel(SimdLevel level);
+
+// Tilizes the row major buffer src into dst, zero filling any padding.
+void tilize(float const *src, float *dst, TiledShape const &shape);
+void tilize(std::uint32_t const *src, std::uint32_t *dst,
+            TiledShape const &shape);
+void tilize(std::uint16_t const *src, std::uint16_t *dst,
+            TiledShape const &shape);
+
+// Untilizes src, laid out in tiles, into the row major buffer dst dropping
+// any padding. dst is written front to back exactly once.
+void untilize(float const *src, float *dst, TiledShape const &shape);
+void untilize(std::uint32_t const *src, std::uint32_t *dst,
+              TiledShape const &shape);
+void untilize(std::uint16_t const *src, std::uint16_t *dst,
+              TiledShape const &shape);
+
+} // namespace tt::runtime::detail
+
+#endif
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_TRACE_H
+#define TT_RUNTIME_DETAIL_TRACE_H
+
+#include "tt/runtime/trace.h"
+
+namespace tt::runtime::detail {
+
+// Whether a trace callback is installed, checked before taking timestamps.
+bool isOpTraceEnabled();
+
+// Hands event to the installed callback, if any.
+void emitOpTrace(OpTraceEvent const &event);
+
+std::uint64_t getTraceTimestampNs();
+
+std::uint32_t getTraceThreadId();
+
+} // namespace tt::runtime::detail
+
+#endif
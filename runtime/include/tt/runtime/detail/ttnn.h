@@ -41,9 +41,12 @@
 #include "ttnn/operations/normalization.hpp"
 #pragma clang diagnostic pop
 
+#include "tt/runtime/detail/bfp.h"
 #include "tt/runtime/types.h"
 #include "ttmlir/Target/TTNN/Target.h"
 
+#include <optional>
+
 namespace tt::runtime::ttnn {
 
 std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc();
@@ -58,15 +61,34 @@ inline Tensor createTensor(std::shared_ptr<void> data, TensorDesc const &desc) {
                       desc.dataType);
 }
 
+// Packed format of the block float data types, nullopt for the others.
+std::optional<::tt::runtime::detail::BfpFormat>
+getBfpFormat(::tt::target::DataType dataType);
+
+// Copies a host tensor read back from the device into the row major buffer of
+// output, untilizing it if tiled. Block float tiles are unpacked to the
+// element type of output, f32 or bf16.
+void untilizeInto(::ttnn::Tensor const &tiled, ::ttnn::Tensor &output,
+                  ::tt::target::DataType dataType);
+
 Device openDevice(std::vector<int> deviceIds = {0});
 
 void closeDevice(Device device);
 
 Event submit(Device device, Binary executable, std::uint32_t programIndex,
              std::vector<Tensor> const &inputs,
-             std::vector<Tensor> const &outputs);
+             std::vector<Tensor> const &outputs, std::uint32_t stream);
+
+// A program decoded into a flat list of steps with its tensors remapped to
+// dense slots, so running it needs neither flatbuffer traversal nor hashing.
+struct ProgramExecutable;
 
-void wait(Event event);
+std::shared_ptr<ProgramExecutable>
+prepareProgram(::tt::target::ttnn::Program const *program);
+
+void runProgram(::ttnn::Device &device, ProgramExecutable const &executable,
+                std::vector<::ttnn::Tensor *> const &inputs,
+                std::vector<::ttnn::Tensor *> const &outputs);
 
 void runProgram(::ttnn::Device &device,
                 ::tt::target::ttnn::Program const *program,
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_DETAIL_WORKER_H
+#define TT_RUNTIME_DETAIL_WORKER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "tt/runtime/detail/mpmc_ring.h"
+
+namespace tt::runtime::detail {
+
+// Completion state of a single job, shared between the worker running it and
+// every Event handle referring to it.
+class EventState {
+public:
+  // Marks the job as finished. A non-null error is rethrown from wait().
+  void complete(std::exception_ptr error = nullptr);
+
+  // Blocks until the job has finished, rethrowing any error it raised.
+  void wait();
+
+  // Returns true if the job has finished, never blocks.
+  bool poll();
+
+private:
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+  std::exception_ptr error;
+};
+
+// The single thread driving a device. Jobs are submitted to one of a fixed
+// number of logical streams, each a lock-free queue that any number of
+// threads may push to concurrently. Jobs of the same stream run in the order
+// they were queued, jobs of different streams are not ordered with respect
+// to each other: the worker takes one job from each non-empty stream in turn
+// so that a long backlog on one stream does not starve the others. Jobs
+// never overlap, so a device only ever sees one program at a time while the
+// submitting threads are free to prepare the next ones.
+class Worker {
+public:
+  static constexpr std::uint32_t kNumStreams = 4;
+  // Pending jobs per stream, submitters wait for space past it.
+  static constexpr std::size_t kStreamCapacity = 256;
+
+  Worker();
+  ~Worker();
+
+  Worker(Worker const &) = delete;
+  Worker &operator=(Worker const &) = delete;
+
+  // Queues job behind everything submitted to the stream so far and returns
+  // its completion state. Exceptions thrown by the job are captured in the
+  // returned state. Throws if stream is not below kNumStreams.
+  std::shared_ptr<EventState> enqueue(std::function<void()> job,
+                                      std::uint32_t stream = 0);
+
+  // Blocks until every job queued so far, on any stream, has finished.
+  void flush();
+
+private:
+  struct Job {
+    std::function<void()> fn;
+    std::shared_ptr<EventState> event;
+  };
+
+  void run();
+  bool hasWork() const;
+  void wake();
+
+  std::array<std::unique_ptr<MpmcRing<Job>>, kNumStreams> streams;
+  // Set while the worker is about to sleep or sleeping, submitters only
+  // take the mutex to wake it up.
+  std::atomic<bool> idle = false;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool stopping = false;
+  std::thread thread;
+};
+
+// Returns the worker serving the given device, creating it on first use.
+// Lookups of existing workers only take a shared lock.
+Worker &getWorker(void const *device);
+
+// Drains and joins the worker serving the given device, if any. Must be
+// called before the device is closed.
+void releaseWorker(void const *device);
+
+} // namespace tt::runtime::detail
+
+#endif
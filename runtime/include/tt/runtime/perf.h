@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_PERF_H
+#define TT_RUNTIME_PERF_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tt::runtime {
+
+struct Binary;
+
+// Estimated time of a command broken down by where it is spent, in
+// nanoseconds. Data movement and compute overlap through circular buffers,
+// so the latency of a single command is the fixed overhead plus the slowest
+// of the other components, not their sum.
+struct PerfEstimate {
+  double latencyNs = 0.0;
+  double overheadNs = 0.0;
+  double pcieNs = 0.0;
+  double dramNs = 0.0;
+  double nocNs = 0.0;
+  double computeNs = 0.0;
+};
+
+struct CommandPerf {
+  std::string type;
+  std::string debugInfo;
+  PerfEstimate estimate;
+};
+
+// Commands of a queue run back to back, the totals are the sums over its
+// commands.
+struct CommandQueuePerf {
+  std::string name;
+  PerfEstimate total;
+  std::vector<CommandPerf> commands;
+};
+
+// Predicts the latency of every command queue of a TTMetal binary without a
+// device, from the chip described by its embedded system descriptor. The
+// model is cycle approximate, it is meant for comparing compiler output
+// rather than predicting wall clock time exactly.
+std::vector<CommandQueuePerf> estimatePerf(Binary executable);
+
+} // namespace tt::runtime
+
+#endif
@@ -7,12 +7,32 @@
 
 #include <cstdint>
 #include <functional>
+#include <string_view>
 #include <vector>
 
+#include "tt/runtime/trace.h"
 #include "tt/runtime/types.h"
 
 namespace tt::runtime {
 
+// Backends executing binaries. CPU is a reference interpreter of TTNN
+// binaries on the host, for accuracy checks and runs without hardware.
+enum class DeviceRuntime {
+  Disabled,
+  TTNN,
+  CPU,
+};
+
+// Backends built into this runtime, in order of preference.
+std::vector<DeviceRuntime> getAvailableRuntimes();
+
+// Backend every function below dispatches to. Defaults to the one named by
+// the TT_RUNTIME_BACKEND environment variable, "ttnn" or "cpu", otherwise
+// to the first available one. Devices, tensors and events belong to the
+// backend that created them, so switch before creating any.
+DeviceRuntime getCurrentRuntime();
+void setCurrentRuntime(DeviceRuntime runtime);
+
 std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc();
 
 Tensor createTensor(std::shared_ptr<void> data,
@@ -29,12 +49,90 @@ Device openDevice(std::vector<int> deviceIds = {0});
 
 void closeDevice(Device device);
 
+// Thread safety: every function here may be called from any thread. Any
+// number of threads may submit to the same device at once, a device is only
+// ever driven by its own worker thread which runs one program at a time.
+// Submissions to the same stream of a device run in the order they were
+// queued, submissions to different streams are not ordered with respect to
+// each other, wait on an event to order them. Closing a device must not race
+// with submissions to it.
+
+// Number of logical streams per device.
+std::uint32_t getNumStreams();
+
+// Queues the program on a stream of the device and returns immediately.
+// Inputs and outputs must stay valid until the returned event completes and
+// must not be written by submissions in flight on other streams.
 Event submit(Device device, Binary executable, std::uint32_t programIndex,
              std::vector<Tensor> const &inputs,
-             std::vector<Tensor> const &outputs);
+             std::vector<Tensor> const &outputs, std::uint32_t stream = 0);
+
+// Same as above, selecting the program by the name of its function.
+inline Event submit(Device device, Binary executable,
+                    std::string_view programName,
+                    std::vector<Tensor> const &inputs,
+                    std::vector<Tensor> const &outputs,
+                    std::uint32_t stream = 0) {
+  return submit(device, executable, executable.getProgramIndex(programName),
+                inputs, outputs, stream);
+}
+
+struct Submission {
+  Event event;
+  std::vector<Tensor> outputs;
+};
 
+// Same as above, with the outputs allocated by the runtime and returned
+// rather than passed in. Their buffers come from a host arena and go back to
+// it once the last copy of the tensor or its data drops, so steady state
+// submissions reuse buffers instead of allocating and clearing new ones.
+// Output contents are undefined until the event completes. Block float
+// outputs are returned unpacked, as the host type their itemsize stands for.
+Submission submit(Device device, Binary executable, std::uint32_t programIndex,
+                  std::vector<Tensor> const &inputs, std::uint32_t stream = 0);
+
+// Bytes of free output buffers kept for reuse, 0 frees them as soon as they
+// are dropped. Defaults to TT_RUNTIME_HOST_ARENA_BYTES or 1 GiB.
+void setHostArenaCapacity(std::size_t bytes);
+
+// Blocks until the submission behind event has finished, rethrowing any
+// error raised while running it.
 void wait(Event event);
 
+// Returns true if the submission behind event has finished, never blocks.
+bool poll(Event event);
+
+// Opt-in recording of submissions for offline replay. While a capture is
+// running, every successful submit appends its program index, stream, input
+// layouts and input contents to the capture file, plus the binary itself the
+// first time it is used. Setting TT_RUNTIME_CAPTURE to a path starts a
+// capture before the first submission of the process. Starting a capture
+// ends the running one, if any.
+void startCapture(char const *path);
+void stopCapture();
+
+struct ReplayReport {
+  // Submission to completion latency of every replayed submission, in
+  // capture order.
+  std::vector<std::uint64_t> latenciesNs;
+  // From the first submission to the last completion.
+  std::uint64_t durationNs = 0;
+};
+
+// Re-issues the submissions of a capture file on device through submit, on
+// their original streams. With preserveTiming submissions are spaced like
+// they were captured, otherwise they are issued as fast as the device
+// accepts them. Outputs are allocated once per program and stream and
+// discarded.
+ReplayReport replayCapture(Device device, char const *path,
+                           bool preserveTiming = true);
+
+// Number of host threads used for layout conversions of program inputs and
+// outputs, 0 restores the default. The default is read from the
+// TT_RUNTIME_HOST_THREADS environment variable, falling back to the number of
+// hardware threads.
+void setHostThreadCount(std::uint32_t numThreads);
+
 } // namespace tt::runtime
 
 #endif
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TT_RUNTIME_TRACE_H
+#define TT_RUNTIME_TRACE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace tt::runtime {
+
+// Host side timing of a single operation of a running program. Timestamps
+// are steady clock nanoseconds taken around the host call, device work the
+// call only enqueues is not included.
+struct OpTraceEvent {
+  std::string programName;
+  std::uint32_t opIndex = 0;
+  std::string opType;
+  std::string debugInfo;
+  std::uint64_t startNs = 0;
+  std::uint64_t endNs = 0;
+  // Stable small id of the host thread that ran the operation.
+  std::uint32_t threadId = 0;
+};
+
+using OpTraceCallback = std::function<void(OpTraceEvent const &)>;
+
+// Installs a callback invoked after every traced operation, replacing any
+// previous one. An empty callback turns tracing off, which is the default and
+// costs nothing per operation. The callback runs on the thread executing the
+// program and must not submit work itself.
+void setOpTraceCallback(OpTraceCallback callback);
+
+// Serializes events in the Chrome trace event format, viewable in
+// chrome://tracing or Perfetto.
+std::string toChromeTrace(std::vector<OpTraceEvent> const &events);
+
+} // namespace tt::runtime
+
+#endif
@@ -5,8 +5,13 @@
 #ifndef TT_RUNTIME_TYPES_H
 #define TT_RUNTIME_TYPES_H
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string_view>
+#include <typeindex>
+#include <utility>
 #include <vector>
 
 #include "tt/runtime/utils.h"
@@ -25,6 +30,31 @@ struct ObjectImpl {
     return *static_cast<T const *>(handle.get());
   }
 };
+
+// Backend specific per program state derived from a binary, e.g. decoded
+// programs ready to execute. Built on first use and shared by every copy of
+// the owning Binary handle. Entries are keyed by their type as well, so
+// backends never see each other's state.
+class ProgramCache {
+public:
+  template <typename T>
+  std::shared_ptr<T>
+  getOrCreate(std::uint32_t programIndex,
+              std::function<std::shared_ptr<T>()> const &create) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<void> &entry =
+        programs[std::make_pair(std::type_index(typeid(T)), programIndex)];
+    if (not entry) {
+      entry = create();
+    }
+    return std::static_pointer_cast<T>(entry);
+  }
+
+private:
+  std::mutex mutex;
+  std::map<std::pair<std::type_index, std::uint32_t>, std::shared_ptr<void>>
+      programs;
+};
 } // namespace detail
 
 struct TensorDesc {
@@ -39,7 +69,9 @@ using DeviceIds = std::vector<int>;
 struct Flatbuffer : public detail::ObjectImpl {
   using detail::ObjectImpl::ObjectImpl;
 
-  static Flatbuffer loadFromPath(char const *path);
+  // Memory maps the file and verifies it. With prefetch the whole file is
+  // paged in up front rather than on first access.
+  static Flatbuffer loadFromPath(char const *path, bool prefetch = false);
 
   void store(char const *path) const;
   std::string_view getFileIdentifier() const;
@@ -61,12 +93,34 @@ struct SystemDesc : public Flatbuffer {
 };
 
 struct Binary : public Flatbuffer {
-  using Flatbuffer::Flatbuffer;
-
-  static Binary loadFromPath(char const *path);
+  Binary(std::shared_ptr<void> handle)
+      : Flatbuffer(handle),
+        programCache(std::make_shared<detail::ProgramCache>()) {}
+  Binary(std::shared_ptr<void> handle,
+         std::shared_ptr<detail::ProgramCache> programCache)
+      : Flatbuffer(handle), programCache(programCache) {}
+
+  // Loads of identical contents, from any thread, return the same handle and
+  // share its program cache, see setRegistryCapacity.
+  static Binary loadFromPath(char const *path, bool prefetch = false);
+
+  // Byte budget of the process wide registry deduplicating loaded binaries.
+  // Least recently loaded binaries are dropped from it past the budget, 0
+  // disables deduplication. Defaults to TT_RUNTIME_BINARY_CACHE_BYTES or
+  // 1 GiB.
+  static void setRegistryCapacity(std::size_t bytes);
+
+  // Programs are the public functions of the compiled module, in module
+  // order.
+  std::uint32_t getNumPrograms() const;
+  std::string_view getProgramName(std::uint32_t programIndex) const;
+  // Throws if the binary has no program with the given name.
+  std::uint32_t getProgramIndex(std::string_view name) const;
 
   std::vector<TensorDesc> getProgramInputs(std::uint32_t programIndex) const;
   std::vector<TensorDesc> getProgramOutputs(std::uint32_t programIndex) const;
+
+  std::shared_ptr<detail::ProgramCache> programCache;
 };
 
 struct Device : public detail::ObjectImpl {
@@ -83,6 +137,8 @@ struct Event : public detail::ObjectImpl {
 
 struct Tensor : public detail::ObjectImpl {
   std::shared_ptr<void> data;
+  // Host layout of data as given to createTensor.
+  TensorDesc desc = {};
   Tensor(std::shared_ptr<void> handle, std::shared_ptr<void> data)
       : detail::ObjectImpl(handle), data(data) {}
 };
@@ -2,14 +2,21 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <fcntl.h>
 #include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "flatbuffers/idl.h"
 
+#include "tt/runtime/detail/binary_registry.h"
 #include "tt/runtime/types.h"
 #include "tt/runtime/utils.h"
 #include "ttmlir/Target/Common/system_desc_bfbs_generated.h"
 #include "ttmlir/Target/Common/system_desc_generated.h"
+#include "ttmlir/Target/TTMetal/Target.h"
+#include "ttmlir/Target/TTMetal/binary_bfbs_generated.h"
 #include "ttmlir/Target/TTNN/Target.h"
 #include "ttmlir/Target/TTNN/binary_bfbs_generated.h"
 
@@ -64,18 +71,58 @@ std::string asJson(Flatbuffer binary) {
       ::tt::target::ttnn::TTNNBinaryBinarySchema::size());
 }
 
+std::uint32_t getNumPrograms(Flatbuffer binary) {
+  return getBinary(binary)->programs()->size();
+}
+
+static ::tt::target::ttnn::Program const *
+getProgram(Flatbuffer binary, std::uint32_t programIndex) {
+  auto const *programs = getBinary(binary)->programs();
+  if (programIndex >= programs->size()) {
+    throw std::runtime_error("Program index out of range");
+  }
+  return programs->Get(programIndex);
+}
+
+std::string_view getProgramName(Flatbuffer binary,
+                                std::uint32_t programIndex) {
+  return getProgram(binary, programIndex)->name()->string_view();
+}
+
+std::uint32_t getProgramIndex(Flatbuffer binary, std::string_view name) {
+  auto const *programs = getBinary(binary)->programs();
+  for (std::uint32_t i = 0; i < programs->size(); ++i) {
+    if (programs->Get(i)->name()->string_view() == name) {
+      return i;
+    }
+  }
+  throw std::runtime_error("No program named " + std::string(name));
+}
+
+// Block float tensors are packed from and unpacked to row major data on the
+// host, so their descs report f32, the widest of the formats accepted there.
+static std::uint32_t getHostItemsize(::tt::target::DataType dataType) {
+  switch (dataType) {
+  case ::tt::target::DataType::BFP_BFloat8:
+  case ::tt::target::DataType::BFP_BFloat4:
+    return sizeof(float);
+  default:
+    return utils::dataTypeElementSize(dataType);
+  }
+}
+
 std::vector<TensorDesc> getProgramInputs(Flatbuffer binary,
                                          std::uint32_t programIndex) {
   std::vector<TensorDesc> inputs;
-  auto const *program = getBinary(binary)->programs()->Get(programIndex);
+  auto const *program = getProgram(binary, programIndex);
   for (auto const *input : *program->inputs()) {
     TensorDesc desc;
     desc.shape = {input->desc()->shape()->begin(),
                   input->desc()->shape()->end()};
     desc.stride = {input->desc()->layout()->stride()->begin(),
                    input->desc()->layout()->stride()->end()};
-    desc.itemsize = utils::dataTypeElementSize(
-        input->desc()->layout()->memory_desc()->data_type());
+    desc.itemsize =
+        getHostItemsize(input->desc()->layout()->memory_desc()->data_type());
     desc.dataType = input->desc()->layout()->memory_desc()->data_type();
     inputs.push_back(desc);
   }
@@ -85,15 +132,15 @@ std::vector<TensorDesc> getProgramInputs(Flatbuffer binary,
 std::vector<TensorDesc> getProgramOutputs(Flatbuffer binary,
                                           std::uint32_t programIndex) {
   std::vector<TensorDesc> outputs;
-  auto const *program = getBinary(binary)->programs()->Get(programIndex);
+  auto const *program = getProgram(binary, programIndex);
   for (auto const *output : *program->outputs()) {
     TensorDesc desc;
     desc.shape = {output->desc()->shape()->begin(),
                   output->desc()->shape()->end()};
     desc.stride = {output->desc()->layout()->stride()->begin(),
                    output->desc()->layout()->stride()->end()};
-    desc.itemsize = utils::dataTypeElementSize(
-        output->desc()->layout()->memory_desc()->data_type());
+    desc.itemsize =
+        getHostItemsize(output->desc()->layout()->memory_desc()->data_type());
     desc.dataType = output->desc()->layout()->memory_desc()->data_type();
     outputs.push_back(desc);
   }
@@ -102,6 +149,37 @@ std::vector<TensorDesc> getProgramOutputs(Flatbuffer binary,
 
 } // namespace ttnn
 
+namespace metal {
+
+::tt::target::metal::TTMetalBinary const *getBinary(Flatbuffer binary) {
+  if (not ::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
+          binary.handle.get())) {
+    throw std::runtime_error("Unsupported binary format");
+  }
+  return ::tt::target::metal::GetSizePrefixedTTMetalBinary(
+      binary.handle.get());
+}
+
+std::string getVersion(Flatbuffer binary) {
+  auto const *version = getBinary(binary)->version();
+  return std::to_string(version->major()) + "." +
+         std::to_string(version->minor()) + "." +
+         std::to_string(version->patch());
+}
+
+std::string_view getTTMLIRGitHash(Flatbuffer binary) {
+  return getBinary(binary)->ttmlir_git_hash()->c_str();
+}
+
+std::string asJson(Flatbuffer binary) {
+  return ::tt::runtime::asJson(
+      binary.handle.get(),
+      ::tt::target::metal::TTMetalBinaryBinarySchema::data(),
+      ::tt::target::metal::TTMetalBinaryBinarySchema::size());
+}
+
+} // namespace metal
+
 namespace system_desc {
 
 ::tt::target::SystemDescRoot const *getBinary(Flatbuffer binary) {
@@ -131,17 +209,90 @@ std::string asJson(Flatbuffer binary) {
 
 } // namespace system_desc
 
-Flatbuffer Flatbuffer::loadFromPath(char const *path) {
-  // load a flatbuffer from path
+static std::shared_ptr<void> readFile(char const *path, std::size_t &size) {
   std::ifstream fbb(path, std::ios::binary | std::ios::ate);
   if (!fbb.is_open()) {
     throw std::runtime_error("Failed to open file: " + std::string(path));
   }
 
-  std::streampos size = fbb.tellg();
+  size = fbb.tellg();
   fbb.seekg(0, std::ios::beg);
   auto buffer = utils::malloc_shared(size);
   fbb.read(static_cast<char *>(buffer.get()), size);
+  return buffer;
+}
+
+// Maps the file read-only and private, so processes loading the same binary
+// share its pages through the page cache instead of each holding a copy.
+// Falls back to reading the file when it cannot be mapped.
+static std::shared_ptr<void> mapFile(char const *path, bool prefetch,
+                                     std::size_t &size) {
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + std::string(path));
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 or not S_ISREG(st.st_mode) or st.st_size == 0) {
+    ::close(fd);
+    return readFile(path, size);
+  }
+  size = st.st_size;
+  void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file referenced on its own.
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    return readFile(path, size);
+  }
+  if (prefetch) {
+    // Hints only, failures are harmless. Huge pages only apply on kernels
+    // with read-only file THP support.
+    ::madvise(addr, size, MADV_WILLNEED);
+#if defined(MADV_HUGEPAGE)
+    ::madvise(addr, size, MADV_HUGEPAGE);
+#endif
+  }
+  return std::shared_ptr<void>(addr,
+                               [size](void *ptr) { ::munmap(ptr, size); });
+}
+
+// Checks the buffer once at load time so that accessors can trust it.
+static void verify(char const *path, void const *buffer, std::size_t size) {
+  auto const *data = static_cast<uint8_t const *>(buffer);
+  if (size < sizeof(::flatbuffers::uoffset_t) or
+      ::flatbuffers::GetSizePrefixedBufferLength(data) > size) {
+    throw std::runtime_error("Truncated flatbuffer: " + std::string(path));
+  }
+  ::flatbuffers::Verifier verifier(data, size);
+  if (::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(data)) {
+    if (not ::tt::target::ttnn::VerifySizePrefixedTTNNBinaryBuffer(verifier)) {
+      throw std::runtime_error("Failed to verify binary: " +
+                               std::string(path));
+    }
+    return;
+  }
+  if (::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(data)) {
+    if (not ::tt::target::metal::VerifySizePrefixedTTMetalBinaryBuffer(
+            verifier)) {
+      throw std::runtime_error("Failed to verify binary: " +
+                               std::string(path));
+    }
+    return;
+  }
+  if (::tt::target::SizePrefixedSystemDescRootBufferHasIdentifier(data)) {
+    if (not ::tt::target::VerifySizePrefixedSystemDescRootBuffer(verifier)) {
+      throw std::runtime_error("Failed to verify system desc: " +
+                               std::string(path));
+    }
+    return;
+  }
+  throw std::runtime_error("Unsupported binary format: " + std::string(path));
+}
+
+Flatbuffer Flatbuffer::loadFromPath(char const *path, bool prefetch) {
+  // load a flatbuffer from path
+  std::size_t size = 0;
+  std::shared_ptr<void> buffer = mapFile(path, prefetch, size);
+  verify(path, buffer.get(), size);
   return Flatbuffer(buffer);
 }
 
@@ -159,6 +310,11 @@ std::string_view Flatbuffer::getFileIdentifier() const {
     return ::tt::target::ttnn::TTNNBinaryIdentifier();
   }
 
+  if (::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
+          handle.get())) {
+    return ::tt::target::metal::TTMetalBinaryIdentifier();
+  }
+
   if (::tt::target::SizePrefixedSystemDescRootBufferHasIdentifier(
           handle.get())) {
     return ::tt::target::SystemDescRootIdentifier();
@@ -173,6 +329,11 @@ std::string Flatbuffer::getVersion() const {
     return ttnn::getVersion(*this);
   }
 
+  if (::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
+          handle.get())) {
+    return metal::getVersion(*this);
+  }
+
   if (::tt::target::SizePrefixedSystemDescRootBufferHasIdentifier(
           handle.get())) {
     return system_desc::getVersion(*this);
@@ -187,6 +348,11 @@ std::string_view Flatbuffer::getTTMLIRGitHash() const {
     return ttnn::getTTMLIRGitHash(*this);
   }
 
+  if (::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
+          handle.get())) {
+    return metal::getTTMLIRGitHash(*this);
+  }
+
   if (::tt::target::SizePrefixedSystemDescRootBufferHasIdentifier(
           handle.get())) {
     return system_desc::getTTMLIRGitHash(*this);
@@ -201,6 +367,11 @@ std::string Flatbuffer::asJson() const {
     return ttnn::asJson(*this);
   }
 
+  if (::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
+          handle.get())) {
+    return metal::asJson(*this);
+  }
+
   if (::tt::target::SizePrefixedSystemDescRootBufferHasIdentifier(
           handle.get())) {
     return system_desc::asJson(*this);
@@ -213,8 +384,53 @@ SystemDesc SystemDesc::loadFromPath(char const *path) {
   return SystemDesc(Flatbuffer::loadFromPath(path).handle);
 }
 
-Binary Binary::loadFromPath(char const *path) {
-  return Binary(Flatbuffer::loadFromPath(path).handle);
+static detail::BinaryRegistry &getBinaryRegistry() {
+  static detail::BinaryRegistry registry;
+  return registry;
+}
+
+Binary Binary::loadFromPath(char const *path, bool prefetch) {
+  std::size_t size = 0;
+  std::shared_ptr<void> buffer = mapFile(path, prefetch, size);
+  // Contents matching a registered binary were verified when it was loaded.
+  detail::BinaryRegistry::Entry entry =
+      getBinaryRegistry().intern(buffer, size, [&]() {
+        verify(path, buffer.get(), size);
+        return std::make_shared<detail::ProgramCache>();
+      });
+  return Binary(entry.handle,
+                std::static_pointer_cast<detail::ProgramCache>(entry.state));
+}
+
+void Binary::setRegistryCapacity(std::size_t bytes) {
+  getBinaryRegistry().setCapacity(bytes);
+}
+
+std::uint32_t Binary::getNumPrograms() const {
+  if (::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(
+          handle.get())) {
+    return ttnn::getNumPrograms(*this);
+  }
+
+  throw std::runtime_error("Unsupported binary format");
+}
+
+std::string_view Binary::getProgramName(std::uint32_t programIndex) const {
+  if (::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(
+          handle.get())) {
+    return ttnn::getProgramName(*this, programIndex);
+  }
+
+  throw std::runtime_error("Unsupported binary format");
+}
+
+std::uint32_t Binary::getProgramIndex(std::string_view name) const {
+  if (::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(
+          handle.get())) {
+    return ttnn::getProgramIndex(*this, name);
+  }
+
+  throw std::runtime_error("Unsupported binary format");
 }
 
 std::vector<TensorDesc>
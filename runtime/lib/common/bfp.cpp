@@ -0,0 +1,369 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/bfp.h"
+#include "tt/runtime/detail/thread_pool.h"
+#include "tt/runtime/detail/tilize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define TT_RUNTIME_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace tt::runtime::detail {
+
+namespace {
+constexpr std::uint32_t kTileVolume = kTileHeight * kTileWidth;
+constexpr std::uint32_t kGroupsPerTile = kTileVolume / kBfpGroupSize;
+
+// Conversions below this many source bytes run on the calling thread.
+constexpr std::uint64_t kMinChunkBytes = 1 << 20;
+
+std::uint32_t getMantissaBits(BfpFormat format) {
+  return format == BfpFormat::Bfp8 ? 7 : 3;
+}
+
+inline std::uint32_t toBits(float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+inline std::uint32_t toBits(std::uint16_t value) {
+  return std::uint32_t(value) << 16;
+}
+
+inline void fromBits(std::uint32_t bits, float &value) {
+  std::memcpy(&value, &bits, sizeof(value));
+}
+
+inline void fromBits(std::uint32_t bits, std::uint16_t &value) {
+  value = bits >> 16;
+}
+
+// Group kernels convert kBfpGroupSize values to and from one byte per value,
+// sign above the mantissa, and return or take the shared exponent. The scalar
+// kernel spells out the format and is the reference for the vector one.
+struct ScalarBfp {
+  static std::uint32_t quantize(std::uint32_t bits, std::uint32_t sharedExp,
+                                std::uint32_t mantissaBits) {
+    std::uint32_t exp = (bits >> 23) & 0xFF;
+    if (exp == 0) {
+      return 0;
+    }
+    std::uint32_t mantissa = (bits & 0x7FFFFF) | 0x800000;
+    std::uint32_t shift =
+        std::min<std::uint32_t>(sharedExp - exp + 24 - mantissaBits, 31);
+    std::uint32_t q = mantissa >> shift;
+    std::uint32_t rem = mantissa & ((1u << shift) - 1);
+    std::uint32_t half = 1u << (shift - 1);
+    if (rem > half or (rem == half and (q & 1))) {
+      ++q;
+    }
+    q = std::min(q, (1u << mantissaBits) - 1);
+    std::uint32_t sign = q ? bits >> 31 : 0;
+    return sign << mantissaBits | q;
+  }
+
+  template <typename T>
+  static std::uint8_t packGroup(T const *src, std::uint8_t *values,
+                                std::uint32_t mantissaBits) {
+    std::uint32_t sharedExp = 0;
+    for (std::uint32_t i = 0; i < kBfpGroupSize; ++i) {
+      sharedExp = std::max(sharedExp, (toBits(src[i]) >> 23) & 0xFF);
+    }
+    for (std::uint32_t i = 0; i < kBfpGroupSize; ++i) {
+      values[i] = quantize(toBits(src[i]), sharedExp, mantissaBits);
+    }
+    return sharedExp;
+  }
+
+  template <typename T>
+  static void unpackGroup(std::uint8_t const *values, std::uint8_t sharedExp,
+                          T *dst, std::uint32_t mantissaBits) {
+    int exp = int(sharedExp) - 127 - int(mantissaBits - 1);
+    for (std::uint32_t i = 0; i < kBfpGroupSize; ++i) {
+      std::uint32_t q = values[i] & ((1u << mantissaBits) - 1);
+      std::uint32_t sign = (values[i] >> mantissaBits) & 1;
+      fromBits(toBits(std::ldexp(float(q), exp)) | sign << 31, dst[i]);
+    }
+  }
+};
+
+#if defined(__x86_64__)
+struct AVX2Bfp {
+  TT_RUNTIME_TARGET("avx2")
+  static __m256i loadBits(float const *src) {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src));
+  }
+
+  TT_RUNTIME_TARGET("avx2")
+  static __m256i loadBits(std::uint16_t const *src) {
+    __m128i raw = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src));
+    return _mm256_slli_epi32(_mm256_cvtepu16_epi32(raw), 16);
+  }
+
+  TT_RUNTIME_TARGET("avx2")
+  static __m256i getExponent(__m256i bits) {
+    return _mm256_and_si256(_mm256_srli_epi32(bits, 23),
+                            _mm256_set1_epi32(0xFF));
+  }
+
+  // Lane wise ScalarBfp::quantize, all intermediates stay below 2^31 so the
+  // signed compares are safe.
+  TT_RUNTIME_TARGET("avx2")
+  static __m256i quantize(__m256i bits, __m256i sharedExp,
+                          std::uint32_t mantissaBits) {
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i exp = getExponent(bits);
+    __m256i mantissa =
+        _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFF)),
+                        _mm256_set1_epi32(0x800000));
+    __m256i shift = _mm256_min_epu32(
+        _mm256_add_epi32(_mm256_sub_epi32(sharedExp, exp),
+                         _mm256_set1_epi32(24 - mantissaBits)),
+        _mm256_set1_epi32(31));
+    __m256i q = _mm256_srlv_epi32(mantissa, shift);
+    __m256i rem = _mm256_and_si256(
+        mantissa, _mm256_sub_epi32(_mm256_sllv_epi32(one, shift), one));
+    __m256i half = _mm256_sllv_epi32(one, _mm256_sub_epi32(shift, one));
+    __m256i odd = _mm256_cmpeq_epi32(_mm256_and_si256(q, one), one);
+    __m256i roundUp = _mm256_or_si256(
+        _mm256_cmpgt_epi32(rem, half),
+        _mm256_and_si256(_mm256_cmpeq_epi32(rem, half), odd));
+    q = _mm256_sub_epi32(q, roundUp);
+    q = _mm256_min_epu32(q, _mm256_set1_epi32((1u << mantissaBits) - 1));
+    q = _mm256_andnot_si256(_mm256_cmpeq_epi32(exp, zero), q);
+    __m256i sign = _mm256_andnot_si256(_mm256_cmpeq_epi32(q, zero),
+                                       _mm256_srli_epi32(bits, 31));
+    return _mm256_or_si256(
+        _mm256_sll_epi32(sign, _mm_cvtsi32_si128(mantissaBits)), q);
+  }
+
+  template <typename T>
+  TT_RUNTIME_TARGET("avx2")
+  static std::uint8_t packGroup(T const *src, std::uint8_t *values,
+                                std::uint32_t mantissaBits) {
+    __m256i lo = loadBits(src);
+    __m256i hi = loadBits(src + 8);
+    __m256i sharedExp = _mm256_max_epu32(getExponent(lo), getExponent(hi));
+    sharedExp = _mm256_max_epu32(
+        sharedExp, _mm256_permute2x128_si256(sharedExp, sharedExp, 1));
+    sharedExp = _mm256_max_epu32(
+        sharedExp, _mm256_shuffle_epi32(sharedExp, _MM_SHUFFLE(1, 0, 3, 2)));
+    sharedExp = _mm256_max_epu32(
+        sharedExp, _mm256_shuffle_epi32(sharedExp, _MM_SHUFFLE(2, 3, 0, 1)));
+    __m256i words = _mm256_packus_epi32(quantize(lo, sharedExp, mantissaBits),
+                                        quantize(hi, sharedExp, mantissaBits));
+    words = _mm256_permute4x64_epi64(words, _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words),
+                                     _mm256_extracti128_si256(words, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(values), bytes);
+    return _mm256_cvtsi256_si32(sharedExp);
+  }
+
+  TT_RUNTIME_TARGET("avx2")
+  static __m256i dequantize(__m128i bytes, __m256 scale,
+                            std::uint32_t mantissaBits) {
+    __m256i values = _mm256_cvtepu8_epi32(bytes);
+    __m256i q = _mm256_and_si256(
+        values, _mm256_set1_epi32((1u << mantissaBits) - 1));
+    __m128i count = _mm_cvtsi32_si128(mantissaBits);
+    __m256i sign = _mm256_slli_epi32(_mm256_srl_epi32(values, count), 31);
+    __m256 value = _mm256_mul_ps(_mm256_cvtepi32_ps(q), scale);
+    return _mm256_or_si256(_mm256_castps_si256(value), sign);
+  }
+
+  TT_RUNTIME_TARGET("avx2")
+  static void storeBits(__m256i lo, __m256i hi, float *dst) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 8), hi);
+  }
+
+  TT_RUNTIME_TARGET("avx2")
+  static void storeBits(__m256i lo, __m256i hi, std::uint16_t *dst) {
+    __m256i words = _mm256_packus_epi32(_mm256_srli_epi32(lo, 16),
+                                        _mm256_srli_epi32(hi, 16));
+    words = _mm256_permute4x64_epi64(words, _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), words);
+  }
+
+  template <typename T>
+  TT_RUNTIME_TARGET("avx2")
+  static void unpackGroup(std::uint8_t const *values, std::uint8_t sharedExp,
+                          T *dst, std::uint32_t mantissaBits) {
+    __m256 scale = _mm256_set1_ps(
+        std::ldexp(1.0f, int(sharedExp) - 127 - int(mantissaBits - 1)));
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values));
+    storeBits(dequantize(bytes, scale, mantissaBits),
+              dequantize(_mm_srli_si128(bytes, 8), scale, mantissaBits), dst);
+  }
+};
+#endif
+
+template <typename T, typename Kernel>
+inline void packTiles(T const *src, std::byte *dst, std::uint64_t begin,
+                      std::uint64_t end, BfpFormat format) {
+  std::uint32_t mantissaBits = getMantissaBits(format);
+  std::uint32_t tileSize = getBfpTileSizeBytes(format);
+  for (std::uint64_t tile = begin; tile < end; ++tile) {
+    auto *exps = reinterpret_cast<std::uint8_t *>(dst + tile * tileSize);
+    std::uint8_t *mantissas = exps + kGroupsPerTile;
+    T const *tileSrc = src + tile * kTileVolume;
+    for (std::uint32_t group = 0; group < kGroupsPerTile; ++group) {
+      T const *groupSrc = tileSrc + group * kBfpGroupSize;
+      if (format == BfpFormat::Bfp8) {
+        exps[group] = Kernel::packGroup(
+            groupSrc, mantissas + group * kBfpGroupSize, mantissaBits);
+        continue;
+      }
+      std::uint8_t values[kBfpGroupSize];
+      exps[group] = Kernel::packGroup(groupSrc, values, mantissaBits);
+      std::uint8_t *groupDst = mantissas + group * kBfpGroupSize / 2;
+      for (std::uint32_t i = 0; i < kBfpGroupSize / 2; ++i) {
+        groupDst[i] = values[2 * i] | values[2 * i + 1] << 4;
+      }
+    }
+  }
+}
+
+template <typename T, typename Kernel>
+inline void unpackTiles(std::byte const *src, T *dst, std::uint64_t begin,
+                        std::uint64_t end, BfpFormat format) {
+  std::uint32_t mantissaBits = getMantissaBits(format);
+  std::uint32_t tileSize = getBfpTileSizeBytes(format);
+  for (std::uint64_t tile = begin; tile < end; ++tile) {
+    auto const *exps =
+        reinterpret_cast<std::uint8_t const *>(src + tile * tileSize);
+    std::uint8_t const *mantissas = exps + kGroupsPerTile;
+    T *tileDst = dst + tile * kTileVolume;
+    for (std::uint32_t group = 0; group < kGroupsPerTile; ++group) {
+      T *groupDst = tileDst + group * kBfpGroupSize;
+      if (format == BfpFormat::Bfp8) {
+        Kernel::unpackGroup(mantissas + group * kBfpGroupSize, exps[group],
+                            groupDst, mantissaBits);
+        continue;
+      }
+      std::uint8_t values[kBfpGroupSize];
+      std::uint8_t const *groupSrc = mantissas + group * kBfpGroupSize / 2;
+      for (std::uint32_t i = 0; i < kBfpGroupSize / 2; ++i) {
+        values[2 * i] = groupSrc[i] & 0xF;
+        values[2 * i + 1] = groupSrc[i] >> 4;
+      }
+      Kernel::unpackGroup(values, exps[group], groupDst, mantissaBits);
+    }
+  }
+}
+
+template <typename T>
+using PackFn = void (*)(T const *, std::byte *, std::uint64_t, std::uint64_t,
+                        BfpFormat);
+template <typename T>
+using UnpackFn = void (*)(std::byte const *, T *, std::uint64_t,
+                          std::uint64_t, BfpFormat);
+
+#if defined(__x86_64__)
+// Flattened so the group kernels inline into code compiled for AVX2. AVX-512
+// hosts use these as well, the groups are only 16 values wide.
+template <typename T>
+TT_RUNTIME_TARGET("avx2")
+__attribute__((flatten)) void packTilesAVX2(T const *src, std::byte *dst,
+                                            std::uint64_t begin,
+                                            std::uint64_t end,
+                                            BfpFormat format) {
+  packTiles<T, AVX2Bfp>(src, dst, begin, end, format);
+}
+
+template <typename T>
+TT_RUNTIME_TARGET("avx2")
+__attribute__((flatten)) void unpackTilesAVX2(std::byte const *src, T *dst,
+                                              std::uint64_t begin,
+                                              std::uint64_t end,
+                                              BfpFormat format) {
+  unpackTiles<T, AVX2Bfp>(src, dst, begin, end, format);
+}
+#endif
+
+template <typename T> PackFn<T> getPackFn() {
+#if defined(__x86_64__)
+  if (getSimdLevel() >= SimdLevel::AVX2) {
+    return packTilesAVX2<T>;
+  }
+#endif
+  return packTiles<T, ScalarBfp>;
+}
+
+template <typename T> UnpackFn<T> getUnpackFn() {
+#if defined(__x86_64__)
+  if (getSimdLevel() >= SimdLevel::AVX2) {
+    return unpackTilesAVX2<T>;
+  }
+#endif
+  return unpackTiles<T, ScalarBfp>;
+}
+
+// Splits the tiles across the host thread pool when there are enough of them.
+template <typename Fn>
+void forEachTileChunk(std::uint64_t numTiles, std::size_t elementSize,
+                      Fn const &fn) {
+  std::uint64_t grain =
+      std::max<std::uint64_t>(kMinChunkBytes / (kTileVolume * elementSize), 1);
+  if (numTiles <= grain) {
+    fn(0, numTiles);
+    return;
+  }
+  getHostThreadPool()->parallelFor(numTiles, grain, fn);
+}
+
+template <typename T>
+void pack(T const *src, std::byte *dst, std::uint64_t numTiles,
+          BfpFormat format) {
+  PackFn<T> packFn = getPackFn<T>();
+  forEachTileChunk(numTiles, sizeof(T),
+                   [&](std::uint64_t begin, std::uint64_t end) {
+                     packFn(src, dst, begin, end, format);
+                   });
+}
+
+template <typename T>
+void unpack(std::byte const *src, T *dst, std::uint64_t numTiles,
+            BfpFormat format) {
+  UnpackFn<T> unpackFn = getUnpackFn<T>();
+  forEachTileChunk(numTiles, sizeof(T),
+                   [&](std::uint64_t begin, std::uint64_t end) {
+                     unpackFn(src, dst, begin, end, format);
+                   });
+}
+} // namespace
+
+std::uint32_t getBfpTileSizeBytes(BfpFormat format) {
+  return kGroupsPerTile + kTileVolume * (getMantissaBits(format) + 1) / 8;
+}
+
+void packBfp(float const *src, std::byte *dst, std::uint64_t numTiles,
+             BfpFormat format) {
+  pack(src, dst, numTiles, format);
+}
+
+void packBfp(std::uint16_t const *src, std::byte *dst, std::uint64_t numTiles,
+             BfpFormat format) {
+  pack(src, dst, numTiles, format);
+}
+
+void unpackBfp(std::byte const *src, float *dst, std::uint64_t numTiles,
+               BfpFormat format) {
+  unpack(src, dst, numTiles, format);
+}
+
+void unpackBfp(std::byte const *src, std::uint16_t *dst,
+               std::uint64_t numTiles, BfpFormat format) {
+  unpack(src, dst, numTiles, format);
+}
+
+} // namespace tt::runtime::detail
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/binary_registry.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace tt::runtime::detail {
+
+static constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+static constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+static constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+static std::uint64_t rotl(std::uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+static std::uint64_t read64(std::uint8_t const *p) {
+  std::uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static std::uint32_t read32(std::uint8_t const *p) {
+  std::uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static std::uint64_t xxhRound(std::uint64_t acc, std::uint64_t input) {
+  acc += input * kPrime2;
+  acc = rotl(acc, 31);
+  return acc * kPrime1;
+}
+
+static std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t val) {
+  acc ^= xxhRound(0, val);
+  return acc * kPrime1 + kPrime4;
+}
+
+std::uint64_t hashBytes(void const *data, std::size_t size,
+                        std::uint64_t seed) {
+  auto const *p = static_cast<std::uint8_t const *>(data);
+  std::uint8_t const *end = p + size;
+  std::uint64_t h;
+
+  if (size >= 32) {
+    std::uint64_t v1 = seed + kPrime1 + kPrime2;
+    std::uint64_t v2 = seed + kPrime2;
+    std::uint64_t v3 = seed;
+    std::uint64_t v4 = seed - kPrime1;
+    std::uint8_t const *limit = end - 32;
+    do {
+      v1 = xxhRound(v1, read64(p));
+      v2 = xxhRound(v2, read64(p + 8));
+      v3 = xxhRound(v3, read64(p + 16));
+      v4 = xxhRound(v4, read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    h = mergeRound(h, v1);
+    h = mergeRound(h, v2);
+    h = mergeRound(h, v3);
+    h = mergeRound(h, v4);
+  } else {
+    h = seed + kPrime5;
+  }
+
+  h += size;
+  for (; p + 8 <= end; p += 8) {
+    h ^= xxhRound(0, read64(p));
+    h = rotl(h, 27) * kPrime1 + kPrime4;
+  }
+  if (p + 4 <= end) {
+    h ^= std::uint64_t(read32(p)) * kPrime1;
+    h = rotl(h, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    h ^= (*p) * kPrime5;
+    h = rotl(h, 11) * kPrime1;
+  }
+
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+BinaryRegistry::BinaryRegistry(std::size_t capacityBytes, HashFn hash)
+    : hash(hash), capacity(capacityBytes) {}
+
+std::size_t BinaryRegistry::getDefaultCapacity() {
+  char const *value = std::getenv("TT_RUNTIME_BINARY_CACHE_BYTES");
+  if (value and *value) {
+    return std::stoull(value);
+  }
+  return std::size_t(1) << 30;
+}
+
+// The buffers are already mapped, so comparing them costs little next to
+// loading one, and it keeps a colliding buffer from running another
+// binary's programs unverified.
+std::list<BinaryRegistry::Node>::iterator
+BinaryRegistry::find(Key const &key, void const *data) {
+  auto match = index.find(key);
+  if (match == index.end() or
+      std::memcmp(match->second->entry.handle.get(), data, key.size) != 0) {
+    return order.end();
+  }
+  return match->second;
+}
+
+BinaryRegistry::Entry
+BinaryRegistry::intern(std::shared_ptr<void> handle, std::size_t size,
+                       std::function<std::shared_ptr<void>()> const &create) {
+  if (getCapacity() == 0) {
+    return Entry{handle, create()};
+  }
+
+  Key key{hash(handle.get(), size, 0), size};
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto match = find(key, handle.get()); match != order.end()) {
+      order.splice(order.begin(), order, match);
+      return match->entry;
+    }
+  }
+
+  Entry entry{handle, create()};
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Another thread may have registered the same contents meanwhile, the
+  // first one wins so that everyone shares its state.
+  if (auto match = find(key, handle.get()); match != order.end()) {
+    order.splice(order.begin(), order, match);
+    return match->entry;
+  }
+  if (size > capacity or index.count(key)) {
+    return entry;
+  }
+  order.push_front(Node{key, entry});
+  index.emplace(key, order.begin());
+  sizeBytes += size;
+  evict();
+  return entry;
+}
+
+void BinaryRegistry::evict() {
+  while (sizeBytes > capacity and not order.empty()) {
+    Node &last = order.back();
+    sizeBytes -= last.key.size;
+    index.erase(last.key);
+    order.pop_back();
+  }
+}
+
+void BinaryRegistry::setCapacity(std::size_t capacityBytes) {
+  std::lock_guard<std::mutex> lock(mutex);
+  capacity = capacityBytes;
+  evict();
+}
+
+std::size_t BinaryRegistry::getCapacity() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return capacity;
+}
+
+std::size_t BinaryRegistry::getSizeBytes() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return sizeBytes;
+}
+
+std::size_t BinaryRegistry::getNumEntries() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return order.size();
+}
+
+void BinaryRegistry::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  order.clear();
+  index.clear();
+  sizeBytes = 0;
+}
+
+} // namespace tt::runtime::detail
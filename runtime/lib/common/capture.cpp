@@ -0,0 +1,304 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/capture.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tt::runtime::detail {
+
+namespace {
+constexpr char kMagic[8] = {'T', 'T', 'R', 'T', 'C', 'A', 'P', '\0'};
+constexpr std::uint32_t kVersion = 1;
+
+enum class RecordKind : std::uint32_t {
+  Binary = 1,
+  Submit = 2,
+};
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t reserved;
+};
+
+// sizeBytes covers the whole record, header and padding included.
+struct RecordHeader {
+  RecordKind kind;
+  std::uint32_t reserved;
+  std::uint64_t sizeBytes;
+};
+
+struct BinaryRecord {
+  std::uint64_t hash;
+  std::uint64_t size;
+};
+
+struct SubmitRecord {
+  std::uint64_t timestampNs;
+  std::uint64_t binaryHash;
+  std::uint32_t programIndex;
+  std::uint32_t stream;
+  std::uint32_t numInputs;
+  std::uint32_t reserved;
+};
+
+// Followed by rank shape and rank stride entries. dataOffset is relative to
+// the start of the record.
+struct TensorRecord {
+  std::uint32_t dataType;
+  std::uint32_t itemsize;
+  std::uint32_t rank;
+  std::uint32_t reserved;
+  std::uint64_t sizeBytes;
+  std::uint64_t dataOffset;
+};
+
+std::uint64_t alignUp(std::uint64_t value) {
+  return (value + kCaptureAlignment - 1) / kCaptureAlignment *
+         kCaptureAlignment;
+}
+
+std::uint64_t getBinaryPayloadOffset() {
+  return alignUp(sizeof(RecordHeader) + sizeof(BinaryRecord));
+}
+
+std::uint64_t getTensorRecordSize(CaptureTensor const &tensor) {
+  return sizeof(TensorRecord) +
+         2 * tensor.shape.size() * sizeof(std::uint32_t);
+}
+
+template <typename T>
+T const *view(std::uint8_t const *base, std::uint64_t offset,
+              std::uint64_t end) {
+  if (offset + sizeof(T) > end) {
+    return nullptr;
+  }
+  return reinterpret_cast<T const *>(base + offset);
+}
+
+[[noreturn]] void corrupt(char const *path) {
+  throw std::runtime_error("Corrupt capture file: " + std::string(path));
+}
+} // namespace
+
+std::uint64_t getCaptureTensorSize(std::vector<std::uint32_t> const &shape,
+                                   std::vector<std::uint32_t> const &stride,
+                                   std::uint32_t itemsize) {
+  std::uint64_t lastElement = 0;
+  for (std::size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] == 0) {
+      return 0;
+    }
+    lastElement += std::uint64_t(shape[i] - 1) * stride[i];
+  }
+  return (lastElement + 1) * itemsize;
+}
+
+CaptureWriter::CaptureWriter(char const *path) {
+  file = std::fopen(path, "wb");
+  if (not file) {
+    throw std::runtime_error("Failed to open capture file: " +
+                             std::string(path));
+  }
+  FileHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  write(&header, sizeof(header));
+  pad();
+}
+
+CaptureWriter::~CaptureWriter() { std::fclose(file); }
+
+bool CaptureWriter::hasBinary(std::uint64_t hash) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return binaries.count(hash);
+}
+
+void CaptureWriter::writeBinary(CaptureBinary const &binary) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (not binaries.insert(binary.hash).second) {
+    return;
+  }
+  RecordHeader header = {};
+  header.kind = RecordKind::Binary;
+  header.sizeBytes = alignUp(getBinaryPayloadOffset() + binary.size);
+  BinaryRecord record = {binary.hash, binary.size};
+  write(&header, sizeof(header));
+  write(&record, sizeof(record));
+  pad();
+  write(binary.data, binary.size);
+  pad();
+}
+
+void CaptureWriter::writeSubmit(CaptureSubmit const &submit) {
+  std::uint64_t descBytes = sizeof(RecordHeader) + sizeof(SubmitRecord);
+  for (CaptureTensor const &input : submit.inputs) {
+    descBytes += getTensorRecordSize(input);
+  }
+  std::uint64_t sizeBytes = alignUp(descBytes);
+  std::vector<TensorRecord> records;
+  for (CaptureTensor const &input : submit.inputs) {
+    TensorRecord record = {};
+    record.dataType = input.dataType;
+    record.itemsize = input.itemsize;
+    record.rank = input.shape.size();
+    record.sizeBytes = input.sizeBytes;
+    record.dataOffset = sizeBytes;
+    records.push_back(record);
+    sizeBytes += alignUp(input.sizeBytes);
+  }
+
+  RecordHeader header = {};
+  header.kind = RecordKind::Submit;
+  header.sizeBytes = sizeBytes;
+  SubmitRecord record = {};
+  record.timestampNs = submit.timestampNs;
+  record.binaryHash = submit.binaryHash;
+  record.programIndex = submit.programIndex;
+  record.stream = submit.stream;
+  record.numInputs = submit.inputs.size();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  write(&header, sizeof(header));
+  write(&record, sizeof(record));
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    CaptureTensor const &input = submit.inputs[i];
+    write(&records[i], sizeof(TensorRecord));
+    write(input.shape.data(), input.shape.size() * sizeof(std::uint32_t));
+    write(input.stride.data(), input.stride.size() * sizeof(std::uint32_t));
+  }
+  pad();
+  for (CaptureTensor const &input : submit.inputs) {
+    write(input.data, input.sizeBytes);
+    pad();
+  }
+}
+
+void CaptureWriter::flush() {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::fflush(file);
+}
+
+void CaptureWriter::write(void const *data, std::size_t size) {
+  if (size and std::fwrite(data, 1, size, file) != size) {
+    throw std::runtime_error("Failed to write capture file");
+  }
+  offset += size;
+}
+
+void CaptureWriter::pad() {
+  static constexpr std::uint8_t kZeros[kCaptureAlignment] = {};
+  write(kZeros, alignUp(offset) - offset);
+}
+
+CaptureReader::CaptureReader(char const *path) {
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open capture file: " +
+                             std::string(path));
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 or
+      std::size_t(st.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    corrupt(path);
+  }
+  std::size_t size = st.st_size;
+  void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error("Failed to map capture file: " +
+                             std::string(path));
+  }
+  mapping = std::shared_ptr<void>(addr,
+                                  [size](void *ptr) { ::munmap(ptr, size); });
+
+  auto const *base = static_cast<std::uint8_t const *>(addr);
+  auto const *fileHeader = reinterpret_cast<FileHeader const *>(base);
+  if (std::memcmp(fileHeader->magic, kMagic, sizeof(kMagic)) != 0 or
+      fileHeader->version != kVersion) {
+    corrupt(path);
+  }
+
+  std::uint64_t offset = alignUp(sizeof(FileHeader));
+  while (offset < size) {
+    auto const *header = view<RecordHeader>(base, offset, size);
+    if (not header or offset + header->sizeBytes > size) {
+      break;
+    }
+    if (header->sizeBytes < sizeof(RecordHeader) or
+        header->sizeBytes % kCaptureAlignment) {
+      corrupt(path);
+    }
+    std::uint64_t end = offset + header->sizeBytes;
+    std::uint64_t cursor = offset + sizeof(RecordHeader);
+    switch (header->kind) {
+    case RecordKind::Binary: {
+      auto const *record = view<BinaryRecord>(base, cursor, end);
+      if (not record or
+          offset + getBinaryPayloadOffset() + record->size > end) {
+        corrupt(path);
+      }
+      CaptureBinary binary;
+      binary.hash = record->hash;
+      binary.data = base + offset + getBinaryPayloadOffset();
+      binary.size = record->size;
+      binaries.push_back(binary);
+      break;
+    }
+    case RecordKind::Submit: {
+      auto const *record = view<SubmitRecord>(base, cursor, end);
+      if (not record) {
+        corrupt(path);
+      }
+      cursor += sizeof(SubmitRecord);
+      CaptureSubmit submit;
+      submit.timestampNs = record->timestampNs;
+      submit.binaryHash = record->binaryHash;
+      submit.programIndex = record->programIndex;
+      submit.stream = record->stream;
+      for (std::uint32_t i = 0; i < record->numInputs; ++i) {
+        auto const *tensorRecord = view<TensorRecord>(base, cursor, end);
+        if (not tensorRecord) {
+          corrupt(path);
+        }
+        cursor += sizeof(TensorRecord);
+        std::uint64_t dimsBytes = tensorRecord->rank * sizeof(std::uint32_t);
+        if (cursor + 2 * dimsBytes > end or
+            offset + tensorRecord->dataOffset + tensorRecord->sizeBytes >
+                end) {
+          corrupt(path);
+        }
+        auto const *dims =
+            reinterpret_cast<std::uint32_t const *>(base + cursor);
+        cursor += 2 * dimsBytes;
+        CaptureTensor tensor;
+        tensor.shape.assign(dims, dims + tensorRecord->rank);
+        tensor.stride.assign(dims + tensorRecord->rank,
+                             dims + 2 * tensorRecord->rank);
+        tensor.itemsize = tensorRecord->itemsize;
+        tensor.dataType = tensorRecord->dataType;
+        tensor.data = base + offset + tensorRecord->dataOffset;
+        tensor.sizeBytes = tensorRecord->sizeBytes;
+        submit.inputs.push_back(std::move(tensor));
+      }
+      submits.push_back(std::move(submit));
+      break;
+    }
+    default:
+      // Unknown records are skipped.
+      break;
+    }
+    offset = end;
+  }
+}
+
+} // namespace tt::runtime::detail
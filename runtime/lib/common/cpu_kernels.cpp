@@ -0,0 +1,499 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/cpu_kernels.h"
+#include "tt/runtime/detail/thread_pool.h"
+#include "tt/runtime/detail/tilize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__)
+#define TT_RUNTIME_TARGET(isa) __attribute__((target(isa)))
+#endif
+#define TT_RUNTIME_NO_TARGET
+
+namespace tt::runtime::detail {
+
+namespace {
+// Elements handled per parallel chunk, smaller loops stay on the calling
+// thread.
+constexpr std::uint64_t kGrain = 1 << 16;
+// Output columns of a matmul kept hot in L1 while sweeping K.
+constexpr std::uint64_t kMatmulBlockCols = 256;
+
+std::uint64_t getGrain(std::uint64_t elementsPerItem) {
+  return std::max<std::uint64_t>(
+      kGrain / std::max<std::uint64_t>(elementsPerItem, 1), 1);
+}
+
+std::uint32_t normalizeDim(std::int32_t dim, std::size_t rank) {
+  std::int64_t normalized = dim < 0 ? dim + std::int64_t(rank) : dim;
+  if (normalized < 0 or normalized >= std::int64_t(rank)) {
+    throw std::runtime_error("Dimension " + std::to_string(dim) +
+                             " out of range for rank " +
+                             std::to_string(rank));
+  }
+  return normalized;
+}
+
+// Row major strides of shape aligned to the innermost dims of a tensor of
+// the given rank, with broadcast dims given a stride of 0.
+std::vector<std::uint64_t> getBroadcastStrides(KernelShape const &shape,
+                                               KernelShape const &outShape) {
+  std::vector<std::uint64_t> strides(outShape.size(), 0);
+  std::uint64_t stride = 1;
+  for (std::size_t i = 0; i < shape.size(); ++i) {
+    std::size_t dim = shape.size() - 1 - i;
+    std::size_t outDim = outShape.size() - 1 - i;
+    strides[outDim] = shape[dim] == 1 ? 0 : stride;
+    stride *= shape[dim];
+  }
+  return strides;
+}
+
+template <BinaryKernel Kind> float apply(float lhs, float rhs) {
+  if constexpr (Kind == BinaryKernel::Add) {
+    return lhs + rhs;
+  } else if constexpr (Kind == BinaryKernel::Multiply) {
+    return lhs * rhs;
+  } else if constexpr (Kind == BinaryKernel::Subtract) {
+    return lhs - rhs;
+  } else {
+    return lhs >= rhs ? 1.0f : 0.0f;
+  }
+}
+
+// The output is walked as rows of its innermost dim, each operand either
+// advances along the row or repeats a single broadcast value.
+struct BinaryPlan {
+  BinaryKernel kind;
+  float const *lhs;
+  float const *rhs;
+  float *out;
+  KernelShape outShape;
+  std::vector<std::uint64_t> lhsStrides;
+  std::vector<std::uint64_t> rhsStrides;
+  std::uint64_t rowSize;
+};
+
+template <BinaryKernel Kind>
+void binaryRow(float const *lhs, bool lhsRepeats, float const *rhs,
+               bool rhsRepeats, float *out, std::uint64_t size) {
+  if (not lhsRepeats and not rhsRepeats) {
+    for (std::uint64_t i = 0; i < size; ++i) {
+      out[i] = apply<Kind>(lhs[i], rhs[i]);
+    }
+  } else if (lhsRepeats and not rhsRepeats) {
+    float value = *lhs;
+    for (std::uint64_t i = 0; i < size; ++i) {
+      out[i] = apply<Kind>(value, rhs[i]);
+    }
+  } else if (not lhsRepeats) {
+    float value = *rhs;
+    for (std::uint64_t i = 0; i < size; ++i) {
+      out[i] = apply<Kind>(lhs[i], value);
+    }
+  } else {
+    std::fill_n(out, size, apply<Kind>(*lhs, *rhs));
+  }
+}
+
+template <BinaryKernel Kind>
+void binaryRows(BinaryPlan const &plan, std::uint64_t begin,
+                std::uint64_t end) {
+  std::size_t rank = plan.outShape.size();
+  bool lhsRepeats = rank == 0 or plan.lhsStrides.back() == 0;
+  bool rhsRepeats = rank == 0 or plan.rhsStrides.back() == 0;
+  for (std::uint64_t row = begin; row < end; ++row) {
+    std::uint64_t lhsOffset = 0;
+    std::uint64_t rhsOffset = 0;
+    std::uint64_t index = row;
+    for (std::size_t i = 1; i < rank; ++i) {
+      std::size_t dim = rank - 1 - i;
+      std::uint64_t coord = index % plan.outShape[dim];
+      index /= plan.outShape[dim];
+      lhsOffset += coord * plan.lhsStrides[dim];
+      rhsOffset += coord * plan.rhsStrides[dim];
+    }
+    binaryRow<Kind>(plan.lhs + lhsOffset, lhsRepeats, plan.rhs + rhsOffset,
+                    rhsRepeats, plan.out + row * plan.rowSize, plan.rowSize);
+  }
+}
+
+void binaryRowsImpl(BinaryPlan const &plan, std::uint64_t begin,
+                    std::uint64_t end) {
+  switch (plan.kind) {
+  case BinaryKernel::Add:
+    return binaryRows<BinaryKernel::Add>(plan, begin, end);
+  case BinaryKernel::Multiply:
+    return binaryRows<BinaryKernel::Multiply>(plan, begin, end);
+  case BinaryKernel::Subtract:
+    return binaryRows<BinaryKernel::Subtract>(plan, begin, end);
+  case BinaryKernel::GreaterEqual:
+    return binaryRows<BinaryKernel::GreaterEqual>(plan, begin, end);
+  }
+}
+
+void unaryImpl(UnaryKernel kind, float const *in, float *out,
+               std::uint64_t begin, std::uint64_t end) {
+  switch (kind) {
+  case UnaryKernel::Relu:
+    for (std::uint64_t i = begin; i < end; ++i) {
+      out[i] = std::max(in[i], 0.0f);
+    }
+    return;
+  }
+}
+
+struct MatmulPlan {
+  float const *lhs;
+  float const *rhs;
+  float *out;
+  // Offsets of the operands for every batch of the output.
+  std::vector<std::uint64_t> lhsBatchOffsets;
+  std::vector<std::uint64_t> rhsBatchOffsets;
+  std::uint64_t m;
+  std::uint64_t k;
+  std::uint64_t n;
+};
+
+// Rows index the flattened [batch, M] extent of the output. Each row is
+// accumulated as a sum of rhs rows scaled by the lhs row, one block of
+// columns at a time, which keeps the inner loop contiguous.
+void matmulRowsImpl(MatmulPlan const &plan, std::uint64_t begin,
+                    std::uint64_t end) {
+  for (std::uint64_t colBegin = 0; colBegin < plan.n;
+       colBegin += kMatmulBlockCols) {
+    std::uint64_t cols = std::min(kMatmulBlockCols, plan.n - colBegin);
+    for (std::uint64_t row = begin; row < end; ++row) {
+      std::uint64_t batch = row / plan.m;
+      float const *lhsRow = plan.lhs + plan.lhsBatchOffsets[batch] +
+                            (row % plan.m) * plan.k;
+      float const *rhs = plan.rhs + plan.rhsBatchOffsets[batch] + colBegin;
+      float *out = plan.out + row * plan.n + colBegin;
+      std::fill_n(out, cols, 0.0f);
+      for (std::uint64_t i = 0; i < plan.k; ++i) {
+        float scale = lhsRow[i];
+        float const *rhsRow = rhs + i * plan.n;
+        for (std::uint64_t j = 0; j < cols; ++j) {
+          out[j] += scale * rhsRow[j];
+        }
+      }
+    }
+  }
+}
+
+using BinaryRowsFn = void (*)(BinaryPlan const &, std::uint64_t,
+                              std::uint64_t);
+using UnaryFn = void (*)(UnaryKernel, float const *, float *, std::uint64_t,
+                         std::uint64_t);
+using MatmulRowsFn = void (*)(MatmulPlan const &, std::uint64_t,
+                              std::uint64_t);
+
+struct Kernels {
+  BinaryRowsFn binaryRows;
+  UnaryFn unary;
+  MatmulRowsFn matmulRows;
+};
+
+// The loops are flattened into these entry points so that they are
+// vectorized for the matching instruction set.
+#define TT_RUNTIME_KERNELS(suffix, target)                                     \
+  target __attribute__((flatten)) void binaryRows##suffix(                     \
+      BinaryPlan const &plan, std::uint64_t begin, std::uint64_t end) {        \
+    binaryRowsImpl(plan, begin, end);                                          \
+  }                                                                            \
+  target __attribute__((flatten)) void unary##suffix(                          \
+      UnaryKernel kind, float const *in, float *out, std::uint64_t begin,      \
+      std::uint64_t end) {                                                     \
+    unaryImpl(kind, in, out, begin, end);                                      \
+  }                                                                            \
+  target __attribute__((flatten)) void matmulRows##suffix(                     \
+      MatmulPlan const &plan, std::uint64_t begin, std::uint64_t end) {        \
+    matmulRowsImpl(plan, begin, end);                                          \
+  }
+
+TT_RUNTIME_KERNELS(Scalar, TT_RUNTIME_NO_TARGET)
+#if defined(__x86_64__)
+TT_RUNTIME_KERNELS(AVX2, TT_RUNTIME_TARGET("avx2,fma"))
+TT_RUNTIME_KERNELS(AVX512, TT_RUNTIME_TARGET("avx512f"))
+#endif
+#undef TT_RUNTIME_KERNELS
+
+Kernels getKernels() {
+  switch (getSimdLevel()) {
+#if defined(__x86_64__)
+  case SimdLevel::AVX512:
+    return {binaryRowsAVX512, unaryAVX512, matmulRowsAVX512};
+  case SimdLevel::AVX2:
+    return {binaryRowsAVX2, unaryAVX2, matmulRowsAVX2};
+#endif
+  default:
+    return {binaryRowsScalar, unaryScalar, matmulRowsScalar};
+  }
+}
+} // namespace
+
+std::uint64_t getVolume(KernelShape const &shape) {
+  std::uint64_t volume = 1;
+  for (std::uint32_t dim : shape) {
+    volume *= dim;
+  }
+  return volume;
+}
+
+KernelShape broadcastShapes(KernelShape const &lhs, KernelShape const &rhs) {
+  KernelShape shape(std::max(lhs.size(), rhs.size()), 1);
+  for (std::size_t i = 0; i < shape.size(); ++i) {
+    std::uint32_t l = i < lhs.size() ? lhs[lhs.size() - 1 - i] : 1;
+    std::uint32_t r = i < rhs.size() ? rhs[rhs.size() - 1 - i] : 1;
+    if (l != r and l != 1 and r != 1) {
+      throw std::runtime_error("Shapes cannot be broadcast together");
+    }
+    shape[shape.size() - 1 - i] = l == 1 ? r : l;
+  }
+  return shape;
+}
+
+void binary(BinaryKernel kind, float const *lhs, KernelShape const &lhsShape,
+            float const *rhs, KernelShape const &rhsShape, float *out,
+            KernelShape const &outShape) {
+  if (broadcastShapes(broadcastShapes(lhsShape, rhsShape), outShape) !=
+      outShape) {
+    throw std::runtime_error("Operands do not broadcast to the output shape");
+  }
+  BinaryPlan plan{kind, lhs, rhs, out, outShape, {}, {}, 1};
+  if (lhsShape == rhsShape) {
+    // Same shapes are one flat row, regardless of rank.
+    plan.rowSize = getVolume(outShape);
+    plan.outShape = {std::uint32_t(1), std::uint32_t(plan.rowSize)};
+    plan.lhsStrides = plan.rhsStrides = {0, 1};
+  } else {
+    plan.rowSize = outShape.empty() ? 1 : outShape.back();
+    plan.lhsStrides = getBroadcastStrides(lhsShape, outShape);
+    plan.rhsStrides = getBroadcastStrides(rhsShape, outShape);
+  }
+  std::uint64_t rows = plan.rowSize ? getVolume(outShape) / plan.rowSize : 0;
+  if (rows == 1) {
+    // Split a single long row into independent pieces instead.
+    BinaryRowsFn fn = getKernels().binaryRows;
+    getHostThreadPool()->parallelFor(
+        plan.rowSize, kGrain, [&](std::size_t begin, std::size_t end) {
+          BinaryPlan piece = plan;
+          bool lhsRepeats = plan.lhsStrides.back() == 0;
+          bool rhsRepeats = plan.rhsStrides.back() == 0;
+          piece.lhs += lhsRepeats ? 0 : begin;
+          piece.rhs += rhsRepeats ? 0 : begin;
+          piece.out += begin;
+          piece.rowSize = end - begin;
+          fn(piece, 0, 1);
+        });
+    return;
+  }
+  BinaryRowsFn fn = getKernels().binaryRows;
+  getHostThreadPool()->parallelFor(
+      rows, getGrain(plan.rowSize),
+      [&](std::size_t begin, std::size_t end) { fn(plan, begin, end); });
+}
+
+void unary(UnaryKernel kind, float const *in, float *out, std::uint64_t size) {
+  UnaryFn fn = getKernels().unary;
+  getHostThreadPool()->parallelFor(
+      size, kGrain, [&](std::size_t begin, std::size_t end) {
+        fn(kind, in, out, begin, end);
+      });
+}
+
+KernelShape getMatmulShape(KernelShape const &lhs, KernelShape const &rhs) {
+  if (lhs.size() < 2 or rhs.size() < 2) {
+    throw std::runtime_error("Matmul operands must be at least 2D");
+  }
+  if (lhs.back() != rhs[rhs.size() - 2]) {
+    throw std::runtime_error("Matmul inner dimensions do not match");
+  }
+  KernelShape shape =
+      broadcastShapes(KernelShape(lhs.begin(), lhs.end() - 2),
+                      KernelShape(rhs.begin(), rhs.end() - 2));
+  shape.push_back(lhs[lhs.size() - 2]);
+  shape.push_back(rhs.back());
+  return shape;
+}
+
+void matmul(float const *lhs, KernelShape const &lhsShape, float const *rhs,
+            KernelShape const &rhsShape, float *out) {
+  KernelShape outShape = getMatmulShape(lhsShape, rhsShape);
+  KernelShape batchShape(outShape.begin(), outShape.end() - 2);
+  MatmulPlan plan;
+  plan.lhs = lhs;
+  plan.rhs = rhs;
+  plan.out = out;
+  plan.m = lhsShape[lhsShape.size() - 2];
+  plan.k = lhsShape.back();
+  plan.n = rhsShape.back();
+
+  std::vector<std::uint64_t> lhsStrides = getBroadcastStrides(
+      KernelShape(lhsShape.begin(), lhsShape.end() - 2), batchShape);
+  std::vector<std::uint64_t> rhsStrides = getBroadcastStrides(
+      KernelShape(rhsShape.begin(), rhsShape.end() - 2), batchShape);
+  std::uint64_t numBatches = getVolume(batchShape);
+  for (std::uint64_t batch = 0; batch < numBatches; ++batch) {
+    std::uint64_t lhsBatch = 0;
+    std::uint64_t rhsBatch = 0;
+    std::uint64_t index = batch;
+    for (std::size_t i = 0; i < batchShape.size(); ++i) {
+      std::size_t dim = batchShape.size() - 1 - i;
+      std::uint64_t coord = index % batchShape[dim];
+      index /= batchShape[dim];
+      lhsBatch += coord * lhsStrides[dim];
+      rhsBatch += coord * rhsStrides[dim];
+    }
+    plan.lhsBatchOffsets.push_back(lhsBatch * plan.m * plan.k);
+    plan.rhsBatchOffsets.push_back(rhsBatch * plan.k * plan.n);
+  }
+
+  MatmulRowsFn fn = getKernels().matmulRows;
+  getHostThreadPool()->parallelFor(
+      numBatches * plan.m, getGrain(plan.k * plan.n),
+      [&](std::size_t begin, std::size_t end) { fn(plan, begin, end); });
+}
+
+void sum(float const *in, KernelShape const &shape,
+         std::vector<std::int32_t> const &dims, float *out) {
+  std::size_t rank = shape.size();
+  std::vector<bool> reduced(rank, dims.empty());
+  for (std::int32_t dim : dims) {
+    reduced[normalizeDim(dim, rank)] = true;
+  }
+
+  std::vector<std::uint64_t> strides(rank, 1);
+  for (std::size_t i = rank; i-- > 1;) {
+    strides[i - 1] = strides[i] * shape[i];
+  }
+  // Kept and reduced dims, outermost first.
+  std::vector<std::size_t> keptDims;
+  std::vector<std::size_t> reducedDims;
+  for (std::size_t dim = 0; dim < rank; ++dim) {
+    (reduced[dim] ? reducedDims : keptDims).push_back(dim);
+  }
+  std::uint64_t numOutputs = 1;
+  for (std::size_t dim : keptDims) {
+    numOutputs *= shape[dim];
+  }
+  std::uint64_t numReduced = getVolume(shape) / std::max<std::uint64_t>(
+                                                    numOutputs, 1);
+
+  getHostThreadPool()->parallelFor(
+      numOutputs, getGrain(numReduced),
+      [&](std::size_t begin, std::size_t end) {
+        std::vector<std::uint32_t> coords(reducedDims.size());
+        for (std::uint64_t o = begin; o < end; ++o) {
+          std::uint64_t base = 0;
+          std::uint64_t index = o;
+          for (std::size_t i = keptDims.size(); i-- > 0;) {
+            std::size_t dim = keptDims[i];
+            base += (index % shape[dim]) * strides[dim];
+            index /= shape[dim];
+          }
+          // Accumulated in double, this is the reference result.
+          double total = 0.0;
+          std::fill(coords.begin(), coords.end(), 0);
+          for (std::uint64_t r = 0; r < numReduced; ++r) {
+            std::uint64_t offset = base;
+            for (std::size_t i = 0; i < reducedDims.size(); ++i) {
+              offset += coords[i] * strides[reducedDims[i]];
+            }
+            total += in[offset];
+            for (std::size_t i = reducedDims.size(); i-- > 0;) {
+              if (++coords[i] < shape[reducedDims[i]]) {
+                break;
+              }
+              coords[i] = 0;
+            }
+          }
+          out[o] = static_cast<float>(total);
+        }
+      });
+}
+
+void softmax(float const *in, KernelShape const &shape, std::int32_t dim,
+             float *out) {
+  std::uint32_t axis = normalizeDim(dim, shape.size());
+  std::uint64_t outer = 1;
+  for (std::uint32_t i = 0; i < axis; ++i) {
+    outer *= shape[i];
+  }
+  std::uint64_t extent = shape[axis];
+  std::uint64_t inner = 1;
+  for (std::size_t i = axis + 1; i < shape.size(); ++i) {
+    inner *= shape[i];
+  }
+
+  // Each outer slice is an [extent, inner] matrix normalized along its
+  // columns, swept row by row so that every pass is contiguous.
+  getHostThreadPool()->parallelFor(
+      outer, getGrain(extent * inner),
+      [&](std::size_t begin, std::size_t end) {
+        std::vector<float> maxima(inner);
+        std::vector<double> totals(inner);
+        for (std::uint64_t o = begin; o < end; ++o) {
+          float const *src = in + o * extent * inner;
+          float *dst = out + o * extent * inner;
+          std::fill(maxima.begin(), maxima.end(),
+                    -std::numeric_limits<float>::infinity());
+          std::fill(totals.begin(), totals.end(), 0.0);
+          for (std::uint64_t d = 0; d < extent; ++d) {
+            for (std::uint64_t j = 0; j < inner; ++j) {
+              maxima[j] = std::max(maxima[j], src[d * inner + j]);
+            }
+          }
+          for (std::uint64_t d = 0; d < extent; ++d) {
+            for (std::uint64_t j = 0; j < inner; ++j) {
+              float value = std::exp(src[d * inner + j] - maxima[j]);
+              dst[d * inner + j] = value;
+              totals[j] += value;
+            }
+          }
+          for (std::uint64_t d = 0; d < extent; ++d) {
+            for (std::uint64_t j = 0; j < inner; ++j) {
+              dst[d * inner + j] =
+                  static_cast<float>(dst[d * inner + j] / totals[j]);
+            }
+          }
+        }
+      });
+}
+
+void bf16ToFloat(std::uint16_t const *src, float *dst, std::uint64_t size) {
+  getHostThreadPool()->parallelFor(
+      size, kGrain, [&](std::size_t begin, std::size_t end) {
+        for (std::uint64_t i = begin; i < end; ++i) {
+          std::uint32_t bits = std::uint32_t(src[i]) << 16;
+          std::memcpy(&dst[i], &bits, sizeof(bits));
+        }
+      });
+}
+
+void floatToBf16(float const *src, std::uint16_t *dst, std::uint64_t size) {
+  getHostThreadPool()->parallelFor(
+      size, kGrain, [&](std::size_t begin, std::size_t end) {
+        for (std::uint64_t i = begin; i < end; ++i) {
+          std::uint32_t bits;
+          std::memcpy(&bits, &src[i], sizeof(bits));
+          if ((bits & 0x7fffffff) > 0x7f800000) {
+            // Keep NaNs quiet rather than rounding them into Inf.
+            dst[i] = (bits >> 16) | 0x40;
+            continue;
+          }
+          bits += 0x7fff + ((bits >> 16) & 1);
+          dst[i] = bits >> 16;
+        }
+      });
+}
+
+} // namespace tt::runtime::detail
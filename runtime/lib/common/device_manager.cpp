@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/device_manager.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tt::runtime::detail {
+
+DeviceManager::DeviceManager(OpenFn open, CloseFn close)
+    : open(std::move(open)), close(std::move(close)) {}
+
+DeviceManager::~DeviceManager() { closeIdle(); }
+
+// Only devices that opened get an entry, a failed open leaves nothing to
+// close later.
+DeviceManager::Entry &DeviceManager::getOrOpen(int deviceId) {
+  if (auto match = devices.find(deviceId); match != devices.end()) {
+    return match->second;
+  }
+  void *device = open(deviceId);
+  return devices.emplace(deviceId, Entry{device, 0}).first->second;
+}
+
+void *DeviceManager::acquire(int deviceId) {
+  std::lock_guard<std::mutex> lock(mutex);
+  Entry &entry = getOrOpen(deviceId);
+  ++entry.refCount;
+  return entry.device;
+}
+
+void DeviceManager::release(void *device) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto match = std::find_if(devices.begin(), devices.end(), [device](auto &e) {
+    return e.second.device == device;
+  });
+  if (match == devices.end() or match->second.refCount == 0) {
+    throw std::runtime_error("Releasing a device that was not acquired");
+  }
+  if (--match->second.refCount == 0) {
+    close(device);
+    devices.erase(match);
+  }
+}
+
+void *DeviceManager::borrow(int deviceId) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return getOrOpen(deviceId).device;
+}
+
+void DeviceManager::closeIdle() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto iter = devices.begin(); iter != devices.end();) {
+    if (iter->second.refCount == 0) {
+      close(iter->second.device);
+      iter = devices.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+std::uint32_t DeviceManager::getRefCount(int deviceId) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto match = devices.find(deviceId);
+  return match == devices.end() ? 0 : match->second.refCount;
+}
+
+SystemDescCache::SystemDescCache(std::string directory)
+    : directory(std::move(directory)) {}
+
+std::string SystemDescCache::getDefaultDirectory() {
+  char const *directory = std::getenv("TT_RUNTIME_SYSTEM_DESC_CACHE_DIR");
+  return directory ? directory : "";
+}
+
+static std::optional<SystemDescCache::Buffer>
+readCacheFile(std::string const &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (not file) {
+    return std::nullopt;
+  }
+  std::size_t size = file.tellg();
+  file.seekg(0);
+  std::shared_ptr<void> buffer(std::malloc(size), std::free);
+  if (not file.read(static_cast<char *>(buffer.get()), size)) {
+    return std::nullopt;
+  }
+  return SystemDescCache::Buffer(buffer, size);
+}
+
+// Written to a temporary file first so that concurrent processes only ever
+// see complete entries.
+static void writeCacheFile(std::string const &path,
+                           SystemDescCache::Buffer const &buffer) {
+  std::string tmpPath = path + ".tmp." + std::to_string(::getpid());
+  {
+    std::ofstream file(tmpPath, std::ios::binary);
+    file.write(static_cast<char const *>(buffer.first.get()), buffer.second);
+    if (not file) {
+      std::remove(tmpPath.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+  }
+}
+
+SystemDescCache::Buffer SystemDescCache::getOrCreate(
+    std::string const &fingerprint, std::function<Buffer()> const &create,
+    std::function<bool(void const *, std::size_t)> const &verify) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (auto match = entries.find(fingerprint); match != entries.end()) {
+    return match->second;
+  }
+
+  std::string path =
+      directory.empty() ? "" : directory + "/" + fingerprint + ".ttsys";
+  if (not path.empty()) {
+    std::optional<Buffer> cached = readCacheFile(path);
+    if (cached and verify(cached->first.get(), cached->second)) {
+      return entries[fingerprint] = *cached;
+    }
+  }
+
+  Buffer buffer = create();
+  if (not path.empty()) {
+    ::mkdir(directory.c_str(), 0755);
+    writeCacheFile(path, buffer);
+  }
+  return entries[fingerprint] = buffer;
+}
+
+namespace {
+// FNV-1a, only used to turn the fingerprint inputs into a file name.
+class Hasher {
+public:
+  void add(void const *data, std::size_t size) {
+    auto const *bytes = static_cast<unsigned char const *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+  }
+
+  template <typename T> void add(T const &value) { add(&value, sizeof(T)); }
+
+  void add(std::string const &value) { add(value.data(), value.size() + 1); }
+
+  std::string str() const {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx",
+                  static_cast<unsigned long long>(hash));
+    return hex;
+  }
+
+private:
+  std::uint64_t hash = 14695981039346656037ull;
+};
+} // namespace
+
+std::string getDeviceFingerprint(std::vector<int> const &deviceIds,
+                                 std::string const &buildId) {
+  Hasher hasher;
+  hasher.add(buildId);
+  for (int deviceId : deviceIds) {
+    hasher.add(deviceId);
+  }
+
+  // Device nodes are recreated whenever the driver enumerates the devices.
+  constexpr char const *devDir = "/dev/tenstorrent";
+  std::vector<std::string> names;
+  if (DIR *dir = ::opendir(devDir)) {
+    while (dirent *entry = ::readdir(dir)) {
+      if (entry->d_name[0] != '.') {
+        names.push_back(entry->d_name);
+      }
+    }
+    ::closedir(dir);
+  }
+  std::sort(names.begin(), names.end());
+  for (std::string const &name : names) {
+    struct stat info;
+    if (::stat((std::string(devDir) + "/" + name).c_str(), &info) != 0) {
+      continue;
+    }
+    hasher.add(name);
+    hasher.add(info.st_rdev);
+    hasher.add(info.st_ctim.tv_sec);
+    hasher.add(info.st_ctim.tv_nsec);
+  }
+  return hasher.str();
+}
+
+} // namespace tt::runtime::detail
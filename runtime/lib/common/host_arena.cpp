@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/host_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace tt::runtime::detail {
+
+namespace {
+constexpr std::size_t kMinSizeClass = 64;
+
+std::size_t getPageSize() {
+  static std::size_t pageSize = ::sysconf(_SC_PAGESIZE);
+  return pageSize;
+}
+} // namespace
+
+struct HostArena::State {
+  std::mutex mutex;
+  std::size_t capacity;
+  std::size_t freeBytes = 0;
+  std::unordered_map<std::size_t, std::vector<void *>> freeLists;
+  std::atomic<std::uint64_t> numSystemAllocations = 0;
+
+  explicit State(std::size_t capacity) : capacity(capacity) {}
+
+  ~State() { trim(); }
+
+  void release(void *ptr, std::size_t sizeClass) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (freeBytes + sizeClass <= capacity) {
+        freeLists[sizeClass].push_back(ptr);
+        freeBytes += sizeClass;
+        return;
+      }
+    }
+    std::free(ptr);
+  }
+
+  // Frees free buffers until at most limit bytes of them are left.
+  void shrink(std::size_t limit) {
+    std::vector<void *> dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto &[sizeClass, freeList] : freeLists) {
+        while (freeBytes > limit and not freeList.empty()) {
+          dropped.push_back(freeList.back());
+          freeList.pop_back();
+          freeBytes -= sizeClass;
+        }
+      }
+    }
+    for (void *ptr : dropped) {
+      std::free(ptr);
+    }
+  }
+
+  void trim() { shrink(0); }
+};
+
+HostArena::HostArena(std::size_t capacityBytes)
+    : state(std::make_shared<State>(capacityBytes)) {}
+
+// Buffers still in use keep the state alive and are freed when dropped.
+HostArena::~HostArena() { setCapacity(0); }
+
+std::size_t HostArena::getSizeClass(std::size_t size) {
+  if (size <= kMinSizeClass) {
+    return kMinSizeClass;
+  }
+  std::size_t power = std::size_t(1) << (63 - __builtin_clzll(size - 1));
+  std::size_t step = std::max(power / 4, kMinSizeClass);
+  return (size + step - 1) / step * step;
+}
+
+std::size_t HostArena::getDefaultCapacity() {
+  char const *value = std::getenv("TT_RUNTIME_HOST_ARENA_BYTES");
+  if (value and *value) {
+    return std::stoull(value);
+  }
+  return std::size_t(1) << 30;
+}
+
+std::shared_ptr<void> HostArena::allocate(std::size_t size) {
+  std::size_t sizeClass = getSizeClass(size);
+  void *ptr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    auto freeList = state->freeLists.find(sizeClass);
+    if (freeList != state->freeLists.end() and not freeList->second.empty()) {
+      ptr = freeList->second.back();
+      freeList->second.pop_back();
+      state->freeBytes -= sizeClass;
+    }
+  }
+  if (not ptr) {
+    std::size_t alignment =
+        sizeClass >= getPageSize() ? getPageSize() : kMinSizeClass;
+    if (::posix_memalign(&ptr, alignment, sizeClass) != 0) {
+      throw std::bad_alloc();
+    }
+    state->numSystemAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  return std::shared_ptr<void>(ptr, [state = state, sizeClass](void *ptr) {
+    state->release(ptr, sizeClass);
+  });
+}
+
+void HostArena::setCapacity(std::size_t capacityBytes) {
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->capacity = capacityBytes;
+  }
+  state->shrink(capacityBytes);
+}
+
+void HostArena::trim() { state->trim(); }
+
+std::size_t HostArena::getFreeBytes() {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->freeBytes;
+}
+
+std::uint64_t HostArena::getNumSystemAllocations() {
+  return state->numSystemAllocations.load(std::memory_order_relaxed);
+}
+
+HostArena &getHostArena() {
+  static HostArena arena;
+  return arena;
+}
+
+} // namespace tt::runtime::detail
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/perf_model.h"
+
+#include <algorithm>
+
+namespace tt::runtime::detail {
+
+namespace {
+std::uint64_t alignUp(std::uint64_t bytes, std::uint32_t align) {
+  return align ? (bytes + align - 1) / align * align : bytes;
+}
+
+double getDramBytesPerNs(PerfChip const &chip) {
+  return chip.dramBytesPerNsPerChannel *
+         std::max<std::uint32_t>(chip.numDramChannels, 1);
+}
+
+void finalize(PerfEstimate &estimate) {
+  estimate.latencyNs =
+      estimate.overheadNs + std::max({estimate.pcieNs, estimate.dramNs,
+                                      estimate.nocNs, estimate.computeNs});
+}
+
+// Marks the cores of a kernel in a grid sized occupancy map, clipping the
+// range to the grid.
+void markCores(PerfChip const &chip, PerfKernel const &kernel,
+               std::vector<bool> &occupied) {
+  std::uint32_t yEnd = std::min(kernel.y + kernel.height, chip.gridY);
+  std::uint32_t xEnd = std::min(kernel.x + kernel.width, chip.gridX);
+  for (std::uint32_t y = kernel.y; y < yEnd; ++y) {
+    for (std::uint32_t x = kernel.x; x < xEnd; ++x) {
+      occupied[y * chip.gridX + x] = true;
+    }
+  }
+}
+} // namespace
+
+PerfEstimate estimateHostTransfer(PerfChip const &chip,
+                                  PerfBuffer const &buffer) {
+  PerfEstimate estimate;
+  estimate.overheadNs = chip.pcieLatencyNs;
+  estimate.pcieNs = alignUp(buffer.bytes, chip.pcieAlign) / chip.pcieBytesPerNs;
+  switch (buffer.memory) {
+  case PerfMemory::Host:
+    break;
+  case PerfMemory::DRAM:
+    estimate.dramNs =
+        alignUp(buffer.bytes, chip.nocDramAlign) / getDramBytesPerNs(chip);
+    break;
+  case PerfMemory::L1:
+    // Fanned out to the cores from the PCIe endpoint over a single link.
+    estimate.nocNs = alignUp(buffer.bytes, chip.nocL1Align) /
+                     (chip.nocBytesPerCycle * chip.clockGHz);
+    break;
+  }
+  finalize(estimate);
+  return estimate;
+}
+
+PerfEstimate estimateDispatch(PerfChip const &chip,
+                              PerfDispatch const &dispatch) {
+  PerfEstimate estimate;
+  estimate.overheadNs = chip.dispatchLatencyNs +
+                        chip.kernelLaunchNs * dispatch.kernels.size();
+
+  std::vector<bool> workers(std::size_t(chip.gridY) * chip.gridX, false);
+  std::vector<bool> computeCores(workers.size(), false);
+  bool usesNoc0 = false;
+  bool usesNoc1 = false;
+  for (PerfKernel const &kernel : dispatch.kernels) {
+    markCores(chip, kernel, workers);
+    if (kernel.core == PerfCore::Compute) {
+      markCores(chip, kernel, computeCores);
+    }
+    usesNoc0 |= kernel.core == PerfCore::Noc0;
+    usesNoc1 |= kernel.core == PerfCore::Noc1;
+  }
+  std::uint64_t numWorkers = std::count(workers.begin(), workers.end(), true);
+  std::uint64_t numComputeCores =
+      std::count(computeCores.begin(), computeCores.end(), true);
+  if (numWorkers == 0) {
+    finalize(estimate);
+    return estimate;
+  }
+
+  std::uint64_t dramBytes = 0;
+  std::uint64_t nocBytes = 0;
+  std::uint64_t l1Bytes = 0;
+  for (PerfBuffer const &operand : dispatch.operands) {
+    switch (operand.memory) {
+    case PerfMemory::Host:
+      break;
+    case PerfMemory::DRAM:
+      dramBytes += alignUp(operand.bytes, chip.nocDramAlign);
+      nocBytes += alignUp(operand.bytes, chip.nocDramAlign);
+      break;
+    case PerfMemory::L1:
+      l1Bytes += alignUp(operand.bytes, chip.nocL1Align);
+      nocBytes += alignUp(operand.bytes, chip.nocL1Align);
+      break;
+    }
+  }
+  // L1 operands are sharded over the workers, whatever does not fit in their
+  // L1 has to be streamed through DRAM instead.
+  std::uint64_t l1Capacity = chip.l1Size * numWorkers;
+  if (l1Bytes > l1Capacity) {
+    dramBytes += l1Bytes - l1Capacity;
+  }
+  if (dramBytes) {
+    estimate.dramNs = chip.dramLatencyNs + dramBytes / getDramBytesPerNs(chip);
+  }
+  if (nocBytes) {
+    // Every worker moves its share of the operands over the NOCs its data
+    // movement kernels use, from an average distance on the torus.
+    double numNocs = std::max(int(usesNoc0) + int(usesNoc1), 1);
+    double averageHops = (chip.gridY + chip.gridX) / 4.0;
+    double bytesPerWorker = double(nocBytes) / numWorkers;
+    double cycles = averageHops * chip.nocHopCycles +
+                    bytesPerWorker / (chip.nocBytesPerCycle * numNocs);
+    estimate.nocNs = cycles / chip.clockGHz;
+  }
+  if (numComputeCores and not dispatch.operands.empty()) {
+    std::uint64_t tiles = dispatch.operands.back().tiles;
+    std::uint64_t tilesPerCore =
+        (tiles + numComputeCores - 1) / numComputeCores;
+    estimate.computeNs =
+        tilesPerCore * chip.computeCyclesPerTile / chip.clockGHz;
+  }
+  finalize(estimate);
+  return estimate;
+}
+
+PerfEstimate estimateHostCommand(PerfChip const &chip) {
+  PerfEstimate estimate;
+  estimate.overheadNs = chip.hostCommandNs;
+  finalize(estimate);
+  return estimate;
+}
+
+PerfEstimate estimateFinish(PerfChip const &chip) {
+  PerfEstimate estimate;
+  estimate.overheadNs = chip.pcieLatencyNs;
+  finalize(estimate);
+  return estimate;
+}
+
+} // namespace tt::runtime::detail
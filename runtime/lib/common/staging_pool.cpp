@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/staging_pool.h"
+#include "tt/runtime/detail/host_arena.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace tt::runtime::detail {
+
+namespace {
+std::size_t getPageSize() {
+  static std::size_t pageSize = ::sysconf(_SC_PAGESIZE);
+  return pageSize;
+}
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+struct Mapping {
+  void *addr;
+  std::size_t size;
+};
+} // namespace
+
+struct StagingPool::State {
+  std::mutex mutex;
+  std::size_t capacity;
+  std::size_t freeBytes = 0;
+  std::unordered_map<std::size_t, std::vector<void *>> freeLists;
+  std::atomic<std::uint64_t> numMappings = 0;
+  std::atomic<std::uint64_t> numHugePageMappings = 0;
+  std::atomic<std::uint64_t> numPinnedMappings = 0;
+
+  explicit State(std::size_t capacity) : capacity(capacity) {}
+
+  ~State() { shrink(0); }
+
+  // Reserved huge pages first, a plain mapping asking for transparent huge
+  // pages when none are left or the host has none.
+  Mapping map(std::size_t size, bool hugePages) {
+    void *addr = MAP_FAILED;
+    if (hugePages) {
+      addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (addr != MAP_FAILED) {
+        numHugePageMappings.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (addr == MAP_FAILED) {
+      addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (addr == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+#ifdef MADV_HUGEPAGE
+      if (hugePages) {
+        ::madvise(addr, size, MADV_HUGEPAGE);
+      }
+#endif
+    }
+    // Locking faults every page in up front. Past RLIMIT_MEMLOCK the buffer
+    // stays pageable, which only costs the faults on first use.
+    if (::mlock(addr, size) == 0) {
+      numPinnedMappings.fetch_add(1, std::memory_order_relaxed);
+    }
+    numMappings.fetch_add(1, std::memory_order_relaxed);
+    return {addr, size};
+  }
+
+  void release(void *addr, std::size_t size) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (freeBytes + size <= capacity) {
+        freeLists[size].push_back(addr);
+        freeBytes += size;
+        return;
+      }
+    }
+    ::munmap(addr, size);
+  }
+
+  // Unmaps free buffers until at most limit bytes of them are left.
+  void shrink(std::size_t limit) {
+    std::vector<Mapping> dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto &[size, freeList] : freeLists) {
+        while (freeBytes > limit and not freeList.empty()) {
+          dropped.push_back({freeList.back(), size});
+          freeList.pop_back();
+          freeBytes -= size;
+        }
+      }
+    }
+    for (Mapping const &mapping : dropped) {
+      ::munmap(mapping.addr, mapping.size);
+    }
+  }
+};
+
+StagingPool::StagingPool(std::size_t capacityBytes, bool useHugePages)
+    : state(std::make_shared<State>(capacityBytes)),
+      useHugePages(useHugePages) {}
+
+// Buffers still in use keep the state alive and are unmapped when dropped.
+StagingPool::~StagingPool() { setCapacity(0); }
+
+std::size_t StagingPool::getMappingSize(std::size_t size) const {
+  std::size_t sizeClass = HostArena::getSizeClass(size);
+  std::size_t hugePageSize = getHugePageSize();
+  if (useHugePages and sizeClass >= hugePageSize / 2) {
+    return alignUp(sizeClass, hugePageSize);
+  }
+  return alignUp(sizeClass, getPageSize());
+}
+
+std::size_t StagingPool::getDefaultCapacity() {
+  char const *value = std::getenv("TT_RUNTIME_STAGING_BYTES");
+  if (value and *value) {
+    return std::stoull(value);
+  }
+  return std::size_t(256) << 20;
+}
+
+bool StagingPool::getDefaultUseHugePages() {
+  char const *value = std::getenv("TT_RUNTIME_STAGING_HUGEPAGES");
+  return not value or std::strcmp(value, "0") != 0;
+}
+
+std::size_t StagingPool::getHugePageSize() {
+  static std::size_t hugePageSize = [] {
+    std::size_t size = std::size_t(2) << 20;
+    if (std::FILE *meminfo = std::fopen("/proc/meminfo", "r")) {
+      char line[256];
+      unsigned long long kib = 0;
+      while (std::fgets(line, sizeof(line), meminfo)) {
+        if (std::sscanf(line, "Hugepagesize: %llu kB", &kib) == 1 and kib) {
+          size = std::size_t(kib) << 10;
+          break;
+        }
+      }
+      std::fclose(meminfo);
+    }
+    return size;
+  }();
+  return hugePageSize;
+}
+
+std::shared_ptr<void> StagingPool::allocate(std::size_t size) {
+  std::size_t mappingSize = getMappingSize(size);
+  void *addr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    auto freeList = state->freeLists.find(mappingSize);
+    if (freeList != state->freeLists.end() and not freeList->second.empty()) {
+      addr = freeList->second.back();
+      freeList->second.pop_back();
+      state->freeBytes -= mappingSize;
+    }
+  }
+  if (not addr) {
+    addr = state
+               ->map(mappingSize,
+                     useHugePages and mappingSize % getHugePageSize() == 0)
+               .addr;
+  }
+  return std::shared_ptr<void>(addr, [state = state, mappingSize](void *addr) {
+    state->release(addr, mappingSize);
+  });
+}
+
+void StagingPool::setCapacity(std::size_t capacityBytes) {
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->capacity = capacityBytes;
+  }
+  state->shrink(capacityBytes);
+}
+
+void StagingPool::trim() { state->shrink(0); }
+
+std::size_t StagingPool::getFreeBytes() {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->freeBytes;
+}
+
+std::uint64_t StagingPool::getNumMappings() {
+  return state->numMappings.load(std::memory_order_relaxed);
+}
+
+std::uint64_t StagingPool::getNumHugePageMappings() {
+  return state->numHugePageMappings.load(std::memory_order_relaxed);
+}
+
+std::uint64_t StagingPool::getNumPinnedMappings() {
+  return state->numPinnedMappings.load(std::memory_order_relaxed);
+}
+
+StagingPool &getStagingPool() {
+  static StagingPool pool;
+  return pool;
+}
+
+} // namespace tt::runtime::detail
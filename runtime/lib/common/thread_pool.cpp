@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+namespace tt::runtime::detail {
+
+// A single parallelFor call. Threads claim chunks through next until none
+// are left, the caller then waits for the chunks still in flight.
+struct ThreadPool::Loop {
+  std::function<void(std::size_t, std::size_t)> const &fn;
+  std::size_t count;
+  std::size_t grain;
+  std::size_t numChunks;
+  std::atomic<std::size_t> next = 0;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::size_t finished = 0;
+  std::exception_ptr error;
+
+  Loop(std::function<void(std::size_t, std::size_t)> const &fn,
+       std::size_t count, std::size_t grain)
+      : fn(fn), count(count), grain(grain),
+        numChunks((count + grain - 1) / grain) {}
+
+  // Runs chunks until all of them have been claimed. Loops left in the queue
+  // after their caller returned find nothing to claim and never touch fn.
+  void runChunks() {
+    for (std::size_t chunk = next++; chunk < numChunks; chunk = next++) {
+      std::size_t begin = chunk * grain;
+      std::exception_ptr chunkError;
+      try {
+        fn(begin, std::min(begin + grain, count));
+      } catch (...) {
+        chunkError = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (chunkError and not error) {
+        error = chunkError;
+      }
+      if (++finished == numChunks) {
+        cv.notify_all();
+      }
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return finished == numChunks; });
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+};
+
+ThreadPool::ThreadPool(std::size_t numThreads) {
+  for (std::size_t i = 1; i < numThreads; ++i) {
+    workers.emplace_back([this] { run(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  cv.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallelFor(
+    std::size_t count, std::size_t grain,
+    std::function<void(std::size_t, std::size_t)> const &fn) {
+  grain = std::max<std::size_t>(grain, 1);
+  if (count == 0) {
+    return;
+  }
+  if (count <= grain or workers.empty()) {
+    fn(0, count);
+    return;
+  }
+
+  auto loop = std::make_shared<Loop>(fn, count, grain);
+  std::size_t helpers = std::min(loop->numChunks - 1, workers.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    loops.insert(loops.end(), helpers, loop);
+  }
+  if (helpers == 1) {
+    cv.notify_one();
+  } else {
+    cv.notify_all();
+  }
+  loop->runChunks();
+  loop->wait();
+}
+
+void ThreadPool::run() {
+  while (true) {
+    std::shared_ptr<Loop> loop;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this] { return stopping or not loops.empty(); });
+      if (loops.empty()) {
+        return;
+      }
+      loop = std::move(loops.front());
+      loops.pop_front();
+    }
+    loop->runChunks();
+  }
+}
+
+static std::size_t getDefaultThreadCount() {
+  if (char const *env = std::getenv("TT_RUNTIME_HOST_THREADS")) {
+    try {
+      std::size_t numThreads = std::stoul(env);
+      if (numThreads > 0) {
+        return numThreads;
+      }
+    } catch (std::exception const &) {
+      // Fall back to the hardware default on malformed values.
+    }
+  }
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+static std::mutex poolMutex;
+
+static std::shared_ptr<ThreadPool> &getPoolStorage() {
+  static std::shared_ptr<ThreadPool> pool;
+  return pool;
+}
+
+std::shared_ptr<ThreadPool> getHostThreadPool() {
+  std::lock_guard<std::mutex> lock(poolMutex);
+  auto &pool = getPoolStorage();
+  if (not pool) {
+    pool = std::make_shared<ThreadPool>(getDefaultThreadCount());
+  }
+  return pool;
+}
+
+void setHostThreadCount(std::size_t numThreads) {
+  if (numThreads == 0) {
+    numThreads = getDefaultThreadCount();
+  }
+  std::shared_ptr<ThreadPool> previous;
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    auto &pool = getPoolStorage();
+    if (pool and pool->getNumThreads() == numThreads) {
+      return;
+    }
+    previous = std::move(pool);
+    pool = std::make_shared<ThreadPool>(numThreads);
+  }
+  // Joined outside of the lock, or by the last loop still holding it.
+  previous.reset();
+}
+
+} // namespace tt::runtime::detail
@@ -0,0 +1,286 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/tilize.h"
+#include "tt/runtime/detail/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define TT_RUNTIME_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace tt::runtime::detail {
+
+constexpr std::uint32_t kFaceVolume = kFaceHeight * kFaceWidth;
+constexpr std::uint32_t kTileVolume = kTileHeight * kTileWidth;
+constexpr std::uint32_t kFacesPerRow = kTileWidth / kFaceWidth;
+
+namespace {
+// Copies one face row, kFaceWidth contiguous elements. The converters below
+// are instantiated once per policy so each inner loop is compiled for its
+// instruction set.
+template <std::size_t ElementSize> struct ScalarCopy {
+  static void copy(std::byte *dst, std::byte const *src) {
+    std::memcpy(dst, src, kFaceWidth * ElementSize);
+  }
+};
+
+#if defined(__x86_64__)
+template <std::size_t ElementSize> struct AVX2Copy {
+  TT_RUNTIME_TARGET("avx2")
+  static void copy(std::byte *dst, std::byte const *src) {
+    for (std::size_t i = 0; i < kFaceWidth * ElementSize; i += 32) {
+      __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), v);
+    }
+  }
+};
+
+template <std::size_t ElementSize> struct AVX512Copy {
+  TT_RUNTIME_TARGET("avx512f")
+  static void copy(std::byte *dst, std::byte const *src) {
+    if constexpr (kFaceWidth * ElementSize % 64 == 0) {
+      for (std::size_t i = 0; i < kFaceWidth * ElementSize; i += 64) {
+        __m512i v = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, v);
+      }
+    } else {
+      AVX2Copy<ElementSize>::copy(dst, src);
+    }
+  }
+};
+#endif
+
+// Offset of the face row holding (row, col) in a single batch of a tiled
+// tensor, col must be face aligned.
+inline std::uint64_t getTiledOffset(std::uint32_t tileCols, std::uint32_t row,
+                                    std::uint32_t col) {
+  std::uint32_t faceRow = (row % kTileHeight) / kFaceHeight;
+  std::uint32_t faceCol = (col % kTileWidth) / kFaceWidth;
+  return (std::uint64_t(row / kTileHeight) * tileCols + col / kTileWidth) *
+             kTileVolume +
+         (faceRow * kFacesPerRow + faceCol) * kFaceVolume +
+         (row % kFaceHeight) * kFaceWidth;
+}
+
+// Both converters handle the rows of tile rows [begin, end), counted across
+// batches, and walk the row major side in order so that it is streamed
+// rather than scattered while the tiled side stays within one row of tiles.
+// Disjoint ranges touch disjoint memory and can be converted concurrently.
+template <std::size_t ElementSize, typename Copy>
+inline void tilizeImpl(std::byte const *src, std::byte *dst,
+                       TiledShape const &shape, std::uint64_t begin,
+                       std::uint64_t end) {
+  std::uint32_t tileCols = shape.paddedCols / kTileWidth;
+  std::uint32_t tileRows = shape.paddedRows / kTileHeight;
+  std::uint64_t tileRowBytes =
+      std::uint64_t(tileCols) * kTileVolume * ElementSize;
+  if (shape.rows != shape.paddedRows or shape.cols != shape.paddedCols) {
+    std::memset(dst + begin * tileRowBytes, 0, (end - begin) * tileRowBytes);
+  }
+  for (std::uint64_t tileRow = begin; tileRow < end; ++tileRow) {
+    std::uint64_t b = tileRow / tileRows;
+    std::uint32_t rowBegin = (tileRow % tileRows) * kTileHeight;
+    std::uint32_t rowEnd = std::min(rowBegin + kTileHeight, shape.rows);
+    std::byte *batchDst = dst + b * tileRows * tileRowBytes;
+    std::byte const *rowSrc =
+        src + (b * shape.rows + rowBegin) * shape.cols * ElementSize;
+    for (std::uint32_t row = rowBegin; row < rowEnd; ++row) {
+      std::uint32_t col = 0;
+      for (; col + kFaceWidth <= shape.cols; col += kFaceWidth) {
+        Copy::copy(batchDst + getTiledOffset(tileCols, row, col) * ElementSize,
+                   rowSrc + col * ElementSize);
+      }
+      if (col < shape.cols) {
+        std::memcpy(batchDst +
+                        getTiledOffset(tileCols, row, col) * ElementSize,
+                    rowSrc + col * ElementSize,
+                    (shape.cols - col) * ElementSize);
+      }
+      rowSrc += shape.cols * ElementSize;
+    }
+  }
+}
+
+template <std::size_t ElementSize, typename Copy>
+inline void untilizeImpl(std::byte const *src, std::byte *dst,
+                         TiledShape const &shape, std::uint64_t begin,
+                         std::uint64_t end) {
+  std::uint32_t tileCols = shape.paddedCols / kTileWidth;
+  std::uint32_t tileRows = shape.paddedRows / kTileHeight;
+  std::uint64_t tileRowBytes =
+      std::uint64_t(tileCols) * kTileVolume * ElementSize;
+  for (std::uint64_t tileRow = begin; tileRow < end; ++tileRow) {
+    std::uint64_t b = tileRow / tileRows;
+    std::uint32_t rowBegin = (tileRow % tileRows) * kTileHeight;
+    std::uint32_t rowEnd = std::min(rowBegin + kTileHeight, shape.rows);
+    std::byte const *batchSrc = src + b * tileRows * tileRowBytes;
+    std::byte *rowDst =
+        dst + (b * shape.rows + rowBegin) * shape.cols * ElementSize;
+    for (std::uint32_t row = rowBegin; row < rowEnd; ++row) {
+      std::uint32_t col = 0;
+      for (; col + kFaceWidth <= shape.cols; col += kFaceWidth) {
+        Copy::copy(rowDst + col * ElementSize,
+                   batchSrc + getTiledOffset(tileCols, row, col) * ElementSize);
+      }
+      if (col < shape.cols) {
+        std::memcpy(rowDst + col * ElementSize,
+                    batchSrc + getTiledOffset(tileCols, row, col) * ElementSize,
+                    (shape.cols - col) * ElementSize);
+      }
+      rowDst += shape.cols * ElementSize;
+    }
+  }
+}
+
+using ConvertFn = void (*)(std::byte const *, std::byte *, TiledShape const &,
+                          std::uint64_t, std::uint64_t);
+
+template <std::size_t ElementSize> struct Converters {
+  ConvertFn tilize;
+  ConvertFn untilize;
+};
+
+#define TT_RUNTIME_CONVERTER(name, impl, copy)                                 \
+  template <std::size_t ElementSize>                                           \
+  void name(std::byte const *src, std::byte *dst, TiledShape const &shape,     \
+            std::uint64_t begin, std::uint64_t end) {                          \
+    impl<ElementSize, copy<ElementSize>>(src, dst, shape, begin, end);         \
+  }
+
+TT_RUNTIME_CONVERTER(tilizeScalar, tilizeImpl, ScalarCopy)
+TT_RUNTIME_CONVERTER(untilizeScalar, untilizeImpl, ScalarCopy)
+
+#if defined(__x86_64__)
+// The loops are flattened into these entry points so that the copies inline
+// into code compiled for the matching instruction set.
+#define TT_RUNTIME_SIMD_CONVERTER(name, impl, copy, isa)                       \
+  template <std::size_t ElementSize>                                           \
+  TT_RUNTIME_TARGET(isa)                                                       \
+  __attribute__((flatten)) void name(std::byte const *src, std::byte *dst,     \
+                                     TiledShape const &shape,                  \
+                                     std::uint64_t begin, std::uint64_t end) { \
+    impl<ElementSize, copy<ElementSize>>(src, dst, shape, begin, end);         \
+  }
+
+TT_RUNTIME_SIMD_CONVERTER(tilizeAVX2, tilizeImpl, AVX2Copy, "avx2")
+TT_RUNTIME_SIMD_CONVERTER(untilizeAVX2, untilizeImpl, AVX2Copy, "avx2")
+TT_RUNTIME_SIMD_CONVERTER(tilizeAVX512, tilizeImpl, AVX512Copy, "avx512f")
+TT_RUNTIME_SIMD_CONVERTER(untilizeAVX512, untilizeImpl, AVX512Copy, "avx512f")
+#undef TT_RUNTIME_SIMD_CONVERTER
+#endif
+#undef TT_RUNTIME_CONVERTER
+
+template <std::size_t ElementSize>
+Converters<ElementSize> getConverters(SimdLevel level) {
+  switch (level) {
+#if defined(__x86_64__)
+  case SimdLevel::AVX512:
+    return {tilizeAVX512<ElementSize>, untilizeAVX512<ElementSize>};
+  case SimdLevel::AVX2:
+    return {tilizeAVX2<ElementSize>, untilizeAVX2<ElementSize>};
+#endif
+  default:
+    return {tilizeScalar<ElementSize>, untilizeScalar<ElementSize>};
+  }
+}
+
+std::atomic<SimdLevel> &currentSimdLevel() {
+  static std::atomic<SimdLevel> level(getSupportedSimdLevel());
+  return level;
+}
+
+// Conversions below this size are not worth waking up other threads for.
+constexpr std::uint64_t kMinChunkBytes = 1 << 20;
+
+void convert(ConvertFn fn, std::byte const *src, std::byte *dst,
+             TiledShape const &shape, std::size_t elementSize) {
+  assert(shape.paddedRows % kTileHeight == 0 &&
+         shape.paddedCols % kTileWidth == 0 && "Padded shape not tile aligned");
+  assert(shape.rows <= shape.paddedRows && shape.cols <= shape.paddedCols &&
+         "Logical shape exceeds padded shape");
+  std::uint64_t tileRows = shape.batch * (shape.paddedRows / kTileHeight);
+  std::uint64_t tileRowBytes =
+      std::uint64_t(shape.paddedCols) * kTileHeight * elementSize;
+  std::uint64_t grain = std::max<std::uint64_t>(
+      kMinChunkBytes / std::max<std::uint64_t>(tileRowBytes, 1), 1);
+  if (tileRows <= grain) {
+    fn(src, dst, shape, 0, tileRows);
+    return;
+  }
+  getHostThreadPool()->parallelFor(
+      tileRows, grain, [&](std::size_t begin, std::size_t end) {
+        fn(src, dst, shape, begin, end);
+      });
+}
+
+template <std::size_t ElementSize>
+void tilize(void const *src, void *dst, TiledShape const &shape) {
+  convert(getConverters<ElementSize>(getSimdLevel()).tilize,
+          static_cast<std::byte const *>(src), static_cast<std::byte *>(dst),
+          shape, ElementSize);
+}
+
+template <std::size_t ElementSize>
+void untilize(void const *src, void *dst, TiledShape const &shape) {
+  convert(getConverters<ElementSize>(getSimdLevel()).untilize,
+          static_cast<std::byte const *>(src), static_cast<std::byte *>(dst),
+          shape, ElementSize);
+}
+} // namespace
+
+SimdLevel getSupportedSimdLevel() {
+#if defined(__x86_64__)
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+  return SimdLevel::Scalar;
+}
+
+SimdLevel getSimdLevel() { return currentSimdLevel().load(); }
+
+void setSimdLevel(SimdLevel level) {
+  currentSimdLevel().store(std::min(level, getSupportedSimdLevel()));
+}
+
+void tilize(float const *src, float *dst, TiledShape const &shape) {
+  tilize<sizeof(float)>(src, dst, shape);
+}
+
+void tilize(std::uint32_t const *src, std::uint32_t *dst,
+            TiledShape const &shape) {
+  tilize<sizeof(std::uint32_t)>(src, dst, shape);
+}
+
+void tilize(std::uint16_t const *src, std::uint16_t *dst,
+            TiledShape const &shape) {
+  tilize<sizeof(std::uint16_t)>(src, dst, shape);
+}
+
+void untilize(float const *src, float *dst, TiledShape const &shape) {
+  untilize<sizeof(float)>(src, dst, shape);
+}
+
+void untilize(std::uint32_t const *src, std::uint32_t *dst,
+              TiledShape const &shape) {
+  untilize<sizeof(std::uint32_t)>(src, dst, shape);
+}
+
+void untilize(std::uint16_t const *src, std::uint16_t *dst,
+              TiledShape const &shape) {
+  untilize<sizeof(std::uint16_t)>(src, dst, shape);
+}
+
+} // namespace tt::runtime::detail
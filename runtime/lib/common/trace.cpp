@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace tt::runtime {
+
+namespace detail {
+// The callback is swapped as a whole so that a program running while it is
+// replaced keeps calling the one it loaded.
+static std::mutex callbackMutex;
+static std::shared_ptr<OpTraceCallback> currentCallback;
+static std::atomic<bool> traceEnabled = false;
+
+bool isOpTraceEnabled() {
+  return traceEnabled.load(std::memory_order_relaxed);
+}
+
+void emitOpTrace(OpTraceEvent const &event) {
+  std::shared_ptr<OpTraceCallback> callback;
+  {
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    callback = currentCallback;
+  }
+  if (callback) {
+    (*callback)(event);
+  }
+}
+
+std::uint64_t getTraceTimestampNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::uint32_t getTraceThreadId() {
+  static std::atomic<std::uint32_t> nextId = 0;
+  thread_local std::uint32_t id = nextId++;
+  return id;
+}
+
+static void appendEscaped(std::string &out, std::string const &value) {
+  for (char c : value) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        out += escaped;
+      } else {
+        out += c;
+      }
+    }
+  }
+}
+
+static void appendMicros(std::string &out, std::uint64_t ns) {
+  out += std::to_string(ns / 1000);
+  out += '.';
+  std::string fraction = std::to_string(ns % 1000);
+  out.append(3 - fraction.size(), '0');
+  out += fraction;
+}
+} // namespace detail
+
+void setOpTraceCallback(OpTraceCallback callback) {
+  std::shared_ptr<OpTraceCallback> previous;
+  {
+    std::lock_guard<std::mutex> lock(detail::callbackMutex);
+    previous = std::move(detail::currentCallback);
+    if (callback) {
+      detail::currentCallback =
+          std::make_shared<OpTraceCallback>(std::move(callback));
+    }
+    detail::traceEnabled = static_cast<bool>(detail::currentCallback);
+  }
+  // Released outside of the lock, callbacks may own arbitrary state.
+  previous.reset();
+}
+
+std::string toChromeTrace(std::vector<OpTraceEvent> const &events) {
+  std::string out = "{\"traceEvents\":[";
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    OpTraceEvent const &event = events[i];
+    out += i ? ",\n" : "\n";
+    out += "{\"name\":\"";
+    detail::appendEscaped(out, event.opType);
+    out += "\",\"cat\":\"";
+    detail::appendEscaped(out, event.programName);
+    out += "\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+    out += std::to_string(event.threadId);
+    out += ",\"ts\":";
+    detail::appendMicros(out, event.startNs);
+    out += ",\"dur\":";
+    detail::appendMicros(out, event.endNs - event.startNs);
+    out += ",\"args\":{\"op_index\":";
+    out += std::to_string(event.opIndex);
+    out += ",\"debug_info\":\"";
+    detail::appendEscaped(out, event.debugInfo);
+    out += "\"}}";
+  }
+  out += "\n],\"displayTimeUnit\":\"ns\"}\n";
+  return out;
+}
+
+} // namespace tt::runtime
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/detail/worker.h"
+
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace tt::runtime::detail {
+
+void EventState::complete(std::exception_ptr error) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->error = error;
+    done = true;
+  }
+  cv.notify_all();
+}
+
+void EventState::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [this] { return done; });
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+bool EventState::poll() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return done;
+}
+
+Worker::Worker() {
+  for (auto &stream : streams) {
+    stream = std::make_unique<MpmcRing<Job>>(kStreamCapacity);
+  }
+  thread = std::thread([this] { run(); });
+}
+
+Worker::~Worker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  cv.notify_all();
+  thread.join();
+}
+
+bool Worker::hasWork() const {
+  for (auto const &stream : streams) {
+    if (not stream->empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Worker::wake() {
+  // Pairs with the worker publishing idle before it checks the streams, one
+  // of the two sides is guaranteed to see the other.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle.load(std::memory_order_seq_cst)) {
+    std::lock_guard<std::mutex> lock(mutex);
+    cv.notify_one();
+  }
+}
+
+std::shared_ptr<EventState> Worker::enqueue(std::function<void()> job,
+                                            std::uint32_t stream) {
+  if (stream >= kNumStreams) {
+    throw std::runtime_error("Stream index out of range");
+  }
+  auto event = std::make_shared<EventState>();
+  Job entry{std::move(job), event};
+  // A full stream pushes back on its submitters until the worker catches up.
+  while (not streams[stream]->tryPush(entry)) {
+    wake();
+    std::this_thread::yield();
+  }
+  wake();
+  return event;
+}
+
+void Worker::flush() {
+  std::vector<std::shared_ptr<EventState>> events;
+  for (std::uint32_t stream = 0; stream < kNumStreams; ++stream) {
+    events.push_back(enqueue([] {}, stream));
+  }
+  for (auto &event : events) {
+    event->wait();
+  }
+}
+
+void Worker::run() {
+  while (true) {
+    bool ran = false;
+    for (auto &stream : streams) {
+      Job job;
+      if (not stream->tryPop(job)) {
+        continue;
+      }
+      ran = true;
+      try {
+        job.fn();
+        job.event->complete();
+      } catch (...) {
+        job.event->complete(std::current_exception());
+      }
+    }
+    if (ran) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.store(true, std::memory_order_seq_cst);
+    cv.wait(lock, [this] { return stopping or hasWork(); });
+    idle.store(false, std::memory_order_relaxed);
+    // Pending jobs are still run on shutdown so no event is left hanging.
+    if (stopping and not hasWork()) {
+      return;
+    }
+  }
+}
+
+static std::shared_mutex workersMutex;
+
+static std::unordered_map<void const *, std::unique_ptr<Worker>> &
+getWorkers() {
+  static std::unordered_map<void const *, std::unique_ptr<Worker>> workers;
+  return workers;
+}
+
+Worker &getWorker(void const *device) {
+  {
+    std::shared_lock<std::shared_mutex> lock(workersMutex);
+    auto match = getWorkers().find(device);
+    if (match != getWorkers().end()) {
+      return *match->second;
+    }
+  }
+  std::lock_guard<std::shared_mutex> lock(workersMutex);
+  auto &worker = getWorkers()[device];
+  if (not worker) {
+    worker = std::make_unique<Worker>();
+  }
+  return *worker;
+}
+
+void releaseWorker(void const *device) {
+  std::unique_ptr<Worker> worker;
+  {
+    std::lock_guard<std::shared_mutex> lock(workersMutex);
+    auto match = getWorkers().find(device);
+    if (match == getWorkers().end()) {
+      return;
+    }
+    worker = std::move(match->second);
+    getWorkers().erase(match);
+  }
+  // Joining outside of the lock lets other devices keep submitting.
+  worker.reset();
+}
+
+} // namespace tt::runtime::detail
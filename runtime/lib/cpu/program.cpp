@@ -0,0 +1,471 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "tt/runtime/detail/cpu.h"
+#include "tt/runtime/detail/cpu_kernels.h"
+#include "tt/runtime/detail/thread_pool.h"
+#include "tt/runtime/detail/trace.h"
+#include "tt/runtime/runtime.h"
+
+#include "ttmlir/Target/TTNN/Target.h"
+
+namespace tt::runtime::cpu {
+
+using ::tt::runtime::detail::KernelShape;
+
+namespace {
+// Value of a tensor between steps. Steps never write to their inputs, so
+// layout changes share the buffer of their input.
+struct Buffer {
+  KernelShape shape;
+  std::vector<float> data;
+
+  explicit Buffer(KernelShape shape)
+      : shape(std::move(shape)),
+        data(::tt::runtime::detail::getVolume(this->shape)) {}
+};
+} // namespace
+
+struct ProgramContext {
+  std::vector<std::shared_ptr<Buffer const>> tensors;
+
+  explicit ProgramContext(std::uint32_t numSlots) : tensors(numSlots) {}
+
+  Buffer const &at(std::uint32_t slot) {
+    assert(tensors[slot] && "Tensor used before it was produced");
+    return *tensors[slot];
+  }
+};
+
+using StepFn = std::function<void(ProgramContext &)>;
+
+struct Step {
+  StepFn run;
+  // Slots whose last use is this step, never program inputs or outputs.
+  std::vector<std::uint32_t> release;
+  // Identify the step in traces.
+  std::uint32_t opIndex;
+  char const *opType;
+  std::string debugInfo;
+};
+
+struct ProgramExecutable {
+  std::string name;
+  std::uint32_t numSlots = 0;
+  std::vector<std::uint32_t> inputSlots;
+  std::vector<std::uint32_t> outputSlots;
+  std::vector<Step> steps;
+};
+
+namespace {
+// Assigns dense slots to tensor global ids, only used while preparing.
+class SlotMap {
+public:
+  std::uint32_t get(::tt::target::TensorRef const *ref) {
+    auto [iter, inserted] = slots.try_emplace(ref->global_id(), slots.size());
+    return iter->second;
+  }
+
+  std::uint32_t size() const { return slots.size(); }
+
+private:
+  std::unordered_map<std::uint32_t, std::uint32_t> slots;
+};
+} // namespace
+
+static bool isContiguous(HostTensor const &tensor) {
+  std::uint64_t expected = 1;
+  for (std::size_t i = tensor.shape.size(); i-- > 0;) {
+    if (tensor.shape[i] != 1 and tensor.stride[i] != expected) {
+      return false;
+    }
+    expected *= tensor.shape[i];
+  }
+  return true;
+}
+
+// Visits the element offsets of a strided tensor in row major order.
+template <typename Fn>
+static void forEachOffset(HostTensor const &tensor, Fn &&fn) {
+  std::size_t rank = tensor.shape.size();
+  std::uint64_t volume = ::tt::runtime::detail::getVolume(tensor.shape);
+  std::vector<std::uint32_t> coords(rank, 0);
+  for (std::uint64_t i = 0; i < volume; ++i) {
+    std::uint64_t offset = 0;
+    for (std::size_t dim = 0; dim < rank; ++dim) {
+      offset += std::uint64_t(coords[dim]) * tensor.stride[dim];
+    }
+    fn(i, offset);
+    for (std::size_t dim = rank; dim-- > 0;) {
+      if (++coords[dim] < tensor.shape[dim]) {
+        break;
+      }
+      coords[dim] = 0;
+    }
+  }
+}
+
+static void toFloat(void const *src, float *dst, std::uint64_t size,
+                    ::tt::target::DataType dataType) {
+  switch (dataType) {
+  case ::tt::target::DataType::Float32:
+    std::memcpy(dst, src, size * sizeof(float));
+    return;
+  case ::tt::target::DataType::BFloat16:
+    return ::tt::runtime::detail::bf16ToFloat(
+        static_cast<std::uint16_t const *>(src), dst, size);
+  case ::tt::target::DataType::UInt32:
+    std::copy_n(static_cast<std::uint32_t const *>(src), size, dst);
+    return;
+  case ::tt::target::DataType::UInt16:
+    std::copy_n(static_cast<std::uint16_t const *>(src), size, dst);
+    return;
+  default:
+    throw std::runtime_error("Unsupported data type");
+  }
+}
+
+template <typename T>
+static void toInteger(float const *src, T *dst, std::uint64_t size) {
+  for (std::uint64_t i = 0; i < size; ++i) {
+    dst[i] = static_cast<T>(std::max(src[i], 0.0f));
+  }
+}
+
+static void fromFloat(float const *src, void *dst, std::uint64_t size,
+                      ::tt::target::DataType dataType) {
+  switch (dataType) {
+  case ::tt::target::DataType::Float32:
+    std::memcpy(dst, src, size * sizeof(float));
+    return;
+  case ::tt::target::DataType::BFloat16:
+    return ::tt::runtime::detail::floatToBf16(
+        src, static_cast<std::uint16_t *>(dst), size);
+  case ::tt::target::DataType::UInt32:
+    return toInteger(src, static_cast<std::uint32_t *>(dst), size);
+  case ::tt::target::DataType::UInt16:
+    return toInteger(src, static_cast<std::uint16_t *>(dst), size);
+  default:
+    throw std::runtime_error("Unsupported data type");
+  }
+}
+
+static std::shared_ptr<Buffer const> load(HostTensor const &tensor) {
+  auto buffer = std::make_shared<Buffer>(tensor.shape);
+  if (isContiguous(tensor)) {
+    toFloat(tensor.data, buffer->data.data(), buffer->data.size(),
+            tensor.dataType);
+    return buffer;
+  }
+  std::vector<std::byte> dense(buffer->data.size() * tensor.itemsize);
+  auto const *src = static_cast<std::byte const *>(tensor.data);
+  forEachOffset(tensor, [&](std::uint64_t index, std::uint64_t offset) {
+    std::memcpy(&dense[index * tensor.itemsize],
+                src + offset * tensor.itemsize, tensor.itemsize);
+  });
+  toFloat(dense.data(), buffer->data.data(), buffer->data.size(),
+          tensor.dataType);
+  return buffer;
+}
+
+static void store(Buffer const &buffer, HostTensor &tensor) {
+  if (buffer.data.size() != ::tt::runtime::detail::getVolume(tensor.shape)) {
+    throw std::runtime_error("Output tensor does not match program output");
+  }
+  if (isContiguous(tensor)) {
+    fromFloat(buffer.data.data(), tensor.data, buffer.data.size(),
+              tensor.dataType);
+    return;
+  }
+  std::vector<std::byte> dense(buffer.data.size() * tensor.itemsize);
+  fromFloat(buffer.data.data(), dense.data(), buffer.data.size(),
+            tensor.dataType);
+  auto *dst = static_cast<std::byte *>(tensor.data);
+  forEachOffset(tensor, [&](std::uint64_t index, std::uint64_t offset) {
+    std::memcpy(dst + offset * tensor.itemsize,
+                &dense[index * tensor.itemsize], tensor.itemsize);
+  });
+}
+
+static KernelShape getShape(::tt::target::TensorRef const *ref) {
+  auto const *shape = ref->desc()->shape();
+  return KernelShape(shape->begin(), shape->end());
+}
+
+static StepFn prepare(::tt::target::ttnn::ToMemoryConfigOp const *op,
+                      SlotMap &slots) {
+  std::uint32_t in = slots.get(op->in0());
+  std::uint32_t out = slots.get(op->out());
+  // Host and device tensors share the same representation here.
+  return [in, out](ProgramContext &ctx) {
+    ctx.tensors[out] = ctx.tensors[in];
+  };
+}
+
+static StepFn prepare(::tt::target::ttnn::FullOp const *op, SlotMap &slots) {
+  std::uint32_t out = slots.get(op->out());
+  KernelShape shape = getShape(op->out());
+  float fillValue = op->fill_value();
+  return [out, shape, fillValue](ProgramContext &ctx) {
+    auto result = std::make_shared<Buffer>(shape);
+    std::fill(result->data.begin(), result->data.end(), fillValue);
+    ctx.tensors[out] = std::move(result);
+  };
+}
+
+static StepFn prepareBinary(std::vector<std::uint32_t> const &ins,
+                            std::uint32_t out,
+                            ::tt::runtime::detail::BinaryKernel kind) {
+  if (ins.size() != 2) {
+    throw std::runtime_error("Unsupported number of inputs");
+  }
+  return [lhs = ins[0], rhs = ins[1], out, kind](ProgramContext &ctx) {
+    Buffer const &a = ctx.at(lhs);
+    Buffer const &b = ctx.at(rhs);
+    auto result = std::make_shared<Buffer>(
+        ::tt::runtime::detail::broadcastShapes(a.shape, b.shape));
+    ::tt::runtime::detail::binary(kind, a.data.data(), a.shape, b.data.data(),
+                                  b.shape, result->data.data(),
+                                  result->shape);
+    ctx.tensors[out] = std::move(result);
+  };
+}
+
+static StepFn prepare(::tt::target::ttnn::EltwiseOp const *op,
+                      SlotMap &slots) {
+  std::vector<std::uint32_t> ins;
+  for (::tt::target::TensorRef const *in : *op->ins()) {
+    ins.push_back(slots.get(in));
+  }
+  std::uint32_t out = slots.get(op->out());
+  switch (op->type()) {
+  /* Eltwise Binary */
+  case ::tt::target::ttnn::EltwiseOpType::Add:
+    return prepareBinary(ins, out, ::tt::runtime::detail::BinaryKernel::Add);
+  case ::tt::target::ttnn::EltwiseOpType::Multiply:
+    return prepareBinary(ins, out,
+                         ::tt::runtime::detail::BinaryKernel::Multiply);
+  case ::tt::target::ttnn::EltwiseOpType::Subtract:
+    return prepareBinary(ins, out,
+                         ::tt::runtime::detail::BinaryKernel::Subtract);
+  case ::tt::target::ttnn::EltwiseOpType::GreaterEqual:
+    return prepareBinary(ins, out,
+                         ::tt::runtime::detail::BinaryKernel::GreaterEqual);
+  /* Eltwise Unary */
+  case ::tt::target::ttnn::EltwiseOpType::Relu: {
+    if (ins.size() != 1) {
+      throw std::runtime_error("Unsupported number of inputs");
+    }
+    return [in = ins[0], out](ProgramContext &ctx) {
+      Buffer const &input = ctx.at(in);
+      auto result = std::make_shared<Buffer>(input.shape);
+      ::tt::runtime::detail::unary(::tt::runtime::detail::UnaryKernel::Relu,
+                                   input.data.data(), result->data.data(),
+                                   result->data.size());
+      ctx.tensors[out] = std::move(result);
+    };
+  }
+  }
+  throw std::runtime_error("Unsupported eltwise operation type");
+}
+
+static StepFn prepare(::tt::target::ttnn::ReductionOp const *op,
+                      SlotMap &slots) {
+  std::uint32_t in = slots.get(op->in());
+  std::uint32_t out = slots.get(op->out());
+  switch (op->type()) {
+  case ::tt::target::ttnn::ReductionOpType::Sum: {
+    std::vector<std::int32_t> dims;
+    if (op->dim_arg()) {
+      dims.assign(op->dim_arg()->begin(), op->dim_arg()->end());
+    }
+    bool keepDim = op->keep_dim();
+    return [in, out, dims, keepDim](ProgramContext &ctx) {
+      Buffer const &input = ctx.at(in);
+      std::size_t rank = input.shape.size();
+      std::vector<bool> reduced(rank, dims.empty());
+      for (std::int32_t dim : dims) {
+        reduced[dim < 0 ? dim + rank : dim] = true;
+      }
+      KernelShape shape;
+      for (std::size_t dim = 0; dim < rank; ++dim) {
+        if (not reduced[dim]) {
+          shape.push_back(input.shape[dim]);
+        } else if (keepDim) {
+          shape.push_back(1);
+        }
+      }
+      auto result = std::make_shared<Buffer>(shape);
+      ::tt::runtime::detail::sum(input.data.data(), input.shape, dims,
+                                 result->data.data());
+      ctx.tensors[out] = std::move(result);
+    };
+  }
+  }
+  throw std::runtime_error("Unsupported reduction operation type");
+}
+
+static StepFn prepare(::tt::target::ttnn::SoftmaxOp const *op,
+                      SlotMap &slots) {
+  std::uint32_t in = slots.get(op->in());
+  std::uint32_t out = slots.get(op->out());
+  int32_t dimension = op->dimension();
+  return [in, out, dimension](ProgramContext &ctx) {
+    Buffer const &input = ctx.at(in);
+    auto result = std::make_shared<Buffer>(input.shape);
+    ::tt::runtime::detail::softmax(input.data.data(), input.shape, dimension,
+                                   result->data.data());
+    ctx.tensors[out] = std::move(result);
+  };
+}
+
+static StepFn prepare(::tt::target::ttnn::MatmulOp const *op,
+                      SlotMap &slots) {
+  std::uint32_t lhs = slots.get(op->in0());
+  std::uint32_t rhs = slots.get(op->in1());
+  std::optional<std::uint32_t> bias = std::nullopt;
+  if (op->bias()) {
+    bias = slots.get(op->bias());
+  }
+  std::uint32_t out = slots.get(op->out());
+  ::tt::target::ttnn::MatmulActivation activation = op->activation();
+  return [lhs, rhs, bias, out, activation](ProgramContext &ctx) {
+    Buffer const &a = ctx.at(lhs);
+    Buffer const &b = ctx.at(rhs);
+    auto result = std::make_shared<Buffer>(
+        ::tt::runtime::detail::getMatmulShape(a.shape, b.shape));
+    float *data = result->data.data();
+    ::tt::runtime::detail::matmul(a.data.data(), a.shape, b.data.data(),
+                                  b.shape, data);
+    if (bias) {
+      Buffer const &c = ctx.at(*bias);
+      ::tt::runtime::detail::binary(::tt::runtime::detail::BinaryKernel::Add,
+                                    data, result->shape, c.data.data(),
+                                    c.shape, data, result->shape);
+    }
+    switch (activation) {
+    case ::tt::target::ttnn::MatmulActivation::None:
+      break;
+    case ::tt::target::ttnn::MatmulActivation::Relu:
+      ::tt::runtime::detail::unary(::tt::runtime::detail::UnaryKernel::Relu,
+                                   data, data, result->data.size());
+      break;
+    }
+    ctx.tensors[out] = std::move(result);
+  };
+}
+
+static std::optional<StepFn>
+prepare(::tt::target::ttnn::Operation const *op, SlotMap &slots) {
+  switch (op->type_type()) {
+  case ::tt::target::ttnn::OpType::OpenDeviceOp:
+  case ::tt::target::ttnn::OpType::CloseDeviceOp:
+    return std::nullopt;
+  case ::tt::target::ttnn::OpType::ToMemoryConfigOp:
+    return prepare(op->type_as_ToMemoryConfigOp(), slots);
+  case ::tt::target::ttnn::OpType::FullOp:
+    return prepare(op->type_as_FullOp(), slots);
+  case ::tt::target::ttnn::OpType::EltwiseOp:
+    return prepare(op->type_as_EltwiseOp(), slots);
+  case ::tt::target::ttnn::OpType::MatmulOp:
+    return prepare(op->type_as_MatmulOp(), slots);
+  case ::tt::target::ttnn::OpType::ReductionOp:
+    return prepare(op->type_as_ReductionOp(), slots);
+  case ::tt::target::ttnn::OpType::SoftmaxOp:
+    return prepare(op->type_as_SoftmaxOp(), slots);
+  default:
+    throw std::runtime_error("Unsupported operation type");
+  }
+}
+
+std::shared_ptr<ProgramExecutable>
+prepareProgram(::tt::target::ttnn::Program const *program) {
+  auto executable = std::make_shared<ProgramExecutable>();
+  SlotMap slots;
+
+  for (::tt::target::TensorRef const *input : *program->inputs()) {
+    executable->inputSlots.push_back(slots.get(input));
+  }
+  for (::tt::target::TensorRef const *output : *program->outputs()) {
+    executable->outputSlots.push_back(slots.get(output));
+  }
+
+  std::size_t numPinned = slots.size();
+  executable->name = program->name() ? program->name()->str() : "";
+  for (std::uint32_t opIndex = 0; opIndex < program->operations()->size();
+       ++opIndex) {
+    ::tt::target::ttnn::Operation const *op =
+        program->operations()->Get(opIndex);
+    std::optional<StepFn> run = prepare(op, slots);
+    if (run) {
+      executable->steps.push_back(
+          Step{std::move(*run), {}, opIndex,
+               ::tt::target::ttnn::EnumNameOpType(op->type_type()),
+               op->debug_info() ? op->debug_info()->str() : ""});
+    }
+    if (not op->release() or executable->steps.empty()) {
+      continue;
+    }
+    for (::tt::target::TensorRef const *ref : *op->release()) {
+      std::uint32_t slot = slots.get(ref);
+      if (slot >= numPinned) {
+        executable->steps.back().release.push_back(slot);
+      }
+    }
+  }
+
+  executable->numSlots = slots.size();
+  return executable;
+}
+
+void runProgram(ProgramExecutable const &executable,
+                std::vector<HostTensor *> const &inputs,
+                std::vector<HostTensor *> const &outputs) {
+  if (executable.inputSlots.size() != inputs.size() or
+      executable.outputSlots.size() != outputs.size()) {
+    throw std::runtime_error(
+        "Mismatch between program and supplied input or output tensors");
+  }
+  ProgramContext ctx(executable.numSlots);
+  ::tt::runtime::detail::getHostThreadPool()->parallelFor(
+      inputs.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          ctx.tensors[executable.inputSlots[i]] = load(*inputs[i]);
+        }
+      });
+
+  bool trace = ::tt::runtime::detail::isOpTraceEnabled();
+  for (Step const &step : executable.steps) {
+    if (trace) {
+      OpTraceEvent event;
+      event.startNs = ::tt::runtime::detail::getTraceTimestampNs();
+      step.run(ctx);
+      event.endNs = ::tt::runtime::detail::getTraceTimestampNs();
+      event.programName = executable.name;
+      event.opIndex = step.opIndex;
+      event.opType = step.opType;
+      event.debugInfo = step.debugInfo;
+      event.threadId = ::tt::runtime::detail::getTraceThreadId();
+      ::tt::runtime::detail::emitOpTrace(event);
+    } else {
+      step.run(ctx);
+    }
+    for (std::uint32_t slot : step.release) {
+      ctx.tensors[slot].reset();
+    }
+  }
+
+  for (std::size_t i = 0; i < outputs.size(); ++i) {
+    store(ctx.at(executable.outputSlots[i]), *outputs[i]);
+  }
+}
+} // namespace tt::runtime::cpu
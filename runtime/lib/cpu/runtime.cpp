@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+
+#include "tt/runtime/detail/cpu.h"
+#include "tt/runtime/detail/worker.h"
+#include "tt/runtime/runtime.h"
+#include "tt/runtime/utils.h"
+
+#include "ttmlir/Target/TTNN/Target.h"
+#include "ttmlir/Version.h"
+
+namespace tt::runtime::cpu {
+
+namespace {
+// Nothing to initialize, the handle only gives the device an identity for
+// its worker.
+struct CpuDevice {
+  int deviceId;
+};
+} // namespace
+
+static std::shared_ptr<void> createSystemDesc() {
+  ::flatbuffers::FlatBufferBuilder fbb;
+  ::ttmlir::Version ttmlirVersion = ::ttmlir::getVersion();
+  ::tt::target::Version version(ttmlirVersion.major, ttmlirVersion.minor,
+                                ttmlirVersion.patch);
+  ::tt::target::Dim2d deviceGrid(8, 8);
+  std::vector<::flatbuffers::Offset<tt::target::ChipDesc>> chipDescs = {
+      ::tt::target::CreateChipDesc(fbb, ::tt::target::Arch::Wormhole_b0,
+                                   &deviceGrid, (1 << 20), 12, (1 << 20), 16,
+                                   32, 32),
+  };
+  std::vector<uint32_t> chipDescIndices = {
+      0,
+  };
+  std::vector<::tt::target::ChipCapability> chipCapabilities = {
+      ::tt::target::ChipCapability::PCIE |
+          ::tt::target::ChipCapability::HostMMIO,
+  };
+  std::vector<::tt::target::ChipCoord> chipCoord = {
+      ::tt::target::ChipCoord(0, 0, 0, 0),
+  };
+  std::vector<::tt::target::ChipChannel> chipChannel;
+  auto systemDesc = ::tt::target::CreateSystemDescDirect(
+      fbb, &chipDescs, &chipDescIndices, &chipCapabilities, &chipCoord,
+      &chipChannel);
+  auto root = ::tt::target::CreateSystemDescRootDirect(
+      fbb, &version, ::ttmlir::getGitHash(), "cpu", systemDesc);
+  ::tt::target::FinishSizePrefixedSystemDescRootBuffer(fbb, root);
+  auto handle = utils::malloc_shared(fbb.GetSize());
+  std::memcpy(handle.get(), fbb.GetBufferPointer(), fbb.GetSize());
+  return handle;
+}
+
+std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc() {
+  static std::shared_ptr<void> handle = createSystemDesc();
+  return std::make_pair(SystemDesc(handle), DeviceIds{0});
+}
+
+Tensor createTensor(std::shared_ptr<void> data,
+                    std::vector<std::uint32_t> const &shape,
+                    std::vector<std::uint32_t> const &stride,
+                    std::uint32_t itemsize, ::tt::target::DataType dataType) {
+  if (shape.size() != stride.size()) {
+    throw std::runtime_error("Tensor shape and stride ranks differ");
+  }
+  auto tensor = std::make_shared<HostTensor>(
+      HostTensor{data.get(), shape, stride, itemsize, dataType});
+  return Tensor(tensor, data);
+}
+
+Device openDevice(std::vector<int> deviceIds) {
+  if (deviceIds.size() != 1 or deviceIds.front() != 0) {
+    throw std::runtime_error("The CPU runtime only provides device 0");
+  }
+  return Device(std::make_shared<CpuDevice>(CpuDevice{deviceIds.front()}));
+}
+
+void closeDevice(Device device) {
+  ::tt::runtime::detail::releaseWorker(device.handle.get());
+}
+
+static ::tt::target::ttnn::TTNNBinary const *getBinary(Flatbuffer binary) {
+  bool isTTNN = ::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(
+      binary.handle.get());
+  if (not isTTNN) {
+    throw std::runtime_error("Unsupported binary format");
+  }
+  return ::tt::target::ttnn::GetSizePrefixedTTNNBinary(binary.handle.get());
+}
+
+Event submit(Device deviceHandle, Binary executableHandle,
+             std::uint32_t programIndex,
+             std::vector<Tensor> const &inputHandles,
+             std::vector<Tensor> const &outputHandles, std::uint32_t stream) {
+  ::tt::target::ttnn::TTNNBinary const &fbb = *getBinary(executableHandle);
+  if (programIndex >= fbb.programs()->size()) {
+    throw std::runtime_error("Program index out of range");
+  }
+  std::shared_ptr<ProgramExecutable> executable =
+      executableHandle.programCache->getOrCreate<ProgramExecutable>(
+          programIndex, [&fbb, programIndex] {
+            return prepareProgram(fbb.programs()->Get(programIndex));
+          });
+  // The job holds on to the handles so the binary and the tensor storage
+  // outlive the submission even if the caller drops its copies.
+  auto job = [executable, executableHandle, inputHandles, outputHandles] {
+    std::vector<HostTensor *> inputs;
+    inputs.reserve(inputHandles.size());
+    for (auto &input : inputHandles) {
+      inputs.push_back(static_cast<HostTensor *>(input.handle.get()));
+    }
+    std::vector<HostTensor *> outputs;
+    outputs.reserve(outputHandles.size());
+    for (auto &output : outputHandles) {
+      outputs.push_back(static_cast<HostTensor *>(output.handle.get()));
+    }
+    runProgram(*executable, inputs, outputs);
+  };
+  return Event(::tt::runtime::detail::getWorker(deviceHandle.handle.get())
+                   .enqueue(job, stream));
+}
+
+} // namespace tt::runtime::cpu
@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tt/runtime/perf.h"
+#include "tt/runtime/detail/perf_model.h"
+#include "tt/runtime/types.h"
+#include "ttmlir/Target/TTMetal/Target.h"
+
+#include <stdexcept>
+
+namespace tt::runtime {
+
+namespace target = ::tt::target;
+
+using detail::PerfBuffer;
+using detail::PerfChip;
+using detail::PerfCore;
+using detail::PerfDispatch;
+using detail::PerfKernel;
+using detail::PerfMemory;
+
+static target::metal::TTMetalBinary const *getBinary(Binary const &executable) {
+  if (not target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
+          executable.handle.get())) {
+    throw std::runtime_error("Performance estimates need a TTMetal binary");
+  }
+  return target::metal::GetSizePrefixedTTMetalBinary(executable.handle.get());
+}
+
+// Architecture constants, the defaults of PerfChip are Wormhole.
+static void setArchParams(target::Arch arch, PerfChip &chip) {
+  switch (arch) {
+  case target::Arch::Grayskull:
+    chip.clockGHz = 1.2;
+    chip.dramBytesPerNsPerChannel = 14.0;
+    break;
+  case target::Arch::Wormhole_b0:
+    break;
+  case target::Arch::Blackhole:
+    chip.clockGHz = 1.35;
+    chip.pcieBytesPerNs = 32.0;
+    chip.dramBytesPerNsPerChannel = 64.0;
+    break;
+  }
+}
+
+// Programs are compiled for a single chip, the first one of the system.
+static PerfChip getChip(target::SystemDesc const *systemDesc) {
+  PerfChip chip;
+  if (not systemDesc or not systemDesc->chip_descs() or
+      systemDesc->chip_descs()->size() == 0) {
+    return chip;
+  }
+  std::uint32_t index = 0;
+  if (systemDesc->chip_desc_indices() and
+      systemDesc->chip_desc_indices()->size() > 0) {
+    index = systemDesc->chip_desc_indices()->Get(0);
+  }
+  if (index >= systemDesc->chip_descs()->size()) {
+    throw std::runtime_error("Chip descriptor index out of range");
+  }
+  target::ChipDesc const *chipDesc = systemDesc->chip_descs()->Get(index);
+  setArchParams(chipDesc->arch(), chip);
+  if (chipDesc->grid_size()) {
+    chip.gridY = chipDesc->grid_size()->y();
+    chip.gridX = chipDesc->grid_size()->x();
+  }
+  chip.l1Size = chipDesc->l1_size();
+  chip.numDramChannels = chipDesc->num_dram_channels();
+  chip.pcieAlign = chipDesc->pcie_address_align_bytes();
+  chip.nocL1Align = chipDesc->noc_l1_address_align_bytes();
+  chip.nocDramAlign = chipDesc->noc_dram_address_align_bytes();
+  return chip;
+}
+
+static PerfMemory toPerfMemory(target::MemorySpace memorySpace) {
+  switch (memorySpace) {
+  case target::MemorySpace::System:
+  case target::MemorySpace::SystemMMIO:
+    return PerfMemory::Host;
+  case target::MemorySpace::DeviceDRAM:
+    return PerfMemory::DRAM;
+  case target::MemorySpace::DeviceL1:
+    return PerfMemory::L1;
+  }
+  throw std::runtime_error("Unsupported memory space");
+}
+
+// Bytes per element, block float formats counted with their shared
+// exponents amortized over the block.
+static double getElementBytes(target::DataType dataType) {
+  switch (dataType) {
+  case target::DataType::BFP_Float8:
+  case target::DataType::BFP_BFloat8:
+    return 1.0 + 1.0 / 16;
+  case target::DataType::BFP_Float4:
+  case target::DataType::BFP_BFloat4:
+    return 0.5 + 1.0 / 16;
+  case target::DataType::BFP_Float2:
+  case target::DataType::BFP_BFloat2:
+    return 0.25 + 1.0 / 16;
+  default:
+    return utils::dataTypeElementSize(dataType);
+  }
+}
+
+// The memory desc holds the shard of a single core, in tiles for tiled
+// layouts, which is replicated over the grid of the layout.
+static PerfBuffer getBuffer(target::TensorRef const *ref) {
+  target::LayoutDesc const *layout = ref->desc()->layout();
+  target::MemoryDesc const *memoryDesc = layout->memory_desc();
+  std::uint64_t shardVolume = 1;
+  for (std::int32_t dim : *memoryDesc->shape()) {
+    shardVolume *= dim;
+  }
+  std::uint64_t numShards = 1;
+  if (layout->grid()) {
+    numShards = std::uint64_t(layout->grid()->size().y()) *
+                layout->grid()->size().x();
+  }
+  std::uint64_t tileVolume = 1;
+  std::uint64_t tilesPerShard = 0;
+  target::Dim2d const *tileShape = memoryDesc->tile_shape();
+  if (tileShape and tileShape->y() > 0 and tileShape->x() > 0) {
+    tileVolume = std::uint64_t(tileShape->y()) * tileShape->x();
+    tilesPerShard = shardVolume;
+  } else {
+    constexpr std::uint64_t kTileVolume = 32 * 32;
+    tilesPerShard = (shardVolume + kTileVolume - 1) / kTileVolume;
+  }
+
+  PerfBuffer buffer;
+  buffer.memory = toPerfMemory(memoryDesc->memory_space());
+  buffer.bytes = std::uint64_t(shardVolume * tileVolume *
+                               getElementBytes(memoryDesc->data_type())) *
+                 numShards;
+  buffer.tiles = tilesPerShard * numShards;
+  return buffer;
+}
+
+// The device end of a host transfer determines where the data lands. It is
+// looked up on both ends rather than inferred from the command type, so
+// writes encoded as reads are still costed correctly.
+static PerfBuffer getDeviceSide(target::TensorRef const *src,
+                                target::TensorRef const *dst) {
+  PerfBuffer buffer = getBuffer(src);
+  return buffer.memory == PerfMemory::Host ? getBuffer(dst) : buffer;
+}
+
+static PerfCore toPerfCore(target::metal::KernelDesc const *kernel) {
+  if (auto const *source = kernel->kernel_as_KernelSource()) {
+    switch (source->source_type()) {
+    case target::metal::SourceType::Noc0:
+      return PerfCore::Noc0;
+    case target::metal::SourceType::Noc1:
+      return PerfCore::Noc1;
+    case target::metal::SourceType::Tensix:
+      return PerfCore::Compute;
+    case target::metal::SourceType::Ethernet:
+      return PerfCore::Ethernet;
+    }
+  }
+  if (auto const *binary = kernel->kernel_as_KernelBinary()) {
+    switch (binary->core_type()) {
+    case target::metal::BinaryType::BRISC:
+      return PerfCore::Noc0;
+    case target::metal::BinaryType::NCRISC:
+      return PerfCore::Noc1;
+    case target::metal::BinaryType::TRISC0:
+    case target::metal::BinaryType::TRISC1:
+    case target::metal::BinaryType::TRISC2:
+      return PerfCore::Compute;
+    case target::metal::BinaryType::ERISC:
+      return PerfCore::Ethernet;
+    }
+  }
+  throw std::runtime_error("Unsupported kernel type");
+}
+
+static PerfDispatch getDispatch(target::metal::DispatchCommand const *command) {
+  PerfDispatch dispatch;
+  for (target::TensorRef const *operand : *command->operands()) {
+    dispatch.operands.push_back(getBuffer(operand));
+  }
+  for (target::metal::DispatchProgram const *program : *command->programs()) {
+    for (target::metal::KernelDesc const *kernelDesc : *program->kernels()) {
+      target::Dim2dRange const *coreRange = kernelDesc->core_range();
+      PerfKernel kernel;
+      kernel.core = toPerfCore(kernelDesc);
+      kernel.y = coreRange->loc().y();
+      kernel.x = coreRange->loc().x();
+      kernel.height = coreRange->size().y();
+      kernel.width = coreRange->size().x();
+      dispatch.kernels.push_back(kernel);
+    }
+  }
+  return dispatch;
+}
+
+static CommandPerf estimateCommand(PerfChip const &chip,
+                                   target::metal::Command const *command) {
+  CommandPerf perf;
+  perf.type = target::metal::EnumNameCommandType(command->type_type());
+  if (command->debug_info()) {
+    perf.debugInfo = command->debug_info()->str();
+  }
+  switch (command->type_type()) {
+  case target::metal::CommandType::dispatch:
+    perf.estimate = detail::estimateDispatch(
+        chip, getDispatch(command->type_as_dispatch()));
+    break;
+  case target::metal::CommandType::host_write:
+    perf.estimate = detail::estimateHostTransfer(
+        chip, getDeviceSide(command->type_as_host_write()->src(),
+                            command->type_as_host_write()->dst()));
+    break;
+  case target::metal::CommandType::host_read:
+    perf.estimate = detail::estimateHostTransfer(
+        chip, getDeviceSide(command->type_as_host_read()->src(),
+                            command->type_as_host_read()->dst()));
+    break;
+  case target::metal::CommandType::host_alloc:
+  case target::metal::CommandType::host_dealloc:
+    perf.estimate = detail::estimateHostCommand(chip);
+    break;
+  case target::metal::CommandType::finish:
+    perf.estimate = detail::estimateFinish(chip);
+    break;
+  case target::metal::CommandType::NONE:
+    throw std::runtime_error("Command without a type");
+  }
+  return perf;
+}
+
+static void accumulate(PerfEstimate &total, PerfEstimate const &estimate) {
+  total.latencyNs += estimate.latencyNs;
+  total.overheadNs += estimate.overheadNs;
+  total.pcieNs += estimate.pcieNs;
+  total.dramNs += estimate.dramNs;
+  total.nocNs += estimate.nocNs;
+  total.computeNs += estimate.computeNs;
+}
+
+std::vector<CommandQueuePerf> estimatePerf(Binary executable) {
+  target::metal::TTMetalBinary const *binary = getBinary(executable);
+  PerfChip chip = getChip(binary->system_desc());
+  std::vector<CommandQueuePerf> queues;
+  for (target::metal::CommandQueue const *queue : *binary->command_queues()) {
+    CommandQueuePerf queuePerf;
+    queuePerf.name = queue->name() ? queue->name()->str() : std::string();
+    for (target::metal::Command const *command : *queue->commands()) {
+      queuePerf.commands.push_back(estimateCommand(chip, command));
+      accumulate(queuePerf.total, queuePerf.commands.back().estimate);
+    }
+    queues.push_back(std::move(queuePerf));
+  }
+  return queues;
+}
+
+} // namespace tt::runtime
@@ -3,6 +3,12 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "tt/runtime/runtime.h"
+#include "tt/runtime/detail/binary_registry.h"
+#include "tt/runtime/detail/capture.h"
+#include "tt/runtime/detail/host_arena.h"
+#include "tt/runtime/detail/thread_pool.h"
+#include "tt/runtime/detail/trace.h"
+#include "tt/runtime/detail/worker.h"
 #include "tt/runtime/utils.h"
 #include "ttmlir/Version.h"
 
@@ -12,55 +18,505 @@
 #include "tt/runtime/detail/ttmetal.h"
 #endif
 
+#if defined(TT_RUNTIME_ENABLE_CPU)
+#include "tt/runtime/detail/cpu.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
 namespace tt::runtime {
+
+std::vector<DeviceRuntime> getAvailableRuntimes() {
+  std::vector<DeviceRuntime> runtimes;
+#if defined(TT_RUNTIME_ENABLE_TTNN)
+  runtimes.push_back(DeviceRuntime::TTNN);
+#endif
+#if defined(TT_RUNTIME_ENABLE_CPU)
+  runtimes.push_back(DeviceRuntime::CPU);
+#endif
+  return runtimes;
+}
+
+static bool isAvailable(DeviceRuntime runtime) {
+  std::vector<DeviceRuntime> runtimes = getAvailableRuntimes();
+  return std::find(runtimes.begin(), runtimes.end(), runtime) !=
+         runtimes.end();
+}
+
+static DeviceRuntime getDefaultRuntime() {
+  if (char const *name = std::getenv("TT_RUNTIME_BACKEND")) {
+    DeviceRuntime runtime;
+    if (std::string(name) == "ttnn") {
+      runtime = DeviceRuntime::TTNN;
+    } else if (std::string(name) == "cpu") {
+      runtime = DeviceRuntime::CPU;
+    } else {
+      throw std::runtime_error("Unknown TT_RUNTIME_BACKEND: " +
+                               std::string(name));
+    }
+    if (not isAvailable(runtime)) {
+      throw std::runtime_error("TT_RUNTIME_BACKEND " + std::string(name) +
+                               " is not enabled in this build");
+    }
+    return runtime;
+  }
+  std::vector<DeviceRuntime> runtimes = getAvailableRuntimes();
+  return runtimes.empty() ? DeviceRuntime::Disabled : runtimes.front();
+}
+
+static std::atomic<DeviceRuntime> &currentRuntime() {
+  static std::atomic<DeviceRuntime> runtime(getDefaultRuntime());
+  return runtime;
+}
+
+DeviceRuntime getCurrentRuntime() { return currentRuntime().load(); }
+
+void setCurrentRuntime(DeviceRuntime runtime) {
+  if (runtime != DeviceRuntime::Disabled and not isAvailable(runtime)) {
+    throw std::runtime_error("Runtime is not enabled in this build");
+  }
+  currentRuntime().store(runtime);
+}
+
 std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc() {
 #if defined(TT_RUNTIME_ENABLE_TTNN)
-  return ::tt::runtime::ttnn::getCurrentSystemDesc();
-#else
+  if (getCurrentRuntime() == DeviceRuntime::TTNN) {
+    return ::tt::runtime::ttnn::getCurrentSystemDesc();
+  }
+#endif
+#if defined(TT_RUNTIME_ENABLE_CPU)
+  if (getCurrentRuntime() == DeviceRuntime::CPU) {
+    return ::tt::runtime::cpu::getCurrentSystemDesc();
+  }
+#endif
   throw std::runtime_error("runtime is not enabled");
+}
+
+static Tensor createBackendTensor(std::shared_ptr<void> data,
+                                  std::vector<std::uint32_t> const &shape,
+                                  std::vector<std::uint32_t> const &stride,
+                                  std::uint32_t itemsize,
+                                  ::tt::target::DataType dataType) {
+#if defined(TT_RUNTIME_ENABLE_TTNN)
+  if (getCurrentRuntime() == DeviceRuntime::TTNN) {
+    return ::tt::runtime::ttnn::createTensor(data, shape, stride, itemsize,
+                                             dataType);
+  }
 #endif
+#if defined(TT_RUNTIME_ENABLE_CPU)
+  if (getCurrentRuntime() == DeviceRuntime::CPU) {
+    return ::tt::runtime::cpu::createTensor(data, shape, stride, itemsize,
+                                            dataType);
+  }
+#endif
+  throw std::runtime_error("runtime is not enabled");
 }
 
 Tensor createTensor(std::shared_ptr<void> data,
                     std::vector<std::uint32_t> const &shape,
                     std::vector<std::uint32_t> const &stride,
                     std::uint32_t itemsize, ::tt::target::DataType dataType) {
-#if defined(TT_RUNTIME_ENABLE_TTNN)
-  return ::tt::runtime::ttnn::createTensor(data, shape, stride, itemsize,
-                                           dataType);
-#else
-  throw std::runtime_error("runtime is not enabled");
-#endif
+  Tensor tensor = createBackendTensor(data, shape, stride, itemsize, dataType);
+  tensor.desc = TensorDesc{shape, stride, itemsize, dataType};
+  return tensor;
 }
 
 Device openDevice(std::vector<int> deviceIds) {
 #if defined(TT_RUNTIME_ENABLE_TTNN)
-  return ::tt::runtime::ttnn::openDevice(deviceIds);
-#else
-  throw std::runtime_error("runtime is not enabled");
+  if (getCurrentRuntime() == DeviceRuntime::TTNN) {
+    return ::tt::runtime::ttnn::openDevice(deviceIds);
+  }
+#endif
+#if defined(TT_RUNTIME_ENABLE_CPU)
+  if (getCurrentRuntime() == DeviceRuntime::CPU) {
+    return ::tt::runtime::cpu::openDevice(deviceIds);
+  }
 #endif
+  throw std::runtime_error("runtime is not enabled");
 }
 
 void closeDevice(Device device) {
 #if defined(TT_RUNTIME_ENABLE_TTNN)
-  return ::tt::runtime::ttnn::closeDevice(device);
-#else
+  if (getCurrentRuntime() == DeviceRuntime::TTNN) {
+    return ::tt::runtime::ttnn::closeDevice(device);
+  }
+#endif
+#if defined(TT_RUNTIME_ENABLE_CPU)
+  if (getCurrentRuntime() == DeviceRuntime::CPU) {
+    return ::tt::runtime::cpu::closeDevice(device);
+  }
+#endif
   throw std::runtime_error("runtime is not enabled");
+}
+
+std::uint32_t getNumStreams() { return detail::Worker::kNumStreams; }
+
+static Event submitBackend(Device deviceHandle, Binary executableHandle,
+                           std::uint32_t programIndex,
+                           std::vector<Tensor> const &inputHandles,
+                           std::vector<Tensor> const &outputHandles,
+                           std::uint32_t stream) {
+#if defined(TT_RUNTIME_ENABLE_TTNN)
+  if (getCurrentRuntime() == DeviceRuntime::TTNN) {
+    return ::tt::runtime::ttnn::submit(deviceHandle, executableHandle,
+                                       programIndex, inputHandles,
+                                       outputHandles, stream);
+  }
 #endif
+#if defined(TT_RUNTIME_ENABLE_CPU)
+  if (getCurrentRuntime() == DeviceRuntime::CPU) {
+    return ::tt::runtime::cpu::submit(deviceHandle, executableHandle,
+                                      programIndex, inputHandles,
+                                      outputHandles, stream);
+  }
+#endif
+  throw std::runtime_error("runtime is not enabled");
+}
+
+// The writer is swapped as a whole so that submissions racing with
+// stopCapture finish writing to the one they loaded.
+static std::mutex captureMutex;
+static std::shared_ptr<detail::CaptureWriter> captureWriter;
+static std::atomic<bool> captureEnabled = false;
+static std::once_flag captureEnvFlag;
+
+static void setCaptureWriter(std::shared_ptr<detail::CaptureWriter> writer) {
+  std::lock_guard<std::mutex> lock(captureMutex);
+  if (captureWriter) {
+    captureWriter->flush();
+  }
+  captureWriter = std::move(writer);
+  captureEnabled.store(static_cast<bool>(captureWriter));
+}
+
+static void startCaptureFromEnv() {
+  std::call_once(captureEnvFlag, []() {
+    if (char const *path = std::getenv("TT_RUNTIME_CAPTURE")) {
+      setCaptureWriter(std::make_shared<detail::CaptureWriter>(path));
+    }
+  });
+}
+
+static std::shared_ptr<detail::CaptureWriter> getCaptureWriter() {
+  startCaptureFromEnv();
+  if (not captureEnabled.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(captureMutex);
+  return captureWriter;
+}
+
+void startCapture(char const *path) {
+  startCaptureFromEnv();
+  setCaptureWriter(std::make_shared<detail::CaptureWriter>(path));
+}
+
+void stopCapture() {
+  startCaptureFromEnv();
+  setCaptureWriter(nullptr);
+}
+
+static std::size_t getBinarySize(Binary const &executable) {
+  return ::flatbuffers::GetSizePrefixedBufferLength(
+      static_cast<std::uint8_t const *>(executable.handle.get()));
+}
+
+namespace {
+struct CaptureBinaryHash {
+  std::uint64_t hash;
+};
+} // namespace
+
+// Hashed once per binary and kept with its programs. The hash covers the
+// whole binary, so it is stored under the first program.
+static std::uint64_t getBinaryHash(Binary const &executable) {
+  return executable.programCache
+      ->getOrCreate<CaptureBinaryHash>(
+          0,
+          [&]() {
+            return std::make_shared<CaptureBinaryHash>(
+                CaptureBinaryHash{detail::hashBytes(
+                    executable.handle.get(), getBinarySize(executable))});
+          })
+      ->hash;
+}
+
+static void captureSubmit(detail::CaptureWriter &writer,
+                          std::uint64_t timestampNs, Binary const &executable,
+                          std::uint32_t programIndex,
+                          std::vector<Tensor> const &inputs,
+                          std::uint32_t stream) {
+  std::uint64_t hash = getBinaryHash(executable);
+  if (not writer.hasBinary(hash)) {
+    writer.writeBinary(
+        {hash, executable.handle.get(), getBinarySize(executable)});
+  }
+  detail::CaptureSubmit submit;
+  submit.timestampNs = timestampNs;
+  submit.binaryHash = hash;
+  submit.programIndex = programIndex;
+  submit.stream = stream;
+  for (Tensor const &input : inputs) {
+    detail::CaptureTensor tensor;
+    tensor.shape = input.desc.shape;
+    tensor.stride = input.desc.stride;
+    tensor.itemsize = input.desc.itemsize;
+    tensor.dataType = static_cast<std::uint32_t>(input.desc.dataType);
+    tensor.data = input.data.get();
+    tensor.sizeBytes = detail::getCaptureTensorSize(
+        tensor.shape, tensor.stride, tensor.itemsize);
+    submit.inputs.push_back(std::move(tensor));
+  }
+  writer.writeSubmit(submit);
 }
 
 Event submit(Device deviceHandle, Binary executableHandle,
              std::uint32_t programIndex,
              std::vector<Tensor> const &inputHandles,
-             std::vector<Tensor> const &outputHandles) {
-#if defined(TT_RUNTIME_ENABLE_TTNN)
-  return ::tt::runtime::ttnn::submit(deviceHandle, executableHandle,
-                                     programIndex, inputHandles, outputHandles);
-#else
-  throw std::runtime_error("runtime is not enabled");
-#endif
+             std::vector<Tensor> const &outputHandles, std::uint32_t stream) {
+  std::shared_ptr<detail::CaptureWriter> writer = getCaptureWriter();
+  if (not writer) {
+    return submitBackend(deviceHandle, executableHandle, programIndex,
+                         inputHandles, outputHandles, stream);
+  }
+  // Failed submissions are not recorded, so the timestamp is taken up front
+  // and the submission written once it was accepted, all in one ordered step.
+  std::unique_lock<std::mutex> order = writer->orderSubmits();
+  std::uint64_t timestampNs = detail::getTraceTimestampNs();
+  Event event = submitBackend(deviceHandle, executableHandle, programIndex,
+                              inputHandles, outputHandles, stream);
+  captureSubmit(*writer, timestampNs, executableHandle, programIndex,
+                inputHandles, stream);
+  return event;
+}
+
+namespace {
+struct OutputLayouts {
+  std::vector<TensorDesc> descs;
+  std::vector<std::uint64_t> sizes;
+};
+} // namespace
+
+// Block float results are unpacked into the output's buffer as the host type
+// its itemsize stands for. The arena buffer is wrapped as that type rather
+// than packed, since it holds nothing yet, and keeps the block float desc so
+// the read back knows to unpack.
+static Tensor createOutputTensor(std::shared_ptr<void> data,
+                                 TensorDesc const &desc) {
+  ::tt::target::DataType storageType = desc.dataType;
+  if (desc.dataType == ::tt::target::DataType::BFP_BFloat8 or
+      desc.dataType == ::tt::target::DataType::BFP_BFloat4) {
+    switch (desc.itemsize) {
+    case sizeof(float):
+      storageType = ::tt::target::DataType::Float32;
+      break;
+    case sizeof(std::uint16_t):
+      storageType = ::tt::target::DataType::BFloat16;
+      break;
+    default:
+      throw std::runtime_error(
+          "Block float outputs are unpacked to f32 or bf16");
+    }
+  }
+  Tensor tensor = createBackendTensor(data, desc.shape, desc.stride,
+                                      desc.itemsize, storageType);
+  tensor.desc = desc;
+  return tensor;
+}
+
+Submission submit(Device device, Binary executable, std::uint32_t programIndex,
+                  std::vector<Tensor> const &inputs, std::uint32_t stream) {
+  std::shared_ptr<OutputLayouts> layouts =
+      executable.programCache->getOrCreate<OutputLayouts>(
+          programIndex, [&executable, programIndex]() {
+            auto layouts = std::make_shared<OutputLayouts>();
+            layouts->descs = executable.getProgramOutputs(programIndex);
+            for (TensorDesc const &desc : layouts->descs) {
+              layouts->sizes.push_back(detail::getCaptureTensorSize(
+                  desc.shape, desc.stride, desc.itemsize));
+            }
+            return layouts;
+          });
+  std::vector<Tensor> outputs;
+  outputs.reserve(layouts->descs.size());
+  for (std::size_t i = 0; i < layouts->descs.size(); ++i) {
+    outputs.push_back(
+        createOutputTensor(detail::getHostArena().allocate(layouts->sizes[i]),
+                           layouts->descs[i]));
+  }
+  Event event =
+      submit(device, executable, programIndex, inputs, outputs, stream);
+  return Submission{event, std::move(outputs)};
+}
+
+void setHostArenaCapacity(std::size_t bytes) {
+  detail::getHostArena().setCapacity(bytes);
+}
+
+void wait(Event event) {
+  if (event.handle) {
+    event.as<detail::EventState>().wait();
+  }
 }
 
-void wait(Event) { throw std::runtime_error("Not implemented"); }
+bool poll(Event event) {
+  return not event.handle or event.as<detail::EventState>().poll();
+}
+
+ReplayReport replayCapture(Device device, char const *path,
+                           bool preserveTiming) {
+  detail::CaptureReader reader(path);
+  std::shared_ptr<void> const &mapping = reader.getMapping();
+
+  // Binaries and inputs alias the mapping rather than copying out of it.
+  auto alias = [&mapping](void const *data) {
+    return std::shared_ptr<void>(mapping, const_cast<void *>(data));
+  };
+  std::unordered_map<std::uint64_t, Binary> binaries;
+  for (detail::CaptureBinary const &binary : reader.getBinaries()) {
+    if (detail::hashBytes(binary.data, binary.size) != binary.hash) {
+      throw std::runtime_error("Corrupt binary in capture file: " +
+                               std::string(path));
+    }
+    binaries.emplace(binary.hash, Binary(alias(binary.data)));
+  }
+
+  // Tensors are created before the clock starts. Outputs are shared by the
+  // submissions of a program on the same stream, since those run in order.
+  std::vector<detail::CaptureSubmit> const &captured = reader.getSubmits();
+  std::vector<Binary const *> executables;
+  std::vector<std::vector<Tensor>> inputs(captured.size());
+  std::vector<std::vector<Tensor> const *> outputs;
+  std::map<std::tuple<std::uint64_t, std::uint32_t, std::uint32_t>,
+           std::vector<Tensor>>
+      outputPool;
+  for (std::size_t i = 0; i < captured.size(); ++i) {
+    detail::CaptureSubmit const &submission = captured[i];
+    auto binary = binaries.find(submission.binaryHash);
+    if (binary == binaries.end()) {
+      throw std::runtime_error("Capture file references a missing binary: " +
+                               std::string(path));
+    }
+    executables.push_back(&binary->second);
+    for (detail::CaptureTensor const &input : submission.inputs) {
+      inputs[i].push_back(createTensor(
+          alias(input.data), input.shape, input.stride, input.itemsize,
+          static_cast<::tt::target::DataType>(input.dataType)));
+    }
+    auto [entry, inserted] = outputPool.try_emplace(std::make_tuple(
+        submission.binaryHash, submission.programIndex, submission.stream));
+    if (inserted) {
+      for (TensorDesc const &desc :
+           binary->second.getProgramOutputs(submission.programIndex)) {
+        std::uint64_t size = detail::getCaptureTensorSize(
+            desc.shape, desc.stride, desc.itemsize);
+        entry->second.push_back(createTensor(utils::malloc_shared(size), desc));
+      }
+    }
+    outputs.push_back(&entry->second);
+  }
+
+  // Completions are timestamped by polling on a separate thread, so that
+  // submissions blocking on full streams do not delay them.
+  struct Pending {
+    std::size_t index;
+    Event event;
+  };
+  ReplayReport report;
+  report.latenciesNs.resize(captured.size());
+  std::vector<std::uint64_t> submitNs(captured.size());
+  std::mutex pendingMutex;
+  std::vector<Pending> pending;
+  bool submitted = false;
+  std::exception_ptr error;
+  std::uint64_t lastCompletionNs = 0;
+  std::thread waiter([&]() {
+    std::vector<Pending> inFlight;
+    while (true) {
+      bool done;
+      {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        inFlight.insert(inFlight.end(), pending.begin(), pending.end());
+        pending.clear();
+        done = submitted;
+      }
+      auto finished = std::remove_if(
+          inFlight.begin(), inFlight.end(), [&](Pending &entry) {
+            if (not poll(entry.event)) {
+              return false;
+            }
+            lastCompletionNs = detail::getTraceTimestampNs();
+            report.latenciesNs[entry.index] =
+                lastCompletionNs - submitNs[entry.index];
+            try {
+              wait(entry.event);
+            } catch (...) {
+              std::lock_guard<std::mutex> lock(pendingMutex);
+              if (not error) {
+                error = std::current_exception();
+              }
+            }
+            return true;
+          });
+      inFlight.erase(finished, inFlight.end());
+      if (done and inFlight.empty()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+  });
+
+  // Offsets are taken from the earliest submission so that a file whose
+  // records are not in timestamp order cannot wrap them around.
+  std::uint64_t firstNs = std::numeric_limits<std::uint64_t>::max();
+  for (detail::CaptureSubmit const &submission : captured) {
+    firstNs = std::min(firstNs, submission.timestampNs);
+  }
+  std::uint64_t startNs = detail::getTraceTimestampNs();
+  try {
+    for (std::size_t i = 0; i < captured.size(); ++i) {
+      if (preserveTiming) {
+        std::uint64_t offsetNs = captured[i].timestampNs - firstNs;
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::nanoseconds(startNs + offsetNs))));
+      }
+      std::uint64_t timestampNs = detail::getTraceTimestampNs();
+      Event event = submit(device, *executables[i], captured[i].programIndex,
+                           inputs[i], *outputs[i], captured[i].stream);
+      std::lock_guard<std::mutex> lock(pendingMutex);
+      submitNs[i] = timestampNs;
+      pending.push_back({i, event});
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    error = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    submitted = true;
+  }
+  waiter.join();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  report.durationNs = captured.empty() ? 0 : lastCompletionNs - startNs;
+  return report;
+}
+
+void setHostThreadCount(std::uint32_t numThreads) {
+  detail::setHostThreadCount(numThreads);
+}
 
 } // namespace tt::runtime
@@ -2,10 +2,17 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
-#include <list>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 
+#include "tt/runtime/detail/bfp.h"
+#include "tt/runtime/detail/staging_pool.h"
+#include "tt/runtime/detail/thread_pool.h"
+#include "tt/runtime/detail/tilize.h"
+#include "tt/runtime/detail/trace.h"
 #include "tt/runtime/detail/ttnn.h"
 #include "tt/runtime/runtime.h"
 
@@ -30,205 +37,496 @@ ttnn::Tensor tilize(ttnn::Tensor const &input) {
 }
 
 namespace tt::runtime::ttnn {
-static void
-run(::tt::target::ttnn::ToMemoryConfigOp const *op, ::ttnn::Device &device,
-    std::unordered_map<std::uint32_t, ::ttnn::Tensor *> &liveTensors,
-    std::list<::ttnn::Tensor> &tensorPool) {
-  if (op->out()->desc()->layout()->memory_desc()->memory_space() ==
-      ::tt::target::MemorySpace::System) {
-    auto &inputTensor = *liveTensors.at(op->in0()->global_id());
-    auto cpu = inputTensor.cpu();
-    ::ttnn::Tensor untilized;
-    if (op->out()->desc()->layout()->memory_desc()->data_type() ==
-        ::tt::target::DataType::Float32) {
-      untilized = ::tt::tt_metal::tensor_impl::to_layout<float>(
-          cpu, ::ttnn::ROW_MAJOR_LAYOUT);
-    } else if (op->out()->desc()->layout()->memory_desc()->data_type() ==
-               ::tt::target::DataType::BFloat16) {
-      untilized = ::tt::tt_metal::tensor_impl::to_layout<bfloat16>(
-          cpu, ::ttnn::ROW_MAJOR_LAYOUT);
-    } else {
-      throw std::runtime_error("Unsupported data type");
+
+// Tensors of a single program invocation, indexed by the dense slots assigned
+// when the program was prepared. Program inputs and outputs are borrowed from
+// the caller, intermediates are owned by the slot they are bound to.
+struct ProgramContext {
+  ::ttnn::Device &device;
+  std::vector<::ttnn::Tensor *> tensors;
+  std::vector<std::optional<::ttnn::Tensor>> storage;
+  // Host side conversions of program inputs, produced up front and consumed
+  // by the step moving the input to device.
+  std::vector<std::optional<::ttnn::Tensor>> staged;
+
+  ProgramContext(::ttnn::Device &device, std::uint32_t numSlots,
+                 std::uint32_t numStaged)
+      : device(device), tensors(numSlots, nullptr), storage(numSlots),
+        staged(numStaged) {}
+
+  ::ttnn::Tensor &at(std::uint32_t slot) {
+    assert(tensors[slot] && "Tensor used before it was produced");
+    return *tensors[slot];
+  }
+
+  // Binds an op result to its slot. Slots that are already bound, i.e.
+  // program outputs, keep the caller supplied tensor.
+  void insert(std::uint32_t slot, ::ttnn::Tensor tensor) {
+    if (tensors[slot]) {
+      return;
     }
-    auto &outputTensor = *liveTensors.at(op->out()->global_id());
-    void *src = ::tt::tt_metal::get_raw_host_data_ptr(untilized);
-    void *dst = ::tt::tt_metal::get_raw_host_data_ptr(outputTensor);
-    std::uint32_t size = untilized.volume() * untilized.element_size();
+    storage[slot] = std::move(tensor);
+    tensors[slot] = &*storage[slot];
+  }
+
+  // Frees an intermediate after its last use.
+  void release(std::uint32_t slot) {
+    storage[slot].reset();
+    tensors[slot] = nullptr;
+  }
+};
+
+using StepFn = std::function<void(ProgramContext &)>;
+using StageFn = std::function<::ttnn::Tensor(ProgramContext &)>;
+
+struct Step {
+  StepFn run;
+  // Slots whose last use is this step, never program inputs or outputs.
+  std::vector<std::uint32_t> release;
+  // Identify the step in traces.
+  std::uint32_t opIndex;
+  char const *opType;
+  std::string debugInfo;
+};
+
+struct ProgramExecutable {
+  std::string name;
+  std::uint32_t numSlots = 0;
+  std::vector<std::uint32_t> inputSlots;
+  std::vector<std::uint32_t> outputSlots;
+  // Conversions that only depend on program inputs, independent of each
+  // other and of the device, so they all run concurrently before the first
+  // step.
+  std::vector<StageFn> stages;
+  std::vector<Step> steps;
+};
+
+namespace {
+// Assigns dense slots to tensor global ids, only used while preparing.
+class SlotMap {
+public:
+  std::uint32_t get(::tt::target::TensorRef const *ref) {
+    auto [iter, inserted] = slots.try_emplace(ref->global_id(), slots.size());
+    return iter->second;
+  }
+
+  std::uint32_t size() const { return slots.size(); }
+
+private:
+  std::unordered_map<std::uint32_t, std::uint32_t> slots;
+};
+} // namespace
+
+static ::tt::runtime::detail::TiledShape
+getTiledShape(::ttnn::Tensor const &tiled, ::ttnn::Tensor const &rowMajor) {
+  auto const &padded = tiled.get_legacy_shape();
+  auto const &logical = rowMajor.get_legacy_shape();
+  assert(padded.rank() >= 2 && "Tiled tensors are at least 2D");
+  ::tt::runtime::detail::TiledShape shape;
+  shape.paddedRows = padded[padded.rank() - 2];
+  shape.paddedCols = padded[padded.rank() - 1];
+  shape.rows = logical.rank() >= 2 ? logical[logical.rank() - 2] : 1;
+  shape.cols = logical[logical.rank() - 1];
+  shape.batch = rowMajor.volume() / (std::uint64_t(shape.rows) * shape.cols);
+  return shape;
+}
+
+// Unpacks block float tiles into a staging buffer in tiled element order,
+// then untilizes that into dst.
+template <typename T>
+static void untilizeBfp(void const *src, void *dst,
+                        ::tt::runtime::detail::TiledShape const &shape,
+                        ::tt::runtime::detail::BfpFormat format) {
+  std::uint64_t numTiles =
+      shape.batch * (shape.paddedRows / ::tt::runtime::detail::kTileHeight) *
+      (shape.paddedCols / ::tt::runtime::detail::kTileWidth);
+  std::shared_ptr<void> tiled =
+      ::tt::runtime::detail::getStagingPool().allocate(
+          shape.batch * shape.paddedRows * shape.paddedCols * sizeof(T));
+  ::tt::runtime::detail::unpackBfp(static_cast<std::byte const *>(src),
+                                   static_cast<T *>(tiled.get()), numTiles,
+                                   format);
+  ::tt::runtime::detail::untilize(static_cast<T const *>(tiled.get()),
+                                  static_cast<T *>(dst), shape);
+}
+
+// Untilizes a tiled host tensor straight into the caller's row major buffer
+// rather than through an intermediate host tensor.
+void untilizeInto(::ttnn::Tensor const &tiled, ::ttnn::Tensor &output,
+                  ::tt::target::DataType dataType) {
+  void *src = ::tt::tt_metal::get_raw_host_data_ptr(tiled);
+  void *dst = ::tt::tt_metal::get_raw_host_data_ptr(output);
+  if (tiled.get_layout() != ::ttnn::Layout::TILE) {
+    std::uint32_t size = tiled.volume() * tiled.element_size();
     std::memcpy(dst, src, size);
     return;
   }
+  ::tt::runtime::detail::TiledShape shape = getTiledShape(tiled, output);
+  if (auto format = getBfpFormat(dataType)) {
+    switch (output.element_size()) {
+    case sizeof(float):
+      return untilizeBfp<float>(src, dst, shape, *format);
+    case sizeof(std::uint16_t):
+      return untilizeBfp<std::uint16_t>(src, dst, shape, *format);
+    default:
+      throw std::runtime_error(
+          "Block float tensors are unpacked to f32 or bf16");
+    }
+  }
+  switch (dataType) {
+  case ::tt::target::DataType::Float32:
+    return ::tt::runtime::detail::untilize(static_cast<float const *>(src),
+                                           static_cast<float *>(dst), shape);
+  case ::tt::target::DataType::UInt32:
+    return ::tt::runtime::detail::untilize(
+        static_cast<std::uint32_t const *>(src),
+        static_cast<std::uint32_t *>(dst), shape);
+  case ::tt::target::DataType::BFloat16:
+    return ::tt::runtime::detail::untilize(
+        static_cast<std::uint16_t const *>(src),
+        static_cast<std::uint16_t *>(dst), shape);
+  default:
+    throw std::runtime_error("Unsupported data type");
+  }
+}
+
+// Tilizes a row major host tensor with the runtime's converters. T is the
+// element type handed to the converter and StorageT the one ttnn stores.
+// Shapes that are not tile aligned go through ttnn, which also pads them.
+template <typename T, typename StorageT>
+static ::ttnn::Tensor tilizeOnHost(::ttnn::Tensor const &input) {
+  static_assert(sizeof(T) == sizeof(StorageT));
+  auto const &shape = input.get_legacy_shape();
+  std::vector<std::uint32_t> dims;
+  for (std::size_t i = 0; i < shape.rank(); ++i) {
+    dims.push_back(shape[i]);
+  }
+  while (dims.size() < 4) {
+    dims.insert(dims.begin(), 1);
+  }
+  ::tt::runtime::detail::TiledShape tiledShape;
+  tiledShape.rows = tiledShape.paddedRows = dims[dims.size() - 2];
+  tiledShape.cols = tiledShape.paddedCols = dims[dims.size() - 1];
+  if (tiledShape.rows % ::tt::runtime::detail::kTileHeight != 0 or
+      tiledShape.cols % ::tt::runtime::detail::kTileWidth != 0) {
+    return ::tilize(input);
+  }
+  tiledShape.batch =
+      input.volume() / (std::uint64_t(tiledShape.rows) * tiledShape.cols);
+
+  // The tiles are written to a staging buffer which the transfer to device
+  // reads from. The storage holds on to the buffer until the tensor is gone.
+  std::shared_ptr<void> staging =
+      ::tt::runtime::detail::getStagingPool().allocate(input.volume() *
+                                                       sizeof(StorageT));
+  ::tt::runtime::detail::tilize(
+      static_cast<T const *>(::tt::tt_metal::get_raw_host_data_ptr(input)),
+      static_cast<T *>(staging.get()), tiledShape);
+  return ::ttnn::Tensor(
+      ::tt::tt_metal::BorrowedStorage(
+          ::tt::tt_metal::borrowed_buffer::Buffer<StorageT>(
+              static_cast<StorageT *>(staging.get()), input.volume()),
+          [] {}, [staging] {}),
+      dims, input.get_dtype(), ::ttnn::Layout::TILE);
+}
+
+static ::ttnn::Tensor tilizeOnHost(::ttnn::Tensor const &input,
+                                   ::tt::target::DataType dataType) {
+  // Block float inputs are packed into tiles when they are created.
+  if (input.get_layout() == ::ttnn::Layout::TILE) {
+    return input;
+  }
+  switch (dataType) {
+  case ::tt::target::DataType::Float32:
+    return tilizeOnHost<float, float>(input);
+  case ::tt::target::DataType::UInt32:
+    return tilizeOnHost<std::uint32_t, std::uint32_t>(input);
+  case ::tt::target::DataType::BFloat16:
+    return tilizeOnHost<std::uint16_t, bfloat16>(input);
+  default:
+    return ::tilize(input);
+  }
+}
+
+static StepFn prepare(::tt::target::ttnn::ToMemoryConfigOp const *op,
+                      SlotMap &slots, ProgramExecutable &executable) {
+  std::uint32_t in = slots.get(op->in0());
+  std::uint32_t out = slots.get(op->out());
+  if (op->out()->desc()->layout()->memory_desc()->memory_space() ==
+      ::tt::target::MemorySpace::System) {
+    ::tt::target::DataType dataType =
+        op->out()->desc()->layout()->memory_desc()->data_type();
+    return [in, out, dataType](ProgramContext &ctx) {
+      untilizeInto(ctx.at(in).cpu(), ctx.at(out), dataType);
+    };
+  }
   bool isL1 = op->in0()->desc()->layout()->memory_desc()->memory_space() ==
               ::tt::target::MemorySpace::DeviceL1;
-  const auto memoryConfig =
-      isL1 ? ::ttnn::L1_MEMORY_CONFIG : ::ttnn::DRAM_MEMORY_CONFIG;
-  auto &inputTensor = *liveTensors.at(op->in0()->global_id());
-  ::ttnn::Tensor tilized = ::tilize(inputTensor);
-  auto deviceTensor = ::ttnn::to_device(tilized, &device, memoryConfig);
-  tensorPool.push_back(deviceTensor);
-  // auto [iter, inserted] =
-  liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
-  // assert(inserted && "Duplicate output tensor");
+  ::tt::target::DataType dataType =
+      op->in0()->desc()->layout()->memory_desc()->data_type();
+  if (in < executable.inputSlots.size()) {
+    std::size_t stage = executable.stages.size();
+    executable.stages.push_back([in, dataType](ProgramContext &ctx) {
+      return tilizeOnHost(ctx.at(in), dataType);
+    });
+    return [stage, out, isL1](ProgramContext &ctx) {
+      const auto memoryConfig =
+          isL1 ? ::ttnn::L1_MEMORY_CONFIG : ::ttnn::DRAM_MEMORY_CONFIG;
+      ctx.insert(out, ::ttnn::to_device(*ctx.staged[stage], &ctx.device,
+                                        memoryConfig));
+      ctx.staged[stage].reset();
+    };
+  }
+  return [in, out, isL1, dataType](ProgramContext &ctx) {
+    const auto memoryConfig =
+        isL1 ? ::ttnn::L1_MEMORY_CONFIG : ::ttnn::DRAM_MEMORY_CONFIG;
+    ::ttnn::Tensor tilized = tilizeOnHost(ctx.at(in), dataType);
+    ctx.insert(out, ::ttnn::to_device(tilized, &ctx.device, memoryConfig));
+  };
 }
 
-static void
-run(::tt::target::ttnn::EltwiseOp const *op, ::ttnn::Device &device,
-    std::unordered_map<std::uint32_t, ::ttnn::Tensor *> &liveTensors,
-    std::list<::ttnn::Tensor> &tensorPool) {
+static StepFn prepare(::tt::target::ttnn::EltwiseOp const *op,
+                      SlotMap &slots) {
+  std::vector<std::uint32_t> ins;
+  for (::tt::target::TensorRef const *in : *op->ins()) {
+    ins.push_back(slots.get(in));
+  }
+  std::uint32_t out = slots.get(op->out());
   switch (op->type()) {
   /* Eltwise Binary */
   case ::tt::target::ttnn::EltwiseOpType::Add: {
-    assert(op->ins()->size() == 2 && "Unsupported number of inputs");
-    auto &lhs = *liveTensors.at(op->ins()->Get(0)->global_id());
-    auto &rhs = *liveTensors.at(op->ins()->Get(1)->global_id());
-    tensorPool.push_back(::ttnn::add(lhs, rhs));
-    liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
-    break;
+    assert(ins.size() == 2 && "Unsupported number of inputs");
+    return [lhs = ins[0], rhs = ins[1], out](ProgramContext &ctx) {
+      ctx.insert(out, ::ttnn::add(ctx.at(lhs), ctx.at(rhs)));
+    };
   }
   case ::tt::target::ttnn::EltwiseOpType::Multiply: {
-    assert(op->ins()->size() == 2 && "Unsupported number of inputs");
-    auto &lhs = *liveTensors.at(op->ins()->Get(0)->global_id());
-    auto &rhs = *liveTensors.at(op->ins()->Get(1)->global_id());
-    tensorPool.push_back(::ttnn::multiply(lhs, rhs));
-    liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
-    break;
+    assert(ins.size() == 2 && "Unsupported number of inputs");
+    return [lhs = ins[0], rhs = ins[1], out](ProgramContext &ctx) {
+      ctx.insert(out, ::ttnn::multiply(ctx.at(lhs), ctx.at(rhs)));
+    };
   }
   case ::tt::target::ttnn::EltwiseOpType::Subtract: {
-    assert(op->ins()->size() == 2 && "Unsupported number of inputs");
-    auto &lhs = *liveTensors.at(op->ins()->Get(0)->global_id());
-    auto &rhs = *liveTensors.at(op->ins()->Get(1)->global_id());
-    tensorPool.push_back(::ttnn::subtract(lhs, rhs));
-    liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
-    break;
+    assert(ins.size() == 2 && "Unsupported number of inputs");
+    return [lhs = ins[0], rhs = ins[1], out](ProgramContext &ctx) {
+      ctx.insert(out, ::ttnn::subtract(ctx.at(lhs), ctx.at(rhs)));
+    };
   }
   case ::tt::target::ttnn::EltwiseOpType::GreaterEqual: {
-    assert(op->ins()->size() == 2 && "Unsupported number of inputs");
-    ::ttnn::Tensor &lhs = *liveTensors.at(op->ins()->Get(0)->global_id());
-    ::ttnn::Tensor &rhs = *liveTensors.at(op->ins()->Get(1)->global_id());
-    tensorPool.push_back(::ttnn::ge(lhs, rhs));
-    liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
-    break;
+    assert(ins.size() == 2 && "Unsupported number of inputs");
+    return [lhs = ins[0], rhs = ins[1], out](ProgramContext &ctx) {
+      ctx.insert(out, ::ttnn::ge(ctx.at(lhs), ctx.at(rhs)));
+    };
   }
   /* Eltwise Unary */
   case ::tt::target::ttnn::EltwiseOpType::Relu: {
-    assert(op->ins()->size() == 1 && "Unsupported number of inputs");
-    ::ttnn::Tensor &in = *liveTensors.at(op->ins()->Get(0)->global_id());
-    tensorPool.push_back(::ttnn::relu(in));
-    liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
-    break;
+    assert(ins.size() == 1 && "Unsupported number of inputs");
+    return [in = ins[0], out](ProgramContext &ctx) {
+      ctx.insert(out, ::ttnn::relu(ctx.at(in)));
+    };
   }
   }
+  throw std::runtime_error("Unsupported eltwise operation type");
 }
 
-static void
-run(::tt::target::ttnn::ReductionOp const *op, ::ttnn::Device &device,
-    std::unordered_map<std::uint32_t, ::ttnn::Tensor *> &liveTensors,
-    std::list<::ttnn::Tensor> &tensorPool) {
+static StepFn prepare(::tt::target::ttnn::ReductionOp const *op,
+                      SlotMap &slots) {
+  std::uint32_t in = slots.get(op->in());
+  std::uint32_t out = slots.get(op->out());
   switch (op->type()) {
   case ::tt::target::ttnn::ReductionOpType::Sum: {
-    auto &in = *liveTensors.at(op->in()->global_id());
-
     const auto *dim_arg_fb_ptr = op->dim_arg();
     std::optional<vector<int>> dim_arg =
         dim_arg_fb_ptr ? std::make_optional(std::vector<int>(
                              dim_arg_fb_ptr->begin(), dim_arg_fb_ptr->end()))
                        : std::nullopt;
-
-    tensorPool.push_back(::ttnn::sum(in, dim_arg, op->keep_dim()));
-
-    liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
-    break;
+    bool keepDim = op->keep_dim();
+    return [in, out, dim_arg, keepDim](ProgramContext &ctx) {
+      ctx.insert(out, ::ttnn::sum(ctx.at(in), dim_arg, keepDim));
+    };
   }
   }
+  throw std::runtime_error("Unsupported reduction operation type");
 }
 
-static void
-run(::tt::target::ttnn::SoftmaxOp const *op, ::ttnn::device::Device &device,
-    std::unordered_map<std::uint32_t, ::ttnn::Tensor *> &liveTensors,
-    std::list<::ttnn::Tensor> &tensorPool) {
-  ::ttnn::Tensor &in = *liveTensors.at(op->in()->global_id());
+static StepFn prepare(::tt::target::ttnn::SoftmaxOp const *op,
+                      SlotMap &slots) {
+  std::uint32_t in = slots.get(op->in());
+  std::uint32_t out = slots.get(op->out());
   int32_t dimension = op->dimension();
-
-  tensorPool.push_back(::ttnn::softmax(in, dimension));
-  liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
+  return [in, out, dimension](ProgramContext &ctx) {
+    ctx.insert(out, ::ttnn::softmax(ctx.at(in), dimension));
+  };
 }
 
 // ANCHOR: adding_an_op_matmul_runtime
-static void
-run(::tt::target::ttnn::MatmulOp const *op, ::ttnn::Device &device,
-    std::unordered_map<std::uint32_t, ::ttnn::Tensor *> &liveTensors,
-    std::list<::ttnn::Tensor> &tensorPool) {
-  auto &lhs = *liveTensors.at(op->in0()->global_id());
-  auto &rhs = *liveTensors.at(op->in1()->global_id());
-  tensorPool.push_back(
-      ::ttnn::operations::matmul::matmul(lhs, rhs, std::nullopt));
-  liveTensors.try_emplace(op->out()->global_id(), &tensorPool.back());
+static StepFn prepare(::tt::target::ttnn::MatmulOp const *op,
+                      SlotMap &slots) {
+  std::uint32_t lhs = slots.get(op->in0());
+  std::uint32_t rhs = slots.get(op->in1());
+  std::optional<std::uint32_t> bias = std::nullopt;
+  if (op->bias()) {
+    bias = slots.get(op->bias());
+  }
+  std::uint32_t out = slots.get(op->out());
+  // The activation runs as the matmul's fused epilogue rather than as a
+  // separate pass over the product.
+  std::optional<std::string> activation = std::nullopt;
+  switch (op->activation()) {
+  case ::tt::target::ttnn::MatmulActivation::None:
+    break;
+  case ::tt::target::ttnn::MatmulActivation::Relu:
+    activation = "relu";
+    break;
+  }
+  return [lhs, rhs, bias, out, activation](ProgramContext &ctx) {
+    std::optional<::ttnn::Tensor> biasTensor = std::nullopt;
+    if (bias) {
+      biasTensor = ctx.at(*bias);
+    }
+    ctx.insert(out, ::ttnn::operations::matmul::matmul(
+                        ctx.at(lhs), ctx.at(rhs), biasTensor,
+                        /*program_config=*/std::monostate{},
+                        ::ttnn::DRAM_MEMORY_CONFIG, /*dtype=*/std::nullopt,
+                        activation));
+  };
 }
 // ANCHOR_END: adding_an_op_matmul_runtime
 
-static void
-run(::tt::target::ttnn::Operation const *op, ::ttnn::Device &device,
-    std::unordered_map<std::uint32_t, ::ttnn::Tensor *> &liveTensors,
-    std::list<::ttnn::Tensor> &tensorPool) {
+static std::optional<StepFn>
+prepare(::tt::target::ttnn::Operation const *op, SlotMap &slots,
+        ProgramExecutable &executable) {
   switch (op->type_type()) {
   case ::tt::target::ttnn::OpType::OpenDeviceOp: {
     // Skip for now, do we want device externally supplied?
-    break;
+    return std::nullopt;
   }
   case ::tt::target::ttnn::OpType::CloseDeviceOp: {
     // Skip for now, do we want device externally supplied?
-    break;
+    return std::nullopt;
   }
   case ::tt::target::ttnn::OpType::ToMemoryConfigOp: {
-    return run(op->type_as_ToMemoryConfigOp(), device, liveTensors, tensorPool);
+    return prepare(op->type_as_ToMemoryConfigOp(), slots, executable);
   }
   case ::tt::target::ttnn::OpType::FullOp: {
     // Skip for now, we need an empty op
-    break;
+    return std::nullopt;
   }
   case ::tt::target::ttnn::OpType::EltwiseOp: {
-    return run(op->type_as_EltwiseOp(), device, liveTensors, tensorPool);
+    return prepare(op->type_as_EltwiseOp(), slots);
   }
   case ::tt::target::ttnn::OpType::MatmulOp: {
-    return run(op->type_as_MatmulOp(), device, liveTensors, tensorPool);
+    return prepare(op->type_as_MatmulOp(), slots);
   }
   case ::tt::target::ttnn::OpType::ReductionOp: {
-    return run(op->type_as_ReductionOp(), device, liveTensors, tensorPool);
+    return prepare(op->type_as_ReductionOp(), slots);
   }
   case ::tt::target::ttnn::OpType::SoftmaxOp: {
-    return run(op->type_as_SoftmaxOp(), device, liveTensors, tensorPool);
+    return prepare(op->type_as_SoftmaxOp(), slots);
   }
   default:
     throw std::runtime_error("Unsupported operation type");
   }
 }
 
-void runProgram(::ttnn::Device &device,
-                ::tt::target::ttnn::Program const *program,
-                std::vector<::ttnn::Tensor *> const &inputs,
-                std::vector<::ttnn::Tensor *> const &outputs) {
-  std::unordered_map<std::uint32_t, ::ttnn::Tensor *> liveTensors;
-  std::list<::ttnn::Tensor> tensorPool;
+std::shared_ptr<ProgramExecutable>
+prepareProgram(::tt::target::ttnn::Program const *program) {
+  auto executable = std::make_shared<ProgramExecutable>();
+  SlotMap slots;
 
-  int inputIndex = 0;
-  assert(program->inputs()->size() == inputs.size() &&
-         "Mismatch between program inputs and input tensors");
   for (::tt::target::TensorRef const *input : *program->inputs()) {
-    auto [iter, inserted] =
-        liveTensors.try_emplace(input->global_id(), inputs[inputIndex++]);
-    assert(inserted && "Duplicate input tensor");
+    assert(slots.size() == executable->inputSlots.size() &&
+           "Duplicate input tensor");
+    executable->inputSlots.push_back(slots.get(input));
   }
 
-  int outputIndex = 0;
-  assert(program->outputs()->size() == outputs.size() &&
-         "Mismatch between program outputs and output tensors");
   for (::tt::target::TensorRef const *output : *program->outputs()) {
-    auto [iter, inserted] =
-        liveTensors.try_emplace(output->global_id(), outputs[outputIndex++]);
-    assert(inserted && "Duplicate output tensor");
+    std::uint32_t slot = slots.get(output);
+    assert(slot >= executable->inputSlots.size() &&
+           "Program output aliases an input");
+    executable->outputSlots.push_back(slot);
+  }
+
+  std::size_t numPinned = slots.size();
+  executable->name = program->name() ? program->name()->str() : "";
+  executable->steps.reserve(program->operations()->size());
+  for (std::uint32_t opIndex = 0; opIndex < program->operations()->size();
+       ++opIndex) {
+    ::tt::target::ttnn::Operation const *op =
+        program->operations()->Get(opIndex);
+    std::optional<StepFn> run = prepare(op, slots, *executable);
+    if (run) {
+      executable->steps.push_back(
+          Step{std::move(*run), {}, opIndex,
+               ::tt::target::ttnn::EnumNameOpType(op->type_type()),
+               op->debug_info() ? op->debug_info()->str() : ""});
+    }
+    if (not op->release() or executable->steps.empty()) {
+      continue;
+    }
+    // Ops skipped at runtime do not touch their tensors, so anything they
+    // release can go right after the preceding step.
+    for (::tt::target::TensorRef const *ref : *op->release()) {
+      std::uint32_t slot = slots.get(ref);
+      if (slot >= numPinned) {
+        executable->steps.back().release.push_back(slot);
+      }
+    }
   }
 
-  for (::tt::target::ttnn::Operation const *op : *program->operations()) {
-    run(op, device, liveTensors, tensorPool);
+  executable->numSlots = slots.size();
+  return executable;
+}
+
+void runProgram(::ttnn::Device &device, ProgramExecutable const &executable,
+                std::vector<::ttnn::Tensor *> const &inputs,
+                std::vector<::ttnn::Tensor *> const &outputs) {
+  assert(executable.inputSlots.size() == inputs.size() &&
+         "Mismatch between program inputs and input tensors");
+  assert(executable.outputSlots.size() == outputs.size() &&
+         "Mismatch between program outputs and output tensors");
+  ProgramContext ctx(device, executable.numSlots, executable.stages.size());
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    ctx.tensors[executable.inputSlots[i]] = inputs[i];
+  }
+  for (std::size_t i = 0; i < outputs.size(); ++i) {
+    ctx.tensors[executable.outputSlots[i]] = outputs[i];
   }
+
+  // Each conversion splits itself further across the pool when large enough.
+  ::tt::runtime::detail::getHostThreadPool()->parallelFor(
+      executable.stages.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          ctx.staged[i] = executable.stages[i](ctx);
+        }
+      });
+
+  bool trace = ::tt::runtime::detail::isOpTraceEnabled();
+  for (Step const &step : executable.steps) {
+    if (trace) {
+      OpTraceEvent event;
+      event.startNs = ::tt::runtime::detail::getTraceTimestampNs();
+      step.run(ctx);
+      event.endNs = ::tt::runtime::detail::getTraceTimestampNs();
+      event.programName = executable.name;
+      event.opIndex = step.opIndex;
+      event.opType = step.opType;
+      event.debugInfo = step.debugInfo;
+      event.threadId = ::tt::runtime::detail::getTraceThreadId();
+      ::tt::runtime::detail::emitOpTrace(event);
+    } else {
+      step.run(ctx);
+    }
+    for (std::uint32_t slot : step.release) {
+      ctx.release(slot);
+    }
+  }
+}
+
+void runProgram(::ttnn::Device &device,
+                ::tt::target::ttnn::Program const *program,
+                std::vector<::ttnn::Tensor *> const &inputs,
+                std::vector<::ttnn::Tensor *> const &outputs) {
+  runProgram(device, *prepareProgram(program), inputs, outputs);
 }
 } // namespace tt::runtime::ttnn
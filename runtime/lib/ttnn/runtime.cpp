@@ -3,7 +3,12 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "tt/runtime/runtime.h"
+#include "tt/runtime/detail/bfp.h"
+#include "tt/runtime/detail/device_manager.h"
+#include "tt/runtime/detail/staging_pool.h"
+#include "tt/runtime/detail/tilize.h"
 #include "tt/runtime/detail/ttnn.h"
+#include "tt/runtime/detail/worker.h"
 #include "tt/runtime/utils.h"
 
 #include "ttmlir/Target/TTNN/Target.h"
@@ -29,11 +34,36 @@ static ::tt::target::Dim2d toFlatbuffer(CoreCoord coreCoord) {
   return ::tt::target::Dim2d(coreCoord.y, coreCoord.x);
 }
 
-std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc() {
-  auto &device = ::ttnn::open_device(0);
-  std::vector<int> chipIds = {
-      device.id(),
-  };
+// Devices stay open between users, see DeviceManager. Idle devices are closed
+// at exit, before the statics ttnn created while opening them are destroyed.
+static ::tt::runtime::detail::DeviceManager &getDeviceManager() {
+  static ::tt::runtime::detail::DeviceManager manager(
+      [](int deviceId) -> void * {
+        ::ttnn::Device &device = ::ttnn::open_device(deviceId);
+        static bool registered = (std::atexit([] {
+                                    getDeviceManager().closeIdle();
+                                  }),
+                                  true);
+        (void)registered;
+        return &device;
+      },
+      [](void *handle) {
+        auto &device = *static_cast<::ttnn::Device *>(handle);
+        ::tt::runtime::detail::releaseWorker(&device);
+        ::ttnn::close_device(device);
+      });
+  return manager;
+}
+
+static bool verifySystemDesc(void const *buffer, std::size_t size) {
+  ::flatbuffers::Verifier verifier(static_cast<uint8_t const *>(buffer), size);
+  return ::tt::target::VerifySizePrefixedSystemDescRootBuffer(verifier);
+}
+
+static ::tt::runtime::detail::SystemDescCache::Buffer
+createSystemDesc(int deviceId) {
+  auto &device = *static_cast<::ttnn::Device *>(
+      getDeviceManager().borrow(deviceId));
   ::flatbuffers::FlatBufferBuilder fbb;
   ::ttmlir::Version ttmlirVersion = ::ttmlir::getVersion();
   ::tt::target::Version version(ttmlirVersion.major, ttmlirVersion.minor,
@@ -73,8 +103,22 @@ std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc() {
   auto size = fbb.GetSize();
   auto handle = utils::malloc_shared(size);
   std::memcpy(handle.get(), buf, size);
-  ::ttnn::close_device(device);
-  return std::make_pair(SystemDesc(handle), chipIds);
+  return {handle, size};
+}
+
+std::pair<SystemDesc, DeviceIds> getCurrentSystemDesc() {
+  static ::tt::runtime::detail::SystemDescCache cache;
+  DeviceIds deviceIds = {0};
+  std::string fingerprint = ::tt::runtime::detail::getDeviceFingerprint(
+      deviceIds, ::ttmlir::getGitHash());
+  std::shared_ptr<void> handle =
+      cache
+          .getOrCreate(
+              fingerprint,
+              [&deviceIds] { return createSystemDesc(deviceIds.front()); },
+              verifySystemDesc)
+          .first;
+  return std::make_pair(SystemDesc(handle), deviceIds);
 }
 
 template <typename T>
@@ -118,15 +162,100 @@ static ::ttnn::DataType toTTNNDataType(::tt::target::DataType dataType) {
     return ::ttnn::DataType::UINT16;
   // case ::tt::target::DataType::UInt8:
   //   return ::ttnn::DataType::UINT8;
+  case ::tt::target::DataType::BFP_BFloat8:
+    return ::ttnn::DataType::BFLOAT8_B;
+  case ::tt::target::DataType::BFP_BFloat4:
+    return ::ttnn::DataType::BFLOAT4_B;
   default:
     throw std::runtime_error("Unsupported data type");
   }
 }
 
+std::optional<::tt::runtime::detail::BfpFormat>
+getBfpFormat(::tt::target::DataType dataType) {
+  switch (dataType) {
+  case ::tt::target::DataType::BFP_BFloat8:
+    return ::tt::runtime::detail::BfpFormat::Bfp8;
+  case ::tt::target::DataType::BFP_BFloat4:
+    return ::tt::runtime::detail::BfpFormat::Bfp4;
+  default:
+    return std::nullopt;
+  }
+}
+
+template <typename T>
+static void packBfp(void const *data,
+                    ::tt::runtime::detail::TiledShape const &shape,
+                    std::uint64_t numTiles, std::byte *packed,
+                    ::tt::runtime::detail::BfpFormat format) {
+  std::shared_ptr<void> tiled =
+      ::tt::runtime::detail::getStagingPool().allocate(
+          shape.batch * shape.paddedRows * shape.paddedCols * sizeof(T));
+  ::tt::runtime::detail::tilize(static_cast<T const *>(data),
+                                static_cast<T *>(tiled.get()), shape);
+  ::tt::runtime::detail::packBfp(static_cast<T const *>(tiled.get()), packed,
+                                 numTiles, format);
+}
+
+// Block float tensors are packed on the host from row major f32 or bf16
+// data, told apart by itemsize, so they cross to the device in their packed
+// size. The returned tensor owns the packed tiles.
+static ::ttnn::Tensor createBfpTensor(void const *data,
+                                      std::vector<std::uint32_t> shape,
+                                      std::uint32_t itemsize,
+                                      ::tt::target::DataType dataType) {
+  ::tt::runtime::detail::BfpFormat format = *getBfpFormat(dataType);
+  if (shape.size() < 2) {
+    shape.insert(shape.begin(), 2 - shape.size(), 1);
+  }
+  constexpr std::uint32_t tileHeight = ::tt::runtime::detail::kTileHeight;
+  constexpr std::uint32_t tileWidth = ::tt::runtime::detail::kTileWidth;
+  ::tt::runtime::detail::TiledShape tiledShape;
+  tiledShape.rows = shape[shape.size() - 2];
+  tiledShape.cols = shape[shape.size() - 1];
+  tiledShape.paddedRows =
+      (tiledShape.rows + tileHeight - 1) / tileHeight * tileHeight;
+  tiledShape.paddedCols =
+      (tiledShape.cols + tileWidth - 1) / tileWidth * tileWidth;
+  for (std::size_t i = 0; i + 2 < shape.size(); ++i) {
+    tiledShape.batch *= shape[i];
+  }
+  std::vector<std::uint32_t> paddedShape = shape;
+  paddedShape[shape.size() - 2] = tiledShape.paddedRows;
+  paddedShape[shape.size() - 1] = tiledShape.paddedCols;
+  std::uint64_t numTiles = tiledShape.batch *
+                           (tiledShape.paddedRows / tileHeight) *
+                           (tiledShape.paddedCols / tileWidth);
+
+  std::vector<std::uint32_t> packed(
+      numTiles * ::tt::runtime::detail::getBfpTileSizeBytes(format) /
+      sizeof(std::uint32_t));
+  auto *packedBytes = reinterpret_cast<std::byte *>(packed.data());
+  switch (itemsize) {
+  case sizeof(float):
+    packBfp<float>(data, tiledShape, numTiles, packedBytes, format);
+    break;
+  case sizeof(std::uint16_t):
+    packBfp<std::uint16_t>(data, tiledShape, numTiles, packedBytes, format);
+    break;
+  default:
+    throw std::runtime_error("Block float tensors are packed from f32 or bf16");
+  }
+  return ::ttnn::Tensor(
+      OwnedStorage{owned_buffer::create<std::uint32_t>(std::move(packed))},
+      ::tt::tt_metal::Shape(shape, paddedShape), toTTNNDataType(dataType),
+      ::ttnn::Layout::TILE);
+}
+
 Tensor createTensor(std::shared_ptr<void> data,
                     std::vector<std::uint32_t> const &shape,
                     std::vector<std::uint32_t> const &stride,
                     std::uint32_t itemsize, ::tt::target::DataType dataType) {
+  if (getBfpFormat(dataType)) {
+    auto tensor = std::make_shared<::ttnn::Tensor>(
+        createBfpTensor(data.get(), shape, itemsize, dataType));
+    return Tensor(tensor, data);
+  }
   std::uint32_t numElements = shape[0] * stride[0];
   auto tensor = std::make_shared<::ttnn::Tensor>(
       createStorage(data.get(), numElements, dataType), shape,
@@ -136,13 +265,13 @@ Tensor createTensor(std::shared_ptr<void> data,
 
 Device openDevice(std::vector<int> deviceIds) {
   assert(deviceIds.size() == 1 && "Only one device is supported for now");
-  auto &device = ::ttnn::open_device(deviceIds.front());
+  auto &device = *static_cast<::ttnn::Device *>(
+      getDeviceManager().acquire(deviceIds.front()));
   return Device::borrow(device);
 }
 
 void closeDevice(Device device) {
-  auto &ttnn_device = device.as<::ttnn::Device>();
-  ::ttnn::close_device(ttnn_device);
+  getDeviceManager().release(&device.as<::ttnn::Device>());
 }
 
 static ::tt::target::ttnn::TTNNBinary const *getBinary(Flatbuffer binary) {
@@ -154,27 +283,68 @@ static ::tt::target::ttnn::TTNNBinary const *getBinary(Flatbuffer binary) {
   return ::tt::target::ttnn::GetSizePrefixedTTNNBinary(binary.handle.get());
 }
 
+// Block float outputs are unpacked into the caller's row major f32 or bf16
+// buffer, told apart by itemsize, rather than into the packed tiles
+// createTensor made of it.
+static ::ttnn::Tensor createBfpReadBackTensor(Tensor const &output) {
+  TensorDesc const &desc = output.desc;
+  ::tt::target::DataType dataType;
+  switch (desc.itemsize) {
+  case sizeof(float):
+    dataType = ::tt::target::DataType::Float32;
+    break;
+  case sizeof(std::uint16_t):
+    dataType = ::tt::target::DataType::BFloat16;
+    break;
+  default:
+    throw std::runtime_error(
+        "Block float tensors are unpacked to f32 or bf16");
+  }
+  std::uint32_t numElements = desc.shape[0] * desc.stride[0];
+  return ::ttnn::Tensor(createStorage(output.data.get(), numElements, dataType),
+                        desc.shape, toTTNNDataType(dataType),
+                        ::ttnn::Layout::ROW_MAJOR);
+}
+
 Event submit(Device deviceHandle, Binary executableHandle,
              std::uint32_t programIndex,
              std::vector<Tensor> const &inputHandles,
-             std::vector<Tensor> const &outputHandles) {
+             std::vector<Tensor> const &outputHandles, std::uint32_t stream) {
   ::ttnn::Device &device = deviceHandle.as<::ttnn::Device>();
   ::tt::target::ttnn::TTNNBinary const &fbb = *getBinary(executableHandle);
-  std::vector<::ttnn::Tensor *> inputs;
-  inputs.reserve(inputHandles.size());
-  for (auto &input : inputHandles) {
-    inputs.push_back(static_cast<::ttnn::Tensor *>(input.handle.get()));
-  }
-  std::vector<::ttnn::Tensor *> outputs;
-  outputs.reserve(outputHandles.size());
-  for (auto &output : outputHandles) {
-    outputs.push_back(static_cast<::ttnn::Tensor *>(output.handle.get()));
+  if (programIndex >= fbb.programs()->size()) {
+    throw std::runtime_error("Program index out of range");
   }
-  tt::runtime::ttnn::runProgram(device, fbb.programs()->Get(programIndex),
-                                inputs, outputs);
-  return Event(nullptr);
+  std::shared_ptr<ProgramExecutable> executable =
+      executableHandle.programCache->getOrCreate<ProgramExecutable>(
+          programIndex, [&fbb, programIndex] {
+            return prepareProgram(fbb.programs()->Get(programIndex));
+          });
+  // The job holds on to the handles so the binary and the tensor storage
+  // outlive the submission even if the caller drops its copies.
+  auto job = [&device, executable, executableHandle, inputHandles,
+              outputHandles] {
+    std::vector<::ttnn::Tensor *> inputs;
+    inputs.reserve(inputHandles.size());
+    for (auto &input : inputHandles) {
+      inputs.push_back(static_cast<::ttnn::Tensor *>(input.handle.get()));
+    }
+    std::vector<::ttnn::Tensor *> outputs;
+    std::vector<::ttnn::Tensor> readBack;
+    outputs.reserve(outputHandles.size());
+    readBack.reserve(outputHandles.size());
+    for (auto &output : outputHandles) {
+      if (getBfpFormat(output.desc.dataType)) {
+        readBack.push_back(createBfpReadBackTensor(output));
+        outputs.push_back(&readBack.back());
+      } else {
+        outputs.push_back(static_cast<::ttnn::Tensor *>(output.handle.get()));
+      }
+    }
+    tt::runtime::ttnn::runProgram(device, *executable, inputs, outputs);
+  };
+  return Event(
+      ::tt::runtime::detail::getWorker(&device).enqueue(job, stream));
 }
 
-void wait(Event) { throw std::runtime_error("Not implemented"); }
-
 } // namespace tt::runtime::ttnn
@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/bfp.h"
+#include "tt/runtime/detail/tilize.h"
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using ::tt::runtime::detail::BfpFormat;
+
+static std::uint32_t toBits(float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static float fromBits(std::uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Reference packing written straight from the format description, using
+// wide integer arithmetic for the rounding.
+static std::vector<std::uint8_t> referencePack(std::vector<float> const &src,
+                                               BfpFormat format) {
+  std::uint32_t mantissaBits = format == BfpFormat::Bfp8 ? 7 : 3;
+  std::uint32_t tileSize = ::tt::runtime::detail::getBfpTileSizeBytes(format);
+  std::size_t numTiles = src.size() / 1024;
+  std::vector<std::uint8_t> packed(numTiles * tileSize);
+  for (std::size_t tile = 0; tile < numTiles; ++tile) {
+    std::uint8_t *exps = packed.data() + tile * tileSize;
+    std::uint8_t *mantissas = exps + 64;
+    for (std::size_t group = 0; group < 64; ++group) {
+      float const *values = src.data() + tile * 1024 + group * 16;
+      std::uint32_t sharedExp = 0;
+      for (int i = 0; i < 16; ++i) {
+        sharedExp = std::max(sharedExp, (toBits(values[i]) >> 23) & 0xFF);
+      }
+      exps[group] = sharedExp;
+      for (int i = 0; i < 16; ++i) {
+        std::uint32_t bits = toBits(values[i]);
+        std::uint32_t exp = (bits >> 23) & 0xFF;
+        std::uint64_t q = 0;
+        if (exp != 0) {
+          std::uint64_t mantissa = (bits & 0x7FFFFF) | 0x800000;
+          std::uint64_t shift = sharedExp - exp + 24 - mantissaBits;
+          // Scale by 2^40 so no bits are lost before rounding.
+          std::uint64_t scaled = shift >= 64 ? 0 : (mantissa << 40) >> shift;
+          std::uint64_t unit = std::uint64_t(1) << 40;
+          q = scaled / unit;
+          std::uint64_t rem = scaled % unit;
+          if (rem > unit / 2 or (rem == unit / 2 and q % 2 == 1)) {
+            ++q;
+          }
+          q = std::min<std::uint64_t>(q, (1u << mantissaBits) - 1);
+        }
+        std::uint32_t sign = q ? bits >> 31 : 0;
+        std::uint8_t value = sign << mantissaBits | q;
+        if (format == BfpFormat::Bfp8) {
+          mantissas[group * 16 + i] = value;
+        } else {
+          mantissas[group * 8 + i / 2] |= value << (4 * (i % 2));
+        }
+      }
+    }
+  }
+  return packed;
+}
+
+static std::vector<float> referenceUnpack(std::vector<std::uint8_t> const &src,
+                                          std::size_t numTiles,
+                                          BfpFormat format) {
+  std::uint32_t mantissaBits = format == BfpFormat::Bfp8 ? 7 : 3;
+  std::uint32_t tileSize = ::tt::runtime::detail::getBfpTileSizeBytes(format);
+  std::vector<float> values(numTiles * 1024);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    std::uint8_t const *exps = src.data() + (i / 1024) * tileSize;
+    std::uint32_t elem = i % 1024;
+    std::uint8_t value = format == BfpFormat::Bfp8
+                             ? exps[64 + elem]
+                             : (exps[64 + elem / 2] >> (4 * (elem % 2))) & 0xF;
+    std::uint32_t q = value & ((1u << mantissaBits) - 1);
+    float magnitude =
+        q * std::pow(2.0, int(exps[elem / 16]) - 127 - int(mantissaBits - 1));
+    values[i] = (value >> mantissaBits) & 1 ? -magnitude : magnitude;
+  }
+  return values;
+}
+
+// Values spanning several binades per group, with zeros, denormals, exact
+// rounding ties and values that round up past the largest mantissa.
+static std::vector<float> makeInput(std::size_t numTiles) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> uniform(-4.0f, 4.0f);
+  std::uniform_int_distribution<int> exponent(-20, 20);
+  std::vector<float> values(numTiles * 1024);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    switch (i % 11) {
+    case 0:
+      values[i] = 0.0f;
+      break;
+    case 1:
+      values[i] = -1e-40f;
+      break;
+    case 2:
+      values[i] = 1.0f + 1.0f / 128;
+      break;
+    case 3:
+      values[i] = -(2.0f - 1.0f / 512);
+      break;
+    default:
+      values[i] = std::ldexp(uniform(rng), exponent(rng));
+      break;
+    }
+  }
+  return values;
+}
+
+template <typename Fn> static void forEachSimdLevel(Fn fn) {
+  using ::tt::runtime::detail::SimdLevel;
+  SimdLevel supported = ::tt::runtime::detail::getSupportedSimdLevel();
+  for (SimdLevel level :
+       {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level > supported) {
+      continue;
+    }
+    ::tt::runtime::detail::setSimdLevel(level);
+    fn();
+  }
+  ::tt::runtime::detail::setSimdLevel(supported);
+}
+
+static void checkFormat(BfpFormat format, std::size_t numTiles) {
+  std::vector<float> input = makeInput(numTiles);
+  std::vector<std::uint8_t> expected = referencePack(input, format);
+  std::vector<float> expectedValues =
+      referenceUnpack(expected, numTiles, format);
+
+  // bfloat16 inputs are packed from their f32 widening.
+  std::vector<std::uint16_t> inputBf16(input.size());
+  std::vector<float> widened(input.size());
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    inputBf16[i] = toBits(input[i]) >> 16;
+    widened[i] = fromBits(std::uint32_t(inputBf16[i]) << 16);
+  }
+  std::vector<std::uint8_t> expectedBf16 = referencePack(widened, format);
+
+  forEachSimdLevel([&] {
+    std::vector<std::uint8_t> packed(expected.size(), 0xAB);
+    ::tt::runtime::detail::packBfp(
+        input.data(), reinterpret_cast<std::byte *>(packed.data()), numTiles,
+        format);
+    EXPECT_EQ(packed, expected);
+
+    std::vector<float> values(expectedValues.size());
+    ::tt::runtime::detail::unpackBfp(
+        reinterpret_cast<std::byte const *>(packed.data()), values.data(),
+        numTiles, format);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(toBits(values[i]), toBits(expectedValues[i])) << i;
+    }
+
+    std::vector<std::uint16_t> valuesBf16(values.size());
+    ::tt::runtime::detail::unpackBfp(
+        reinterpret_cast<std::byte const *>(packed.data()), valuesBf16.data(),
+        numTiles, format);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(valuesBf16[i], toBits(expectedValues[i]) >> 16) << i;
+    }
+
+    std::vector<std::uint8_t> packedBf16(expected.size(), 0xAB);
+    ::tt::runtime::detail::packBfp(
+        inputBf16.data(), reinterpret_cast<std::byte *>(packedBf16.data()),
+        numTiles, format);
+    EXPECT_EQ(packedBf16, expectedBf16);
+  });
+}
+
+TEST(RuntimeBfp, TileSize) {
+  EXPECT_EQ(::tt::runtime::detail::getBfpTileSizeBytes(BfpFormat::Bfp8),
+            1088u);
+  EXPECT_EQ(::tt::runtime::detail::getBfpTileSizeBytes(BfpFormat::Bfp4),
+            576u);
+}
+
+TEST(RuntimeBfp, Bfp8MatchesReference) { checkFormat(BfpFormat::Bfp8, 3); }
+
+TEST(RuntimeBfp, Bfp4MatchesReference) { checkFormat(BfpFormat::Bfp4, 3); }
+
+TEST(RuntimeBfp, SplitAcrossThreads) {
+  checkFormat(BfpFormat::Bfp8, 600);
+  checkFormat(BfpFormat::Bfp4, 600);
+}
+
+TEST(RuntimeBfp, RepresentableValuesRoundTrip) {
+  // A group sharing one exponent whose values all fit in the mantissa comes
+  // back unchanged.
+  std::vector<float> input(1024);
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    float magnitude = std::ldexp(float(i % 128), int(i / 16 % 8) - 3);
+    input[i] = i % 2 ? -magnitude : magnitude;
+  }
+  for (std::size_t group = 0; group < 64; ++group) {
+    input[group * 16] = std::ldexp(127.0f, int(group % 8) - 3);
+  }
+  std::vector<std::byte> packed(
+      ::tt::runtime::detail::getBfpTileSizeBytes(BfpFormat::Bfp8));
+  ::tt::runtime::detail::packBfp(input.data(), packed.data(), 1,
+                                 BfpFormat::Bfp8);
+  std::vector<float> output(input.size());
+  ::tt::runtime::detail::unpackBfp(packed.data(), output.data(), 1,
+                                   BfpFormat::Bfp8);
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(std::fabs(output[i]), std::fabs(input[i])) << i;
+  }
+}
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/binary_registry.h"
+#include <atomic>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ::tt::runtime::detail::BinaryRegistry;
+using ::tt::runtime::detail::hashBytes;
+
+namespace {
+std::shared_ptr<void> makeBuffer(std::string const &contents) {
+  std::shared_ptr<char> buffer(new char[contents.size()],
+                               std::default_delete<char[]>());
+  std::memcpy(buffer.get(), contents.data(), contents.size());
+  return buffer;
+}
+
+BinaryRegistry::Entry intern(BinaryRegistry &registry,
+                             std::shared_ptr<void> buffer, std::size_t size,
+                             int &creates) {
+  return registry.intern(buffer, size, [&creates]() {
+    ++creates;
+    return std::make_shared<int>(creates);
+  });
+}
+} // namespace
+
+TEST(BinaryRegistry, HashMatchesReference) {
+  EXPECT_EQ(hashBytes("", 0), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(hashBytes("a", 1), 0xD24EC4F1A98C6E5BULL);
+  EXPECT_EQ(hashBytes("abc", 3), 0x44BC2CF5AD770999ULL);
+}
+
+TEST(BinaryRegistry, HashCoversEveryByte) {
+  std::vector<std::uint8_t> data(1000, 7);
+  std::uint64_t base = hashBytes(data.data(), data.size());
+  for (std::size_t i : {0, 31, 32, 500, 996, 999}) {
+    data[i] ^= 1;
+    EXPECT_NE(hashBytes(data.data(), data.size()), base) << i;
+    data[i] ^= 1;
+  }
+  EXPECT_NE(hashBytes(data.data(), data.size() - 1), base);
+}
+
+TEST(BinaryRegistry, SameContentsShareEntry) {
+  BinaryRegistry registry(1024);
+  int creates = 0;
+  auto first = makeBuffer("model");
+  auto second = makeBuffer("model");
+  auto a = intern(registry, first, 5, creates);
+  auto b = intern(registry, second, 5, creates);
+  EXPECT_EQ(creates, 1);
+  EXPECT_EQ(a.handle, first);
+  EXPECT_EQ(b.handle, first);
+  EXPECT_EQ(a.state, b.state);
+  EXPECT_EQ(registry.getNumEntries(), 1u);
+  EXPECT_EQ(registry.getSizeBytes(), 5u);
+
+  auto other = intern(registry, makeBuffer("other"), 5, creates);
+  EXPECT_EQ(creates, 2);
+  EXPECT_NE(other.state, a.state);
+}
+
+TEST(BinaryRegistry, HashCollisionsAreNotShared) {
+  BinaryRegistry registry(1024,
+                          [](void const *, std::size_t, std::uint64_t) {
+                            return std::uint64_t(42);
+                          });
+  int creates = 0;
+  auto first = makeBuffer("model");
+  auto a = intern(registry, first, 5, creates);
+  auto b = intern(registry, makeBuffer("other"), 5, creates);
+  EXPECT_EQ(creates, 2);
+  EXPECT_NE(b.handle, first);
+  EXPECT_NE(b.state, a.state);
+  EXPECT_EQ(registry.getNumEntries(), 1u);
+
+  auto c = intern(registry, makeBuffer("model"), 5, creates);
+  EXPECT_EQ(creates, 2);
+  EXPECT_EQ(c.handle, first);
+  EXPECT_EQ(c.state, a.state);
+}
+
+TEST(BinaryRegistry, EvictsLeastRecentlyUsed) {
+  BinaryRegistry registry(10);
+  int creates = 0;
+  auto a = intern(registry, makeBuffer("aaaa"), 4, creates);
+  intern(registry, makeBuffer("bbbb"), 4, creates);
+  // Touch a so that b is the oldest.
+  intern(registry, makeBuffer("aaaa"), 4, creates);
+  intern(registry, makeBuffer("cccc"), 4, creates);
+  EXPECT_EQ(creates, 3);
+  EXPECT_EQ(registry.getNumEntries(), 2u);
+  EXPECT_EQ(registry.getSizeBytes(), 8u);
+
+  EXPECT_EQ(intern(registry, makeBuffer("aaaa"), 4, creates).state, a.state);
+  intern(registry, makeBuffer("bbbb"), 4, creates);
+  EXPECT_EQ(creates, 4);
+}
+
+TEST(BinaryRegistry, OversizedAndDisabled) {
+  BinaryRegistry registry(4);
+  int creates = 0;
+  intern(registry, makeBuffer("too large"), 9, creates);
+  EXPECT_EQ(registry.getNumEntries(), 0u);
+
+  registry.setCapacity(0);
+  intern(registry, makeBuffer("ab"), 2, creates);
+  intern(registry, makeBuffer("ab"), 2, creates);
+  EXPECT_EQ(creates, 3);
+  EXPECT_EQ(registry.getNumEntries(), 0u);
+}
+
+TEST(BinaryRegistry, ShrinkingCapacityEvicts) {
+  BinaryRegistry registry(100);
+  int creates = 0;
+  for (char c : std::string("abcd")) {
+    intern(registry, makeBuffer(std::string(10, c)), 10, creates);
+  }
+  registry.setCapacity(25);
+  EXPECT_EQ(registry.getNumEntries(), 2u);
+  registry.clear();
+  EXPECT_EQ(registry.getSizeBytes(), 0u);
+}
+
+TEST(BinaryRegistry, FailedCreateIsNotRegistered) {
+  BinaryRegistry registry(100);
+  auto buffer = makeBuffer("bad");
+  EXPECT_THROW(registry.intern(buffer, 3,
+                               []() -> std::shared_ptr<void> {
+                                 throw std::runtime_error("invalid");
+                               }),
+               std::runtime_error);
+  EXPECT_EQ(registry.getNumEntries(), 0u);
+}
+
+TEST(BinaryRegistry, ConcurrentLoadsShareState) {
+  BinaryRegistry registry(1 << 20);
+  std::atomic<int> creates = 0;
+  std::vector<std::shared_ptr<void>> states(8);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      auto entry =
+          registry.intern(makeBuffer("shared model"), 12, [&creates]() {
+            ++creates;
+            return std::make_shared<int>(0);
+          });
+      states[i] = entry.state;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_GE(creates.load(), 1);
+  for (auto &state : states) {
+    EXPECT_EQ(state, states.front());
+  }
+}
@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/capture.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using ::tt::runtime::detail::CaptureBinary;
+using ::tt::runtime::detail::CaptureReader;
+using ::tt::runtime::detail::CaptureSubmit;
+using ::tt::runtime::detail::CaptureTensor;
+using ::tt::runtime::detail::CaptureWriter;
+using ::tt::runtime::detail::getCaptureTensorSize;
+using ::tt::runtime::detail::kCaptureAlignment;
+
+namespace {
+std::string getTempPath(char const *name) {
+  return ::testing::TempDir() + name + std::to_string(::getpid());
+}
+
+CaptureTensor makeTensor(std::vector<float> const &data,
+                         std::vector<std::uint32_t> shape) {
+  CaptureTensor tensor;
+  tensor.shape = shape;
+  tensor.stride.assign(shape.size(), 1);
+  for (int i = int(shape.size()) - 2; i >= 0; --i) {
+    tensor.stride[i] = tensor.stride[i + 1] * shape[i + 1];
+  }
+  tensor.itemsize = sizeof(float);
+  tensor.data = data.data();
+  tensor.sizeBytes = data.size() * sizeof(float);
+  return tensor;
+}
+} // namespace
+
+TEST(Capture, TensorSizeFollowsStrides) {
+  EXPECT_EQ(getCaptureTensorSize({4, 8}, {8, 1}, 4), 128u);
+  // Padded rows span the stride of every row but the last.
+  EXPECT_EQ(getCaptureTensorSize({4, 8}, {16, 1}, 2), (3 * 16 + 8) * 2u);
+  EXPECT_EQ(getCaptureTensorSize({}, {}, 4), 4u);
+  EXPECT_EQ(getCaptureTensorSize({0, 8}, {8, 1}, 4), 0u);
+}
+
+TEST(Capture, RoundTrip) {
+  std::string path = getTempPath("capture_round_trip");
+  std::string program = "not a real flatbuffer";
+  std::vector<float> a(32 * 32);
+  std::iota(a.begin(), a.end(), 0.0f);
+  std::vector<float> b(3, -1.0f);
+  {
+    CaptureWriter writer(path.c_str());
+    EXPECT_FALSE(writer.hasBinary(42));
+    writer.writeBinary({42, program.data(), program.size()});
+    EXPECT_TRUE(writer.hasBinary(42));
+    // Binaries are only written once.
+    writer.writeBinary({42, program.data(), program.size()});
+    for (std::uint32_t i = 0; i < 3; ++i) {
+      CaptureSubmit submit;
+      submit.timestampNs = 1000 * i;
+      submit.binaryHash = 42;
+      submit.programIndex = i;
+      submit.stream = 1;
+      submit.inputs = {makeTensor(a, {32, 32}), makeTensor(b, {3})};
+      writer.writeSubmit(submit);
+    }
+  }
+
+  CaptureReader reader(path.c_str());
+  ASSERT_EQ(reader.getBinaries().size(), 1u);
+  CaptureBinary const &binary = reader.getBinaries()[0];
+  EXPECT_EQ(binary.hash, 42u);
+  EXPECT_EQ(std::string(static_cast<char const *>(binary.data), binary.size),
+            program);
+  ASSERT_EQ(reader.getSubmits().size(), 3u);
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    CaptureSubmit const &submit = reader.getSubmits()[i];
+    EXPECT_EQ(submit.timestampNs, 1000u * i);
+    EXPECT_EQ(submit.binaryHash, 42u);
+    EXPECT_EQ(submit.programIndex, i);
+    EXPECT_EQ(submit.stream, 1u);
+    ASSERT_EQ(submit.inputs.size(), 2u);
+    CaptureTensor const &input = submit.inputs[0];
+    EXPECT_EQ(input.shape, (std::vector<std::uint32_t>{32, 32}));
+    EXPECT_EQ(input.stride, (std::vector<std::uint32_t>{32, 1}));
+    EXPECT_EQ(input.itemsize, sizeof(float));
+    ASSERT_EQ(input.sizeBytes, a.size() * sizeof(float));
+    EXPECT_EQ(std::memcmp(input.data, a.data(), input.sizeBytes), 0);
+    EXPECT_EQ(submit.inputs[1].shape, (std::vector<std::uint32_t>{3}));
+    EXPECT_EQ(std::memcmp(submit.inputs[1].data, b.data(), 3 * sizeof(float)),
+              0);
+    for (CaptureTensor const &tensor : submit.inputs) {
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(tensor.data) %
+                    kCaptureAlignment,
+                0u);
+    }
+  }
+  std::remove(path.c_str());
+}
+
+TEST(Capture, TruncatedLastRecordIsDropped) {
+  std::string path = getTempPath("capture_truncated");
+  std::vector<float> a(1024, 1.0f);
+  {
+    CaptureWriter writer(path.c_str());
+    writer.writeBinary({7, a.data(), 16});
+    for (int i = 0; i < 2; ++i) {
+      CaptureSubmit submit;
+      submit.binaryHash = 7;
+      submit.inputs = {makeTensor(a, {1024})};
+      writer.writeSubmit(submit);
+    }
+  }
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  std::size_t size = in.tellg();
+  in.close();
+  ASSERT_EQ(::truncate(path.c_str(), size - 100), 0);
+
+  CaptureReader reader(path.c_str());
+  EXPECT_EQ(reader.getBinaries().size(), 1u);
+  EXPECT_EQ(reader.getSubmits().size(), 1u);
+  std::remove(path.c_str());
+}
+
+// Each thread's submissions to its stream are numbered in enqueue order,
+// kept in the program index here.
+TEST(Capture, ConcurrentSubmitsStayOrdered) {
+  std::string path = getTempPath("capture_concurrent");
+  std::vector<float> a(64, 1.0f);
+  std::atomic<std::uint64_t> clock = 0;
+  {
+    CaptureWriter writer(path.c_str());
+    std::vector<std::thread> threads;
+    for (std::uint32_t stream = 0; stream < 4; ++stream) {
+      threads.emplace_back([&, stream] {
+        for (std::uint32_t i = 0; i < 50; ++i) {
+          std::unique_lock<std::mutex> order = writer.orderSubmits();
+          CaptureSubmit submit;
+          submit.timestampNs = clock.fetch_add(1);
+          submit.programIndex = i;
+          submit.stream = stream;
+          submit.inputs = {makeTensor(a, {64})};
+          writer.writeSubmit(submit);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  CaptureReader reader(path.c_str());
+  std::vector<CaptureSubmit> const &submits = reader.getSubmits();
+  ASSERT_EQ(submits.size(), 200u);
+  std::vector<std::uint32_t> next(4, 0);
+  for (std::size_t i = 0; i < submits.size(); ++i) {
+    if (i > 0) {
+      EXPECT_LT(submits[i - 1].timestampNs, submits[i].timestampNs);
+    }
+    EXPECT_EQ(submits[i].programIndex, next[submits[i].stream]++);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(Capture, RejectsOtherFiles) {
+  std::string path = getTempPath("capture_other");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "definitely not a capture file";
+  }
+  EXPECT_THROW(CaptureReader(path.c_str()), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(CaptureReader(path.c_str()), std::runtime_error);
+}
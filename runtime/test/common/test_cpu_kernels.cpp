@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/cpu_kernels.h"
+#include "tt/runtime/detail/tilize.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace detail = ::tt::runtime::detail;
+using detail::BinaryKernel;
+using detail::KernelShape;
+
+namespace {
+std::vector<float> randomValues(std::size_t size, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+  std::vector<float> values(size);
+  for (float &value : values) {
+    value = dist(rng);
+  }
+  return values;
+}
+
+// Runs a test body at every SIMD level the host supports.
+class CpuKernels : public ::testing::TestWithParam<detail::SimdLevel> {
+protected:
+  void SetUp() override {
+    if (GetParam() > detail::getSupportedSimdLevel()) {
+      GTEST_SKIP() << "SIMD level not supported by the host";
+    }
+    detail::setSimdLevel(GetParam());
+  }
+  void TearDown() override {
+    detail::setSimdLevel(detail::getSupportedSimdLevel());
+  }
+};
+} // namespace
+
+TEST(CpuKernelShapes, Broadcast) {
+  EXPECT_EQ(detail::broadcastShapes({4, 1, 3}, {5, 1}),
+            (KernelShape{4, 5, 3}));
+  EXPECT_EQ(detail::broadcastShapes({}, {2, 2}), (KernelShape{2, 2}));
+  EXPECT_THROW(detail::broadcastShapes({2, 3}, {4, 3}), std::runtime_error);
+  EXPECT_EQ(detail::getMatmulShape({3, 1, 4, 5}, {2, 5, 6}),
+            (KernelShape{3, 2, 4, 6}));
+  EXPECT_THROW(detail::getMatmulShape({4, 5}, {4, 6}), std::runtime_error);
+}
+
+TEST_P(CpuKernels, BinarySameShape) {
+  KernelShape shape = {7, 28571};
+  std::size_t size = detail::getVolume(shape);
+  auto lhs = randomValues(size, 1);
+  auto rhs = randomValues(size, 2);
+  std::vector<float> out(size);
+  detail::binary(BinaryKernel::Subtract, lhs.data(), shape, rhs.data(), shape,
+                 out.data(), shape);
+  for (std::size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(out[i], lhs[i] - rhs[i]) << i;
+  }
+  detail::binary(BinaryKernel::GreaterEqual, lhs.data(), shape, rhs.data(),
+                 shape, out.data(), shape);
+  for (std::size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(out[i], lhs[i] >= rhs[i] ? 1.0f : 0.0f) << i;
+  }
+}
+
+TEST_P(CpuKernels, BinaryBroadcast) {
+  KernelShape lhsShape = {3, 1, 5};
+  KernelShape rhsShape = {4, 1};
+  KernelShape outShape = {3, 4, 5};
+  auto lhs = randomValues(15, 3);
+  auto rhs = randomValues(4, 4);
+  std::vector<float> out(60);
+  detail::binary(BinaryKernel::Multiply, lhs.data(), lhsShape, rhs.data(),
+                 rhsShape, out.data(), outShape);
+  for (std::uint32_t a = 0; a < 3; ++a) {
+    for (std::uint32_t b = 0; b < 4; ++b) {
+      for (std::uint32_t c = 0; c < 5; ++c) {
+        EXPECT_EQ(out[(a * 4 + b) * 5 + c], lhs[a * 5 + c] * rhs[b]);
+      }
+    }
+  }
+
+  // In place, as used for bias.
+  std::vector<float> bias = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+  std::vector<float> expected = out;
+  detail::binary(BinaryKernel::Add, out.data(), outShape, bias.data(), {5},
+                 out.data(), outShape);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    EXPECT_EQ(out[i], expected[i] + bias[i % 5]);
+  }
+  EXPECT_THROW(detail::binary(BinaryKernel::Add, lhs.data(), lhsShape,
+                              rhs.data(), rhsShape, out.data(), {3, 4, 1}),
+               std::runtime_error);
+}
+
+TEST_P(CpuKernels, Relu) {
+  auto in = randomValues(100000, 5);
+  std::vector<float> out(in.size());
+  detail::unary(detail::UnaryKernel::Relu, in.data(), out.data(), in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    ASSERT_EQ(out[i], in[i] > 0.0f ? in[i] : 0.0f);
+  }
+}
+
+TEST_P(CpuKernels, MatmulMatchesNaive) {
+  KernelShape lhsShape = {2, 1, 37, 300};
+  KernelShape rhsShape = {3, 300, 290};
+  KernelShape outShape = detail::getMatmulShape(lhsShape, rhsShape);
+  auto lhs = randomValues(detail::getVolume(lhsShape), 6);
+  auto rhs = randomValues(detail::getVolume(rhsShape), 7);
+  std::vector<float> out(detail::getVolume(outShape));
+  detail::matmul(lhs.data(), lhsShape, rhs.data(), rhsShape, out.data());
+  std::uint32_t m = 37, k = 300, n = 290;
+  for (std::uint32_t a = 0; a < 2; ++a) {
+    for (std::uint32_t b = 0; b < 3; ++b) {
+      float const *l = lhs.data() + a * m * k;
+      float const *r = rhs.data() + b * k * n;
+      float const *o = out.data() + (a * 3 + b) * m * n;
+      for (std::uint32_t i = 0; i < m; i += 5) {
+        for (std::uint32_t j = 0; j < n; j += 7) {
+          double expected = 0.0;
+          for (std::uint32_t x = 0; x < k; ++x) {
+            expected += double(l[i * k + x]) * r[x * n + j];
+          }
+          ASSERT_NEAR(o[i * n + j], expected, 1e-3) << a << b << i << j;
+        }
+      }
+    }
+  }
+}
+
+TEST_P(CpuKernels, Sum) {
+  KernelShape shape = {3, 4, 5};
+  std::vector<float> in(60);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    in[i] = float(i);
+  }
+  std::vector<float> out(20);
+  detail::sum(in.data(), shape, {1}, out.data());
+  for (std::uint32_t a = 0; a < 3; ++a) {
+    for (std::uint32_t c = 0; c < 5; ++c) {
+      float expected = 0.0f;
+      for (std::uint32_t b = 0; b < 4; ++b) {
+        expected += in[(a * 4 + b) * 5 + c];
+      }
+      EXPECT_EQ(out[a * 5 + c], expected);
+    }
+  }
+  detail::sum(in.data(), shape, {-1, 0}, out.data());
+  for (std::uint32_t b = 0; b < 4; ++b) {
+    float expected = 0.0f;
+    for (std::uint32_t a = 0; a < 3; ++a) {
+      for (std::uint32_t c = 0; c < 5; ++c) {
+        expected += in[(a * 4 + b) * 5 + c];
+      }
+    }
+    EXPECT_EQ(out[b], expected);
+  }
+  detail::sum(in.data(), shape, {}, out.data());
+  EXPECT_EQ(out[0], 59.0f * 60.0f / 2.0f);
+  EXPECT_THROW(detail::sum(in.data(), shape, {3}, out.data()),
+               std::runtime_error);
+}
+
+TEST_P(CpuKernels, Softmax) {
+  KernelShape shape = {2, 3, 4};
+  auto in = randomValues(24, 8);
+  for (std::int32_t dim : {-1, 1, 0}) {
+    std::vector<float> out(24);
+    detail::softmax(in.data(), shape, dim, out.data());
+    std::uint32_t axis = dim < 0 ? dim + 3 : dim;
+    std::uint32_t inner = axis == 2 ? 1 : (axis == 1 ? 4 : 12);
+    std::uint32_t extent = shape[axis];
+    for (std::uint32_t i = 0; i < 24; ++i) {
+      std::uint32_t start = i - ((i / inner) % extent) * inner;
+      double total = 0.0;
+      for (std::uint32_t d = 0; d < extent; ++d) {
+        total += std::exp(double(in[start + d * inner]));
+      }
+      EXPECT_NEAR(out[i], std::exp(double(in[i])) / total, 1e-6);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SimdLevels, CpuKernels,
+                         ::testing::Values(detail::SimdLevel::Scalar,
+                                           detail::SimdLevel::AVX2,
+                                           detail::SimdLevel::AVX512));
+
+TEST(CpuKernelConversions, BFloat16RoundTrip) {
+  std::vector<float> values = {1.0f, -2.5f, 3.14159f, 1e-20f, 65504.0f,
+                               std::nanf("")};
+  std::vector<std::uint16_t> bits(values.size());
+  detail::floatToBf16(values.data(), bits.data(), values.size());
+  EXPECT_EQ(bits[0], 0x3f80);
+  EXPECT_EQ(bits[1], 0xc020);
+  // 3.14159 rounds to the nearest bfloat16, 3.140625.
+  EXPECT_EQ(bits[2], 0x4049);
+  std::vector<float> back(values.size());
+  detail::bf16ToFloat(bits.data(), back.data(), bits.size());
+  for (std::size_t i = 0; i + 1 < values.size(); ++i) {
+    EXPECT_NEAR(back[i], values[i], std::abs(values[i]) / 128.0f);
+  }
+  EXPECT_TRUE(std::isnan(back.back()));
+}
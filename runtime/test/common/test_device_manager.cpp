@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/device_manager.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using ::tt::runtime::detail::DeviceManager;
+using ::tt::runtime::detail::SystemDescCache;
+
+namespace {
+// Stands in for the backend, counting how often devices are initialized.
+struct FakeBackend {
+  int devices[4] = {};
+  int opens = 0;
+  int closes = 0;
+
+  DeviceManager makeManager() {
+    return DeviceManager(
+        [this](int deviceId) -> void * {
+          ++opens;
+          return &devices[deviceId];
+        },
+        [this](void *) { ++closes; });
+  }
+};
+
+SystemDescCache::Buffer makeBuffer(char const *contents) {
+  std::size_t size = std::strlen(contents);
+  std::shared_ptr<void> data(std::malloc(size), std::free);
+  std::memcpy(data.get(), contents, size);
+  return {data, size};
+}
+
+std::string toString(SystemDescCache::Buffer const &buffer) {
+  return std::string(static_cast<char const *>(buffer.first.get()),
+                     buffer.second);
+}
+
+bool acceptAll(void const *, std::size_t) { return true; }
+} // namespace
+
+TEST(RuntimeDeviceManager, RefCountedAcrossUsers) {
+  FakeBackend backend;
+  DeviceManager manager = backend.makeManager();
+  void *first = manager.acquire(0);
+  void *second = manager.acquire(0);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(backend.opens, 1);
+  EXPECT_EQ(manager.getRefCount(0), 2u);
+
+  manager.release(first);
+  EXPECT_EQ(backend.closes, 0);
+  manager.release(second);
+  EXPECT_EQ(backend.closes, 1);
+  EXPECT_THROW(manager.release(second), std::runtime_error);
+}
+
+TEST(RuntimeDeviceManager, BorrowedDeviceIsReused) {
+  FakeBackend backend;
+  {
+    DeviceManager manager = backend.makeManager();
+    void *queried = manager.borrow(1);
+    EXPECT_EQ(manager.getRefCount(1), 0u);
+    // Opening after a query does not initialize the device again.
+    void *opened = manager.acquire(1);
+    EXPECT_EQ(queried, opened);
+    EXPECT_EQ(backend.opens, 1);
+    manager.release(opened);
+    EXPECT_EQ(backend.closes, 1);
+
+    manager.borrow(2);
+    manager.acquire(3);
+  }
+  // Idle devices are closed with the manager, referenced ones are not.
+  EXPECT_EQ(backend.closes, 2);
+}
+
+TEST(RuntimeDeviceManager, FailedOpenIsNotKept) {
+  int closes = 0;
+  bool fail = true;
+  int device = 0;
+  {
+    DeviceManager manager(
+        [&](int) -> void * {
+          if (fail) {
+            throw std::runtime_error("no device");
+          }
+          return &device;
+        },
+        [&](void *closed) {
+          EXPECT_EQ(closed, &device);
+          ++closes;
+        });
+    EXPECT_THROW(manager.acquire(0), std::runtime_error);
+    EXPECT_EQ(manager.getRefCount(0), 0u);
+    manager.closeIdle();
+    EXPECT_EQ(closes, 0);
+
+    fail = false;
+    EXPECT_EQ(manager.acquire(0), &device);
+    EXPECT_EQ(manager.getRefCount(0), 1u);
+    manager.release(&device);
+  }
+  EXPECT_EQ(closes, 1);
+}
+
+TEST(RuntimeSystemDescCache, InProcess) {
+  SystemDescCache cache("");
+  int creates = 0;
+  auto create = [&creates] {
+    ++creates;
+    return makeBuffer("desc");
+  };
+  EXPECT_EQ(toString(cache.getOrCreate("a", create, acceptAll)), "desc");
+  EXPECT_EQ(toString(cache.getOrCreate("a", create, acceptAll)), "desc");
+  EXPECT_EQ(creates, 1);
+  cache.getOrCreate("b", create, acceptAll);
+  EXPECT_EQ(creates, 2);
+}
+
+TEST(RuntimeSystemDescCache, OnDisk) {
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() /
+      ("ttrt-sysdesc-" + std::to_string(::getpid()));
+  std::filesystem::remove_all(directory);
+
+  int creates = 0;
+  auto create = [&creates] {
+    ++creates;
+    return makeBuffer("desc");
+  };
+  SystemDescCache(directory.string()).getOrCreate("a", create, acceptAll);
+  EXPECT_TRUE(std::filesystem::exists(directory / "a.ttsys"));
+
+  // A new process finds the entry on disk.
+  EXPECT_EQ(toString(SystemDescCache(directory.string())
+                         .getOrCreate("a", create, acceptAll)),
+            "desc");
+  EXPECT_EQ(creates, 1);
+
+  // Entries failing verification are recreated.
+  auto rejectAll = [](void const *, std::size_t) { return false; };
+  SystemDescCache(directory.string()).getOrCreate("a", create, rejectAll);
+  EXPECT_EQ(creates, 2);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(RuntimeSystemDescCache, Fingerprint) {
+  std::string fingerprint =
+      ::tt::runtime::detail::getDeviceFingerprint({0}, "abc");
+  EXPECT_EQ(fingerprint,
+            ::tt::runtime::detail::getDeviceFingerprint({0}, "abc"));
+  EXPECT_NE(fingerprint,
+            ::tt::runtime::detail::getDeviceFingerprint({1}, "abc"));
+  EXPECT_NE(fingerprint,
+            ::tt::runtime::detail::getDeviceFingerprint({0}, "abd"));
+}
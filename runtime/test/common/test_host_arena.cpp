@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/host_arena.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using ::tt::runtime::detail::HostArena;
+
+TEST(HostArena, SizeClasses) {
+  EXPECT_EQ(HostArena::getSizeClass(0), 64u);
+  EXPECT_EQ(HostArena::getSizeClass(64), 64u);
+  EXPECT_EQ(HostArena::getSizeClass(65), 128u);
+  EXPECT_EQ(HostArena::getSizeClass(200), 256u);
+  EXPECT_EQ(HostArena::getSizeClass(1000), 1024u);
+  EXPECT_EQ(HostArena::getSizeClass(5000), 5120u);
+  EXPECT_EQ(HostArena::getSizeClass(1 << 20), std::size_t(1) << 20);
+  for (std::size_t size = 1; size < (1 << 16); size += 37) {
+    std::size_t sizeClass = HostArena::getSizeClass(size);
+    EXPECT_GE(sizeClass, size);
+    EXPECT_EQ(sizeClass % 64, 0u);
+    if (size > 64) {
+      EXPECT_LE(sizeClass, size + size / 4 + 64) << size;
+    }
+  }
+}
+
+TEST(HostArena, Alignment) {
+  HostArena arena;
+  std::uintptr_t pageSize = ::sysconf(_SC_PAGESIZE);
+  for (std::size_t size : {1, 100, 3000}) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.allocate(size).get()) % 64,
+              0u);
+  }
+  for (std::size_t size : {pageSize, 3 * pageSize + 1, pageSize << 8}) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.allocate(size).get()) %
+                  pageSize,
+              0u);
+  }
+}
+
+TEST(HostArena, RecyclesWhenLastReferenceDrops) {
+  HostArena arena;
+  std::shared_ptr<void> first = arena.allocate(1000);
+  void *address = first.get();
+  std::shared_ptr<void> copy = first;
+  first.reset();
+  EXPECT_EQ(arena.getFreeBytes(), 0u);
+  copy.reset();
+  EXPECT_EQ(arena.getFreeBytes(), 1024u);
+
+  // Same size class, same buffer, no new system allocation.
+  std::shared_ptr<void> second = arena.allocate(900);
+  EXPECT_EQ(second.get(), address);
+  EXPECT_EQ(arena.getNumSystemAllocations(), 1u);
+  EXPECT_EQ(arena.getFreeBytes(), 0u);
+
+  // A different size class does not reuse it.
+  std::shared_ptr<void> other = arena.allocate(100);
+  EXPECT_NE(other.get(), address);
+  EXPECT_EQ(arena.getNumSystemAllocations(), 2u);
+}
+
+TEST(HostArena, SteadyStateDoesNotAllocate) {
+  HostArena arena;
+  for (int i = 0; i < 100; ++i) {
+    std::vector<std::shared_ptr<void>> outputs;
+    for (std::size_t size : {4096, 4096, 128, 1 << 20}) {
+      outputs.push_back(arena.allocate(size));
+    }
+  }
+  EXPECT_EQ(arena.getNumSystemAllocations(), 4u);
+}
+
+TEST(HostArena, Capacity) {
+  HostArena arena(1024);
+  std::shared_ptr<void> small = arena.allocate(1024);
+  std::shared_ptr<void> large = arena.allocate(4096);
+  small.reset();
+  large.reset();
+  // Only what fits in the capacity is kept.
+  EXPECT_EQ(arena.getFreeBytes(), 1024u);
+  arena.setCapacity(0);
+  EXPECT_EQ(arena.getFreeBytes(), 0u);
+  arena.allocate(1024).reset();
+  EXPECT_EQ(arena.getFreeBytes(), 0u);
+  EXPECT_EQ(arena.getNumSystemAllocations(), 3u);
+
+  arena.setCapacity(1 << 20);
+  arena.allocate(1024).reset();
+  EXPECT_EQ(arena.getFreeBytes(), 1024u);
+  arena.trim();
+  EXPECT_EQ(arena.getFreeBytes(), 0u);
+}
+
+TEST(HostArena, BuffersOutliveArena) {
+  std::shared_ptr<void> buffer;
+  {
+    HostArena arena;
+    buffer = arena.allocate(256);
+  }
+  static_cast<char *>(buffer.get())[255] = 1;
+  buffer.reset();
+}
+
+TEST(HostArena, ConcurrentUse) {
+  HostArena arena;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&arena, t]() {
+      for (int i = 0; i < 1000; ++i) {
+        std::shared_ptr<void> buffer = arena.allocate(64 * (1 + (i + t) % 16));
+        static_cast<char *>(buffer.get())[0] = char(i);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  // At most one buffer per thread and size class is ever live.
+  EXPECT_LE(arena.getNumSystemAllocations(), 8u * 16u);
+}
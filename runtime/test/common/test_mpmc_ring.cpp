@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/mpmc_ring.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using ::tt::runtime::detail::MpmcRing;
+
+TEST(MpmcRing, FifoUntilFull) {
+  MpmcRing<int> ring(4);
+  EXPECT_TRUE(ring.empty());
+  for (int i = 0; i < 4; ++i) {
+    int value = i;
+    EXPECT_TRUE(ring.tryPush(value));
+  }
+  int extra = 4;
+  EXPECT_FALSE(ring.tryPush(extra));
+  EXPECT_EQ(extra, 4);
+  for (int i = 0; i < 4; ++i) {
+    int value = -1;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  int value = -1;
+  EXPECT_FALSE(ring.tryPop(value));
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(MpmcRing, WrapsAround) {
+  MpmcRing<int> ring(2);
+  for (int i = 0; i < 100; ++i) {
+    int value = i;
+    ASSERT_TRUE(ring.tryPush(value));
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, i);
+  }
+}
+
+TEST(MpmcRing, PopReleasesSlot) {
+  MpmcRing<std::shared_ptr<int>> ring(2);
+  auto shared = std::make_shared<int>(1);
+  auto copy = shared;
+  ring.tryPush(copy);
+  std::shared_ptr<int> out;
+  ring.tryPop(out);
+  out.reset();
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(MpmcRing, RejectsInvalidCapacity) {
+  EXPECT_THROW(MpmcRing<int>(3), std::invalid_argument);
+  EXPECT_THROW(MpmcRing<int>(1), std::invalid_argument);
+}
+
+TEST(MpmcRing, ConcurrentProducersAndConsumers) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 20000;
+  MpmcRing<int> ring(64);
+  std::atomic<long> sum = 0;
+  std::atomic<int> popped = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&ring, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        int value = t * kPerThread + i;
+        while (not ring.tryPush(value)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&] {
+      int value;
+      while (popped.load() < kThreads * kPerThread) {
+        if (ring.tryPop(value)) {
+          sum += value;
+          ++popped;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  long n = long(kThreads) * kPerThread;
+  EXPECT_EQ(popped.load(), n);
+  EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+}
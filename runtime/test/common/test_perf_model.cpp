@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/perf_model.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using ::tt::runtime::PerfEstimate;
+using ::tt::runtime::detail::PerfBuffer;
+using ::tt::runtime::detail::PerfChip;
+using ::tt::runtime::detail::PerfCore;
+using ::tt::runtime::detail::PerfDispatch;
+using ::tt::runtime::detail::PerfKernel;
+using ::tt::runtime::detail::PerfMemory;
+
+static PerfBuffer makeBuffer(std::uint64_t tiles, PerfMemory memory) {
+  PerfBuffer buffer;
+  buffer.tiles = tiles;
+  buffer.bytes = tiles * 32 * 32 * 2;
+  buffer.memory = memory;
+  return buffer;
+}
+
+// A reader, a writer and a compute kernel on the same core range, the way
+// the TTMetal lowering emits them.
+static PerfDispatch makeEltwise(std::uint32_t height, std::uint32_t width,
+                                std::uint64_t tiles, PerfMemory memory) {
+  PerfDispatch dispatch;
+  for (PerfCore core : {PerfCore::Noc0, PerfCore::Noc1, PerfCore::Compute}) {
+    PerfKernel kernel;
+    kernel.core = core;
+    kernel.height = height;
+    kernel.width = width;
+    dispatch.kernels.push_back(kernel);
+  }
+  for (int i = 0; i < 3; ++i) {
+    dispatch.operands.push_back(makeBuffer(tiles, memory));
+  }
+  return dispatch;
+}
+
+TEST(PerfModel, LatencyIsOverheadPlusSlowestComponent) {
+  PerfChip chip;
+  PerfEstimate estimate = ::tt::runtime::detail::estimateDispatch(
+      chip, makeEltwise(8, 8, 4096, PerfMemory::DRAM));
+  EXPECT_GT(estimate.dramNs, 0.0);
+  EXPECT_GT(estimate.nocNs, 0.0);
+  EXPECT_GT(estimate.computeNs, 0.0);
+  EXPECT_DOUBLE_EQ(estimate.latencyNs,
+                   estimate.overheadNs + std::max({estimate.dramNs,
+                                                   estimate.nocNs,
+                                                   estimate.computeNs}));
+}
+
+TEST(PerfModel, ComputeScalesWithGrid) {
+  PerfChip chip;
+  PerfEstimate single = ::tt::runtime::detail::estimateDispatch(
+      chip, makeEltwise(1, 1, 128, PerfMemory::L1));
+  PerfEstimate full = ::tt::runtime::detail::estimateDispatch(
+      chip, makeEltwise(8, 8, 128, PerfMemory::L1));
+  EXPECT_DOUBLE_EQ(single.computeNs, 64 * full.computeNs);
+  EXPECT_LT(full.latencyNs, single.latencyNs);
+  EXPECT_EQ(single.dramNs, 0.0);
+}
+
+TEST(PerfModel, L1OverflowSpillsToDram) {
+  PerfChip chip;
+  // 3 operands of 128 tiles are 768KiB, that fits a 1MiB L1 but not 512KiB.
+  PerfDispatch dispatch = makeEltwise(1, 1, 128, PerfMemory::L1);
+  EXPECT_EQ(::tt::runtime::detail::estimateDispatch(chip, dispatch).dramNs,
+            0.0);
+
+  chip.l1Size = 512 * 1024;
+  PerfEstimate spilled =
+      ::tt::runtime::detail::estimateDispatch(chip, dispatch);
+  EXPECT_DOUBLE_EQ(spilled.dramNs,
+                   chip.dramLatencyNs +
+                       256 * 1024 / (chip.dramBytesPerNsPerChannel *
+                                     chip.numDramChannels));
+
+  // Spread over the whole grid the same operands fit again.
+  EXPECT_EQ(::tt::runtime::detail::estimateDispatch(
+                chip, makeEltwise(8, 8, 128, PerfMemory::L1))
+                .dramNs,
+            0.0);
+}
+
+TEST(PerfModel, KernelsAreClippedToTheGrid) {
+  PerfChip chip;
+  PerfEstimate inside = ::tt::runtime::detail::estimateDispatch(
+      chip, makeEltwise(8, 8, 1024, PerfMemory::L1));
+  PerfEstimate outside = ::tt::runtime::detail::estimateDispatch(
+      chip, makeEltwise(16, 16, 1024, PerfMemory::L1));
+  EXPECT_DOUBLE_EQ(inside.computeNs, outside.computeNs);
+  EXPECT_DOUBLE_EQ(inside.nocNs, outside.nocNs);
+}
+
+TEST(PerfModel, DispatchWithoutKernelsOnlyCostsOverhead) {
+  PerfChip chip;
+  PerfDispatch dispatch;
+  dispatch.operands.push_back(makeBuffer(64, PerfMemory::DRAM));
+  PerfEstimate estimate =
+      ::tt::runtime::detail::estimateDispatch(chip, dispatch);
+  EXPECT_DOUBLE_EQ(estimate.latencyNs, chip.dispatchLatencyNs);
+}
+
+TEST(PerfModel, HostTransferIsBoundByPcie) {
+  PerfChip chip;
+  PerfBuffer buffer = makeBuffer(1024, PerfMemory::DRAM);
+  PerfEstimate estimate =
+      ::tt::runtime::detail::estimateHostTransfer(chip, buffer);
+  EXPECT_DOUBLE_EQ(estimate.pcieNs, buffer.bytes / chip.pcieBytesPerNs);
+  EXPECT_GT(estimate.pcieNs, estimate.dramNs);
+  EXPECT_DOUBLE_EQ(estimate.latencyNs, chip.pcieLatencyNs + estimate.pcieNs);
+
+  // Transfers are padded to the PCIe alignment.
+  PerfBuffer odd;
+  odd.bytes = 1;
+  EXPECT_DOUBLE_EQ(
+      ::tt::runtime::detail::estimateHostTransfer(chip, odd).pcieNs,
+      chip.pcieAlign / chip.pcieBytesPerNs);
+}
+
+TEST(PerfModel, MoreDramChannelsAreFaster) {
+  PerfChip narrow;
+  narrow.numDramChannels = 4;
+  PerfChip wide;
+  wide.numDramChannels = 12;
+  PerfDispatch dispatch = makeEltwise(8, 8, 4096, PerfMemory::DRAM);
+  EXPECT_GT(::tt::runtime::detail::estimateDispatch(narrow, dispatch).dramNs,
+            ::tt::runtime::detail::estimateDispatch(wide, dispatch).dramNs);
+}
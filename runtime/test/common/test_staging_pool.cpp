@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/staging_pool.h"
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using ::tt::runtime::detail::StagingPool;
+
+TEST(StagingPool, MappingSizes) {
+  std::size_t pageSize = ::sysconf(_SC_PAGESIZE);
+  std::size_t hugePageSize = StagingPool::getHugePageSize();
+  StagingPool pool(0, true);
+  EXPECT_EQ(pool.getMappingSize(1), pageSize);
+  EXPECT_EQ(pool.getMappingSize(pageSize + 1), 2 * pageSize);
+  EXPECT_EQ(pool.getMappingSize(hugePageSize / 2), hugePageSize);
+  EXPECT_EQ(pool.getMappingSize(hugePageSize + 1), 2 * hugePageSize);
+  StagingPool smallPages(0, false);
+  EXPECT_EQ(smallPages.getMappingSize(hugePageSize / 2), hugePageSize / 2);
+  EXPECT_EQ(smallPages.getMappingSize(hugePageSize + 1) % pageSize, 0u);
+  EXPECT_LT(smallPages.getMappingSize(hugePageSize + 1), 2 * hugePageSize);
+}
+
+// Passes whether or not the host has huge pages or lets us lock memory.
+TEST(StagingPool, BuffersAreUsable) {
+  std::uintptr_t pageSize = ::sysconf(_SC_PAGESIZE);
+  for (bool useHugePages : {true, false}) {
+    StagingPool pool(std::size_t(64) << 20, useHugePages);
+    for (std::size_t size : {std::size_t(100), std::size_t(3) << 20}) {
+      std::shared_ptr<void> buffer = pool.allocate(size);
+      ASSERT_TRUE(buffer);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer.get()) % pageSize, 0u);
+      std::memset(buffer.get(), 0xab, size);
+      EXPECT_EQ(static_cast<std::uint8_t *>(buffer.get())[size - 1], 0xab);
+    }
+    EXPECT_EQ(pool.getNumMappings(), 2u);
+    EXPECT_LE(pool.getNumHugePageMappings(), useHugePages ? 1u : 0u);
+    EXPECT_LE(pool.getNumPinnedMappings(), 2u);
+  }
+}
+
+TEST(StagingPool, ReusesFreedBuffers) {
+  StagingPool pool(std::size_t(64) << 20, false);
+  void *first = nullptr;
+  {
+    std::shared_ptr<void> buffer = pool.allocate(100000);
+    first = buffer.get();
+  }
+  EXPECT_EQ(pool.getFreeBytes(), pool.getMappingSize(100000));
+  for (int i = 0; i < 10; ++i) {
+    // Any size mapping to the same size reuses the buffer.
+    std::shared_ptr<void> buffer = pool.allocate(99000 + i);
+    EXPECT_EQ(buffer.get(), first);
+    EXPECT_EQ(pool.getFreeBytes(), 0u);
+  }
+  EXPECT_EQ(pool.getNumMappings(), 1u);
+}
+
+TEST(StagingPool, CapacityBoundsFreeBuffers) {
+  StagingPool pool(1 << 20, false);
+  {
+    std::vector<std::shared_ptr<void>> buffers;
+    for (int i = 0; i < 8; ++i) {
+      buffers.push_back(pool.allocate(256 << 10));
+    }
+  }
+  EXPECT_LE(pool.getFreeBytes(), std::size_t(1) << 20);
+  EXPECT_GT(pool.getFreeBytes(), 0u);
+  pool.trim();
+  EXPECT_EQ(pool.getFreeBytes(), 0u);
+  pool.setCapacity(0);
+  pool.allocate(1000).reset();
+  EXPECT_EQ(pool.getFreeBytes(), 0u);
+}
+
+TEST(StagingPool, BuffersOutliveThePool) {
+  std::shared_ptr<void> buffer;
+  {
+    StagingPool pool(1 << 20, false);
+    buffer = pool.allocate(5000);
+  }
+  std::memset(buffer.get(), 0, 5000);
+  buffer.reset();
+}
+
+TEST(StagingPool, ConcurrentAllocations) {
+  StagingPool pool(std::size_t(16) << 20, false);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&pool, t] {
+      for (int i = 0; i < 200; ++i) {
+        std::size_t size = 4096 * (1 + (t + i) % 4);
+        std::shared_ptr<void> buffer = pool.allocate(size);
+        std::memset(buffer.get(), t, size);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(pool.getNumMappings(), 8u * 4u);
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/thread_pool.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using ::tt::runtime::detail::ThreadPool;
+
+TEST(RuntimeThreadPool, CoversRangeOnce) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.getNumThreads(), 4u);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.parallelFor(hits.size(), 7, [&](std::size_t begin, std::size_t end) {
+    EXPECT_LE(end - begin, 7u);
+    for (std::size_t i = begin; i < end; ++i) {
+      ++hits[i];
+    }
+  });
+  for (auto const &hit : hits) {
+    EXPECT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(RuntimeThreadPool, SingleThreadRunsInline) {
+  ThreadPool pool(1);
+  std::size_t calls = 0;
+  pool.parallelFor(100, 10, [&](std::size_t begin, std::size_t end) {
+    EXPECT_EQ(begin, 0u);
+    EXPECT_EQ(end, 100u);
+    ++calls;
+  });
+  EXPECT_EQ(calls, 1u);
+}
+
+TEST(RuntimeThreadPool, NestedLoops) {
+  // Outer iterations occupy every thread, the inner loops still complete
+  // because each caller works through its own chunks.
+  ThreadPool pool(3);
+  std::atomic<int> count = 0;
+  pool.parallelFor(8, 1, [&](std::size_t, std::size_t) {
+    pool.parallelFor(64, 4, [&](std::size_t begin, std::size_t end) {
+      count += end - begin;
+    });
+  });
+  EXPECT_EQ(count.load(), 8 * 64);
+}
+
+TEST(RuntimeThreadPool, RethrowsAfterDraining) {
+  ThreadPool pool(4);
+  std::atomic<int> count = 0;
+  EXPECT_THROW(pool.parallelFor(64, 1,
+                                [&](std::size_t begin, std::size_t) {
+                                  ++count;
+                                  if (begin == 3) {
+                                    throw std::runtime_error("bad chunk");
+                                  }
+                                }),
+               std::runtime_error);
+  EXPECT_EQ(count.load(), 64);
+
+  // The pool is still usable afterwards.
+  count = 0;
+  pool.parallelFor(16, 1, [&](std::size_t, std::size_t) { ++count; });
+  EXPECT_EQ(count.load(), 16);
+}
+
+TEST(RuntimeThreadPool, HostPoolSize) {
+  ::tt::runtime::detail::setHostThreadCount(2);
+  EXPECT_EQ(::tt::runtime::detail::getHostThreadPool()->getNumThreads(), 2u);
+  ::tt::runtime::detail::setHostThreadCount(0);
+  EXPECT_GE(::tt::runtime::detail::getHostThreadPool()->getNumThreads(), 1u);
+}
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/tilize.h"
+#include "tt/runtime/detail/thread_pool.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+using ::tt::runtime::detail::TiledShape;
+
+// Reference tilize written straight from the layout description.
+template <typename T>
+static std::vector<T> referenceTilize(std::vector<T> const &rowMajor,
+                                      TiledShape const &shape, T pad) {
+  std::vector<T> tiled(shape.batch * shape.paddedRows * shape.paddedCols, pad);
+  std::uint32_t tileCols = shape.paddedCols / 32;
+  for (std::uint64_t b = 0; b < shape.batch; ++b) {
+    for (std::uint32_t r = 0; r < shape.rows; ++r) {
+      for (std::uint32_t c = 0; c < shape.cols; ++c) {
+        std::uint64_t tile = (r / 32) * tileCols + c / 32;
+        std::uint32_t face = ((r % 32) / 16) * 2 + (c % 32) / 16;
+        std::uint64_t index = b * shape.paddedRows * shape.paddedCols +
+                              tile * 1024 + face * 256 + (r % 16) * 16 +
+                              c % 16;
+        tiled[index] = rowMajor[(b * shape.rows + r) * shape.cols + c];
+      }
+    }
+  }
+  return tiled;
+}
+
+// Runs the check at every instruction set level the host supports.
+template <typename Fn> static void forEachSimdLevel(Fn fn) {
+  using ::tt::runtime::detail::SimdLevel;
+  SimdLevel supported = ::tt::runtime::detail::getSupportedSimdLevel();
+  for (SimdLevel level :
+       {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level > supported) {
+      continue;
+    }
+    ::tt::runtime::detail::setSimdLevel(level);
+    fn();
+  }
+  ::tt::runtime::detail::setSimdLevel(supported);
+}
+
+template <typename T> static void checkRoundTrip(TiledShape const &shape) {
+  std::vector<T> rowMajor(shape.batch * shape.rows * shape.cols);
+  for (std::size_t i = 0; i < rowMajor.size(); ++i) {
+    rowMajor[i] = static_cast<T>(i % 65521);
+  }
+  std::vector<T> expected = referenceTilize(rowMajor, shape, T(0));
+  forEachSimdLevel([&] {
+    std::vector<T> tiled(expected.size(), T(65535));
+    ::tt::runtime::detail::tilize(rowMajor.data(), tiled.data(), shape);
+    EXPECT_EQ(tiled, expected);
+
+    std::vector<T> untilized(rowMajor.size());
+    ::tt::runtime::detail::untilize(tiled.data(), untilized.data(), shape);
+    EXPECT_EQ(untilized, rowMajor);
+  });
+}
+
+TEST(RuntimeTilize, SingleTile) {
+  checkRoundTrip<float>({1, 32, 32, 32, 32});
+  checkRoundTrip<std::uint32_t>({1, 32, 32, 32, 32});
+  checkRoundTrip<std::uint16_t>({1, 32, 32, 32, 32});
+}
+
+TEST(RuntimeTilize, BatchedTiles) {
+  checkRoundTrip<float>({3, 64, 96, 64, 96});
+  checkRoundTrip<std::uint32_t>({3, 64, 96, 64, 96});
+  checkRoundTrip<std::uint16_t>({3, 64, 96, 64, 96});
+}
+
+TEST(RuntimeTilize, Padding) {
+  checkRoundTrip<float>({2, 33, 70, 64, 96});
+  checkRoundTrip<std::uint32_t>({2, 33, 70, 64, 96});
+  checkRoundTrip<std::uint16_t>({2, 33, 70, 64, 96});
+  checkRoundTrip<float>({1, 1, 5, 32, 32});
+}
+
+TEST(RuntimeTilize, SplitAcrossThreads) {
+  // Large enough to be split into several chunks of tile rows, with chunks
+  // crossing batch boundaries.
+  ::tt::runtime::detail::setHostThreadCount(4);
+  checkRoundTrip<float>({3, 1000, 1030, 1024, 1056});
+  checkRoundTrip<std::uint16_t>({5, 512, 2048, 512, 2048});
+  ::tt::runtime::detail::setHostThreadCount(0);
+}
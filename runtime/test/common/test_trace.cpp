@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/trace.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using ::tt::runtime::OpTraceEvent;
+
+static OpTraceEvent makeEvent(std::uint32_t opIndex, char const *opType) {
+  OpTraceEvent event;
+  event.programName = "forward";
+  event.opIndex = opIndex;
+  event.opType = opType;
+  event.startNs = 1000 + opIndex * 2500;
+  event.endNs = event.startNs + 1500;
+  return event;
+}
+
+TEST(RuntimeTrace, CallbackInstallAndRemove) {
+  EXPECT_FALSE(::tt::runtime::detail::isOpTraceEnabled());
+  std::vector<OpTraceEvent> events;
+  ::tt::runtime::setOpTraceCallback(
+      [&events](OpTraceEvent const &event) { events.push_back(event); });
+  EXPECT_TRUE(::tt::runtime::detail::isOpTraceEnabled());
+  ::tt::runtime::detail::emitOpTrace(makeEvent(0, "EltwiseOp"));
+  ::tt::runtime::detail::emitOpTrace(makeEvent(1, "MatmulOp"));
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[1].opType, "MatmulOp");
+
+  ::tt::runtime::setOpTraceCallback(nullptr);
+  EXPECT_FALSE(::tt::runtime::detail::isOpTraceEnabled());
+  ::tt::runtime::detail::emitOpTrace(makeEvent(2, "EltwiseOp"));
+  EXPECT_EQ(events.size(), 2u);
+}
+
+TEST(RuntimeTrace, ThreadIdsAreStablePerThread) {
+  std::uint32_t main = ::tt::runtime::detail::getTraceThreadId();
+  EXPECT_EQ(main, ::tt::runtime::detail::getTraceThreadId());
+  std::uint32_t other = main;
+  std::thread([&other] {
+    other = ::tt::runtime::detail::getTraceThreadId();
+  }).join();
+  EXPECT_NE(main, other);
+}
+
+TEST(RuntimeTrace, ChromeTraceFormat) {
+  OpTraceEvent event = makeEvent(3, "SoftmaxOp");
+  event.debugInfo = "loc(\"model.py\":12)\n";
+  event.threadId = 2;
+  EXPECT_EQ(::tt::runtime::toChromeTrace({event}),
+            "{\"traceEvents\":[\n"
+            "{\"name\":\"SoftmaxOp\",\"cat\":\"forward\",\"ph\":\"X\","
+            "\"pid\":0,\"tid\":2,\"ts\":8.500,\"dur\":1.500,"
+            "\"args\":{\"op_index\":3,"
+            "\"debug_info\":\"loc(\\\"model.py\\\":12)\\n\"}}\n"
+            "],\"displayTimeUnit\":\"ns\"}\n");
+  EXPECT_EQ(::tt::runtime::toChromeTrace({}),
+            "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/worker.h"
+#include "tt/runtime/runtime.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using ::tt::runtime::detail::Worker;
+
+TEST(RuntimeWorker, RunsJobsInOrder) {
+  Worker worker;
+  std::vector<int> order;
+  std::vector<std::shared_ptr<::tt::runtime::detail::EventState>> events;
+  for (int i = 0; i < 16; ++i) {
+    events.push_back(worker.enqueue([&order, i] { order.push_back(i); }));
+  }
+  events.back()->wait();
+  ASSERT_EQ(order.size(), 16u);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(order[i], i);
+    EXPECT_TRUE(events[i]->poll());
+  }
+}
+
+TEST(RuntimeWorker, PollDoesNotBlock) {
+  Worker worker;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  auto event = worker.enqueue([released] { released.wait(); });
+
+  // The submitting thread keeps running while the job is parked.
+  EXPECT_FALSE(event->poll());
+  release.set_value();
+  event->wait();
+  EXPECT_TRUE(event->poll());
+}
+
+TEST(RuntimeWorker, WaitRethrowsJobError) {
+  Worker worker;
+  auto failed =
+      worker.enqueue([] { throw std::runtime_error("device fault"); });
+  EXPECT_THROW(failed->wait(), std::runtime_error);
+
+  // The worker survives a failing job.
+  std::atomic<bool> ran = false;
+  worker.enqueue([&ran] { ran = true; })->wait();
+  EXPECT_TRUE(ran.load());
+}
+
+TEST(RuntimeWorker, FlushAndShutdownDrainQueue) {
+  std::atomic<int> count = 0;
+  {
+    Worker worker;
+    for (int i = 0; i < 8; ++i) {
+      worker.enqueue([&count] { ++count; });
+    }
+    worker.flush();
+    EXPECT_EQ(count.load(), 8);
+    for (int i = 0; i < 8; ++i) {
+      worker.enqueue([&count] { ++count; });
+    }
+  }
+  EXPECT_EQ(count.load(), 16);
+}
+
+TEST(RuntimeWorker, EventHandles) {
+  int device = 0;
+  auto &worker = ::tt::runtime::detail::getWorker(&device);
+  EXPECT_EQ(&worker, &::tt::runtime::detail::getWorker(&device));
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  ::tt::runtime::Event event(worker.enqueue([released] { released.wait(); }));
+  EXPECT_FALSE(::tt::runtime::poll(event));
+  release.set_value();
+  ::tt::runtime::wait(event);
+  EXPECT_TRUE(::tt::runtime::poll(event));
+  ::tt::runtime::detail::releaseWorker(&device);
+
+  // A null event is always complete.
+  ::tt::runtime::Event none(nullptr);
+  EXPECT_TRUE(::tt::runtime::poll(none));
+  ::tt::runtime::wait(none);
+}
+
+TEST(RuntimeWorker, StreamsKeepTheirOwnOrder) {
+  Worker worker;
+  std::vector<std::vector<int>> order(Worker::kNumStreams);
+  std::vector<std::shared_ptr<::tt::runtime::detail::EventState>> events;
+  for (int i = 0; i < 64; ++i) {
+    std::uint32_t stream = i % Worker::kNumStreams;
+    events.push_back(worker.enqueue(
+        [&order, stream, i] { order[stream].push_back(i); }, stream));
+  }
+  worker.flush();
+  for (std::uint32_t stream = 0; stream < Worker::kNumStreams; ++stream) {
+    ASSERT_EQ(order[stream].size(), 64u / Worker::kNumStreams);
+    for (std::size_t j = 1; j < order[stream].size(); ++j) {
+      EXPECT_LT(order[stream][j - 1], order[stream][j]);
+    }
+  }
+  EXPECT_THROW(worker.enqueue([] {}, Worker::kNumStreams),
+               std::runtime_error);
+}
+
+TEST(RuntimeWorker, BusyStreamDoesNotStarveOthers) {
+  Worker worker;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  worker.enqueue([released] { released.wait(); }, 0);
+  std::vector<int> order;
+  for (int i = 0; i < 8; ++i) {
+    worker.enqueue([&order] { order.push_back(0); }, 0);
+  }
+  auto other = worker.enqueue([&order] { order.push_back(1); }, 1);
+  release.set_value();
+  other->wait();
+  worker.flush();
+  // The other stream is served after at most one more job of stream 0.
+  ASSERT_EQ(order.size(), 9u);
+  EXPECT_LE(std::find(order.begin(), order.end(), 1) - order.begin(), 1);
+}
+
+TEST(RuntimeWorker, ConcurrentSubmittersNeverOverlap) {
+  Worker worker;
+  std::atomic<int> running = 0;
+  std::atomic<int> overlaps = 0;
+  std::atomic<int> count = 0;
+  std::vector<std::thread> submitters;
+  for (std::uint32_t t = 0; t < 8; ++t) {
+    submitters.emplace_back([&, t] {
+      // More jobs than a stream holds, exercising back pressure.
+      for (int i = 0; i < 1000; ++i) {
+        worker.enqueue(
+            [&] {
+              if (running.fetch_add(1) != 0) {
+                ++overlaps;
+              }
+              ++count;
+              running.fetch_sub(1);
+            },
+            t % Worker::kNumStreams);
+      }
+    });
+  }
+  for (auto &thread : submitters) {
+    thread.join();
+  }
+  worker.flush();
+  EXPECT_EQ(count.load(), 8000);
+  EXPECT_EQ(overlaps.load(), 0);
+}
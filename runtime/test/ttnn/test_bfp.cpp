@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: (c) 2024 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/detail/ttnn.h"
+#include "tt/runtime/runtime.h"
+#include "tt/runtime/utils.h"
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace {
+// Every group holds values of one binade with at most two mantissa bits, so
+// they are exact in both formats and survive packing unchanged.
+std::vector<float> makeValues(std::size_t size) {
+  std::vector<float> values(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    values[i] = (i % 3 ? 1.0f : -1.0f) * (1.0f + float(i % 4) / 4);
+  }
+  return values;
+}
+
+// Packs through createTensor, then unpacks the tiles the way outputs read back
+// from the device are, into a row major buffer of the given itemsize.
+void checkRoundTrip(::tt::target::DataType dataType, std::uint32_t itemsize) {
+  std::vector<std::uint32_t> shape = {2, 40, 50};
+  std::vector<std::uint32_t> stride = {2000, 50, 1};
+  std::size_t volume = 2 * 40 * 50;
+  std::vector<float> values = makeValues(volume);
+  std::vector<std::uint16_t> bf16(volume);
+  for (std::size_t i = 0; i < volume; ++i) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &values[i], sizeof(bits));
+    bf16[i] = bits >> 16;
+  }
+  void const *expected = itemsize == sizeof(float)
+                             ? static_cast<void const *>(values.data())
+                             : static_cast<void const *>(bf16.data());
+
+  std::shared_ptr<void> data =
+      ::tt::runtime::utils::malloc_shared(volume * itemsize);
+  std::memcpy(data.get(), expected, volume * itemsize);
+  ::tt::runtime::Tensor input = ::tt::runtime::createTensor(
+      data, ::tt::runtime::TensorDesc{shape, stride, itemsize, dataType});
+  auto &packed = *static_cast<::ttnn::Tensor *>(input.handle.get());
+  EXPECT_EQ(packed.get_layout(), ::ttnn::Layout::TILE);
+
+  std::shared_ptr<void> result =
+      ::tt::runtime::utils::malloc_shared(volume * itemsize);
+  std::memset(result.get(), 0xff, volume * itemsize);
+  ::tt::runtime::Tensor output = ::tt::runtime::createTensor(
+      result, ::tt::runtime::TensorDesc{
+                  shape, stride, itemsize,
+                  itemsize == sizeof(float)
+                      ? ::tt::target::DataType::Float32
+                      : ::tt::target::DataType::BFloat16});
+  ::tt::runtime::ttnn::untilizeInto(
+      packed, *static_cast<::ttnn::Tensor *>(output.handle.get()), dataType);
+  EXPECT_EQ(std::memcmp(result.get(), expected, volume * itemsize), 0);
+}
+} // namespace
+
+TEST(TTNNBfp, Bfp8RoundTrip) {
+  checkRoundTrip(::tt::target::DataType::BFP_BFloat8, sizeof(float));
+  checkRoundTrip(::tt::target::DataType::BFP_BFloat8, sizeof(std::uint16_t));
+}
+
+TEST(TTNNBfp, Bfp4RoundTrip) {
+  checkRoundTrip(::tt::target::DataType::BFP_BFloat4, sizeof(float));
+  checkRoundTrip(::tt::target::DataType::BFP_BFloat4, sizeof(std::uint16_t));
+}
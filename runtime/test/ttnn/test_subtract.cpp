@@ -38,6 +38,7 @@ TEST(TTNNSubtract, Equal) {
 
   auto device = ::tt::runtime::openDevice();
   auto ev = ::tt::runtime::submit(device, fbb, 0, inputTensors, outputTensors);
+  ::tt::runtime::wait(ev);
   ::tt::runtime::closeDevice(device);
 
   std::shared_ptr<void> expected =
@@ -33,7 +33,7 @@ ext_modules = [
             f"{src_dir}/build/include",
             f"{src_dir}/build/include/ttmlir/Target/Common",
         ],
-        libraries=["TTRuntime", "flatbuffers"],
+        libraries=["TTRuntime", "TTRuntimeCommon", "flatbuffers"],
         library_dirs=[
             f"{src_dir}/build/runtime/lib",
             f"{toolchain}/lib",
@@ -42,10 +42,27 @@ ext_modules = [
     ),
 ]
 
-if enable_runtime:
-    shutil.copy(
-        f"{metallibdir}/_ttnn.so", f"{src_dir}/build/runtime/tools/python/ttrt/runtime"
-    )
+enable_runtime_cpu = os.environ.get("TTMLIR_ENABLE_RUNTIME_CPU", "OFF") == "ON"
+
+if enable_runtime or enable_runtime_cpu:
+    runtime_libraries = ["TTRuntime"]
+    runtime_library_dirs = [
+        f"{src_dir}/build/runtime/lib",
+        f"{toolchain}/lib",
+    ]
+    if enable_runtime:
+        shutil.copy(
+            f"{metallibdir}/_ttnn.so",
+            f"{src_dir}/build/runtime/tools/python/ttrt/runtime",
+        )
+        runtime_libraries.append("TTRuntimeTTNN")
+        runtime_library_dirs.append(f"{metallibdir}")
+    if enable_runtime_cpu:
+        runtime_libraries.append("TTRuntimeCPU")
+    runtime_libraries.append("TTRuntimeCommon")
+    if enable_runtime:
+        runtime_libraries.append(":_ttnn.so")
+    runtime_libraries.append("flatbuffers")
     ext_modules.append(
         Pybind11Extension(
             "ttrt.runtime._C",
@@ -56,12 +73,8 @@ if enable_runtime:
                 f"{src_dir}/build/include",
                 f"{src_dir}/build/include/ttmlir/Target/Common",
             ],
-            libraries=["TTRuntime", "TTRuntimeTTNN", ":_ttnn.so", "flatbuffers"],
-            library_dirs=[
-                f"{src_dir}/build/runtime/lib",
-                f"{toolchain}/lib",
-                f"{metallibdir}",
-            ],
+            libraries=runtime_libraries,
+            library_dirs=runtime_library_dirs,
             define_macros=[("VERSION_INFO", __version__)],
         )
     )
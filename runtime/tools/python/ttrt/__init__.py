@@ -17,7 +17,7 @@ import sys
 import shutil
 
 import ttrt.binary
-from ttrt.common.api import read, run, query, perf
+from ttrt.common.api import read, run, query, perf, replay, estimate
 from ttrt.common.util import read_actions, ttrt_cleanup
 
 #######################################################################################
@@ -55,7 +55,23 @@ def main():
         "-p",
         "--program-index",
         default=0,
-        help="the program inside the fbb to run",
+        help="the program inside the fbb to run, by index or function name",
+    )
+    run_parser.add_argument(
+        "--host-threads",
+        default=0,
+        type=int,
+        help="host threads used for layout conversions, 0 for the default",
+    )
+    run_parser.add_argument(
+        "--trace",
+        default="",
+        help="write per op host timings as Chrome trace JSON to this file",
+    )
+    run_parser.add_argument(
+        "--capture",
+        default="",
+        help="record the submission to this capture file for ttrt replay",
     )
     run_parser.add_argument("binary", help="flatbuffer binary file")
     run_parser.set_defaults(func=run)
@@ -119,6 +135,51 @@ def main():
     perf_parser.add_argument("binary", help="flatbuffer binary file")
     perf_parser.set_defaults(func=perf)
 
+    """
+    API: replay
+    """
+    replay_parser = subparsers.add_parser(
+        "replay", help="replay captured submissions and report their latency"
+    )
+    replay_parser.add_argument(
+        "--as-fast-as-possible",
+        action="store_true",
+        help="submit back to back instead of with the captured timing",
+    )
+    replay_parser.add_argument(
+        "--host-threads",
+        default=0,
+        type=int,
+        help="host threads used for layout conversions, 0 for the default",
+    )
+    replay_parser.add_argument(
+        "--json",
+        default="",
+        help="write the latency of every submission as json to this file",
+    )
+    replay_parser.add_argument("capture", help="capture file")
+    replay_parser.set_defaults(func=replay)
+
+    """
+    API: estimate
+    """
+    estimate_parser = subparsers.add_parser(
+        "estimate", help="predict the latency of a ttmetal binary without a device"
+    )
+    estimate_parser.add_argument(
+        "--json",
+        default="",
+        help="write the per command estimate as json to this file",
+    )
+    estimate_parser.add_argument(
+        "--max-latency-ns",
+        default=0.0,
+        type=float,
+        help="exit with an error if the estimated latency exceeds this budget",
+    )
+    estimate_parser.add_argument("binary", help="flatbuffer binary file")
+    estimate_parser.set_defaults(func=estimate)
+
     try:
         args = parser.parse_args()
     except:
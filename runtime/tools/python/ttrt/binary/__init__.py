@@ -6,6 +6,8 @@ from ._C import (
     load_from_path,
     load_binary_from_path,
     load_system_desc_from_path,
+    set_registry_capacity,
+    estimate_perf,
     Flatbuffer,
 )
 
@@ -2,9 +2,11 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include "tt/runtime/perf.h"
 #include "tt/runtime/types.h"
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 
@@ -26,6 +28,12 @@ PYBIND11_MODULE(_C, m) {
                              &tt::runtime::Binary::getTTMLIRGitHash)
       .def_property_readonly("file_identifier",
                              &tt::runtime::Binary::getFileIdentifier)
+      .def_property_readonly("num_programs",
+                             &tt::runtime::Binary::getNumPrograms)
+      .def("get_program_name", &tt::runtime::Binary::getProgramName,
+           py::arg("program_index"))
+      .def("get_program_index", &tt::runtime::Binary::getProgramIndex,
+           py::arg("name"))
       .def("as_json", &tt::runtime::Binary::asJson)
       .def("store", &tt::runtime::Binary::store);
   py::class_<tt::runtime::SystemDesc>(m, "SystemDesc")
@@ -36,7 +44,30 @@ PYBIND11_MODULE(_C, m) {
                              &tt::runtime::SystemDesc::getFileIdentifier)
       .def("as_json", &tt::runtime::SystemDesc::asJson)
       .def("store", &tt::runtime::SystemDesc::store);
-  m.def("load_from_path", &tt::runtime::Flatbuffer::loadFromPath);
-  m.def("load_binary_from_path", &tt::runtime::Binary::loadFromPath);
+  m.def("load_from_path", &tt::runtime::Flatbuffer::loadFromPath,
+        py::arg("path"), py::arg("prefetch") = false);
+  m.def("load_binary_from_path", &tt::runtime::Binary::loadFromPath,
+        py::arg("path"), py::arg("prefetch") = false);
+  m.def("set_registry_capacity", &tt::runtime::Binary::setRegistryCapacity,
+        py::arg("bytes"));
   m.def("load_system_desc_from_path", &tt::runtime::SystemDesc::loadFromPath);
+
+  py::class_<tt::runtime::PerfEstimate>(m, "PerfEstimate")
+      .def_readonly("latency_ns", &tt::runtime::PerfEstimate::latencyNs)
+      .def_readonly("overhead_ns", &tt::runtime::PerfEstimate::overheadNs)
+      .def_readonly("pcie_ns", &tt::runtime::PerfEstimate::pcieNs)
+      .def_readonly("dram_ns", &tt::runtime::PerfEstimate::dramNs)
+      .def_readonly("noc_ns", &tt::runtime::PerfEstimate::nocNs)
+      .def_readonly("compute_ns", &tt::runtime::PerfEstimate::computeNs);
+  py::class_<tt::runtime::CommandPerf>(m, "CommandPerf")
+      .def_readonly("type", &tt::runtime::CommandPerf::type)
+      .def_readonly("debug_info", &tt::runtime::CommandPerf::debugInfo)
+      .def_readonly("estimate", &tt::runtime::CommandPerf::estimate);
+  py::class_<tt::runtime::CommandQueuePerf>(m, "CommandQueuePerf")
+      .def_readonly("name", &tt::runtime::CommandQueuePerf::name)
+      .def_readonly("total", &tt::runtime::CommandQueuePerf::total)
+      .def_readonly("commands", &tt::runtime::CommandQueuePerf::commands);
+  m.def("estimate_perf", &tt::runtime::estimatePerf, py::arg("binary"),
+        "Predicts the latency of each command queue of a TTMetal binary "
+        "without a device");
 }
@@ -59,21 +59,6 @@ def run(args):
             "Error: torch required for offline run, please `pip install torch`"
         )
 
-    def toDataType(dtype):
-        if dtype == torch.float32:
-            return ttrt.runtime.DataType.Float32
-        if dtype == torch.float16:
-            return ttrt.runtime.DataType.Float16
-        if dtype == torch.bfloat16:
-            return ttrt.runtime.DataType.BFloat16
-        if dtype == torch.uint32:
-            return ttrt.runtime.DataType.UInt32
-        if dtype == torch.uint16:
-            return ttrt.runtime.DataType.UInt16
-        if dtype == torch.uint8:
-            return ttrt.runtime.DataType.UInt8
-        raise ValueError(f"unsupported dtype: {dtype}")
-
     def fromDataType(dtype):
         if dtype == "Float32":
             return torch.float32
@@ -87,6 +72,9 @@ def run(args):
             return torch.uint16
         if dtype == "UInt8":
             return torch.uint8
+        # Block float tensors are packed by the runtime from bfloat16 data
+        if dtype == "BFP_BFloat8" or dtype == "BFP_BFloat4":
+            return torch.bfloat16
         raise ValueError(f"unsupported dtype: {dtype}")
 
     check_file_exists(args.binary)
@@ -96,13 +84,20 @@ def run(args):
     assert fbb.file_identifier == "TTNN", "Only TTNN binaries are supported"
     d = ttrt.binary.as_dict(fbb)
 
-    program_index = int(args.program_index)
-    assert program_index <= len(d["programs"]), "args.program_index out of range"
+    if str(args.program_index).isdigit():
+        program_index = int(args.program_index)
+    else:
+        program_index = fbb.get_program_index(args.program_index)
+    assert program_index < len(d["programs"]), "args.program_index out of range"
     program = d["programs"][program_index]
     print(f"running program[{program_index}]:", program["name"])
 
+    # Outputs are allocated by the runtime and viewed in place
+    def toTorch(tensor, dtype):
+        data = torch.frombuffer(memoryview(tensor), dtype=torch.uint8)
+        return data.view(dtype).as_strided(tensor.shape, tensor.stride)
+
     torch_inputs = []
-    torch_outputs = []
     for i in program["inputs"]:
         torch_inputs.append(
             torch.randn(
@@ -110,46 +105,49 @@ def run(args):
                 dtype=fromDataType(i["desc"]["layout"]["memory_desc"]["data_type"]),
             )
         )
-    for i in program["outputs"]:
-        torch_outputs.append(
-            torch.zeros(
-                i["desc"]["shape"],
-                dtype=fromDataType(i["desc"]["layout"]["memory_desc"]["data_type"]),
-            )
-        )
 
     print("inputs:\n", torch_inputs)
 
     inputs = []
-    outputs = []
-    for i in torch_inputs:
+    for desc, i in zip(program["inputs"], torch_inputs):
+        data_type = desc["desc"]["layout"]["memory_desc"]["data_type"]
         inputs.append(
             ttrt.runtime.create_tensor(
                 i.data_ptr(),
                 list(i.shape),
                 list(i.stride()),
                 i.element_size(),
-                toDataType(i.dtype),
+                ttrt.runtime.DataType.__members__[data_type],
             )
         )
 
-    for i in torch_outputs:
-        outputs.append(
-            ttrt.runtime.create_tensor(
-                i.data_ptr(),
-                list(i.shape),
-                list(i.stride()),
-                i.element_size(),
-                toDataType(i.dtype),
-            )
-        )
+    trace_events = []
+    if args.trace:
+        ttrt.runtime.set_op_trace_callback(trace_events.append)
 
+    ttrt.runtime.set_host_thread_count(args.host_threads)
     system_desc, device_ids = ttrt.runtime.get_current_system_desc()
     device = ttrt.runtime.open_device(device_ids)
-    ttrt.runtime.submit(device, fbb, 0, inputs, outputs)
+    if args.capture:
+        ttrt.runtime.start_capture(args.capture)
+    event, outputs = ttrt.runtime.submit(device, fbb, program_index, inputs)
+    ttrt.runtime.wait(event)
+    if args.capture:
+        ttrt.runtime.stop_capture()
+        print(f"captured submission to {args.capture}")
+    torch_outputs = [
+        toTorch(t, fromDataType(i["desc"]["layout"]["memory_desc"]["data_type"]))
+        for i, t in zip(program["outputs"], outputs)
+    ]
     print("outputs:\n", torch_outputs)
     ttrt.runtime.close_device(device)
 
+    if args.trace:
+        ttrt.runtime.set_op_trace_callback(None)
+        with open(args.trace, "w") as f:
+            f.write(ttrt.runtime.to_chrome_trace(trace_events))
+        print(f"wrote {len(trace_events)} trace events to {args.trace}")
+
 
 """
 API: query
@@ -245,3 +243,98 @@ def perf(args):
                 f"No profiling data could be captured. Please make sure you are on the correct build. Use scripts/build_scripts/build_with_profiler_opt.sh to build if you are not sure."
             )
             sys.exit(1)
+
+
+"""
+API: replay
+  - re-issue captured submissions and report their latency distribution
+"""
+
+
+def replay(args):
+    import ttrt.runtime
+
+    check_file_exists(args.capture)
+    ttrt.runtime.set_host_thread_count(args.host_threads)
+    system_desc, device_ids = ttrt.runtime.get_current_system_desc()
+    device = ttrt.runtime.open_device(device_ids)
+    try:
+        report = ttrt.runtime.replay_capture(
+            device, args.capture, not args.as_fast_as_possible
+        )
+    finally:
+        ttrt.runtime.close_device(device)
+
+    latencies = sorted(report.latencies_ns)
+    if not latencies:
+        print("capture holds no submissions")
+        return
+
+    def percentile(p):
+        return latencies[min(len(latencies) - 1, int(p / 100 * len(latencies)))]
+
+    print(f"replayed {len(latencies)} submissions in {report.duration_ns / 1e6:.3f} ms")
+    print(f"  min {latencies[0] / 1e3:12.1f} us")
+    for p in [50, 90, 99]:
+        print(f"  p{p:<2} {percentile(p) / 1e3:12.1f} us")
+    print(f"  max {latencies[-1] / 1e3:12.1f} us")
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(
+                {
+                    "duration_ns": report.duration_ns,
+                    "latencies_ns": list(report.latencies_ns),
+                },
+                f,
+            )
+        print(f"wrote latencies to {args.json}")
+
+
+"""
+API: estimate
+  - predict the latency of a ttmetal flatbuffer without a device
+"""
+
+
+def estimate(args):
+    check_file_exists(args.binary)
+    fbb = ttrt.binary.load_binary_from_path(args.binary)
+    check_version(fbb.version)
+
+    fields = ["latency_ns", "overhead_ns", "pcie_ns", "dram_ns", "noc_ns", "compute_ns"]
+    queues = ttrt.binary.estimate_perf(fbb)
+    report = []
+    for queue in queues:
+        commands = []
+        print(f"command queue: {queue.name}")
+        print(f"  {'#':>4} {'command':<14}" + "".join(f"{f:>14}" for f in fields))
+        for i, command in enumerate(queue.commands):
+            values = [getattr(command.estimate, f) for f in fields]
+            print(
+                f"  {i:>4} {command.type:<14}"
+                + "".join(f"{v:>14.1f}" for v in values)
+            )
+            commands.append(
+                {
+                    "type": command.type,
+                    "debug_info": command.debug_info,
+                    **dict(zip(fields, values)),
+                }
+            )
+        total = {f: getattr(queue.total, f) for f in fields}
+        print(f"  {'':>4} {'total':<14}" + "".join(f"{v:>14.1f}" for v in total.values()))
+        report.append({"name": queue.name, "total": total, "commands": commands})
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2)
+        print(f"wrote estimate to {args.json}")
+
+    if args.max_latency_ns:
+        latency = sum(queue["total"]["latency_ns"] for queue in report)
+        if latency > args.max_latency_ns:
+            print(
+                f"estimated latency {latency:.1f} ns exceeds the budget of {args.max_latency_ns:.1f} ns"
+            )
+            sys.exit(1)
@@ -7,14 +7,30 @@ try:
         Device,
         Event,
         Tensor,
+        OpTraceEvent,
+        ReplayReport,
         DataType,
+        DeviceRuntime,
+        get_available_runtimes,
+        get_current_runtime,
+        set_current_runtime,
         get_current_system_desc,
         open_device,
         close_device,
         submit,
+        get_num_streams,
+        wait,
+        poll,
+        set_host_thread_count,
+        set_host_arena_capacity,
+        set_op_trace_callback,
+        to_chrome_trace,
+        start_capture,
+        stop_capture,
+        replay_capture,
         create_tensor,
     )
 except ModuleNotFoundError:
     raise ImportError(
-        "Error: Project was not built with runtime enabled, rebuild with: -DTTMLIR_ENABLE_RUNTIME=ON"
+        "Error: Project was not built with runtime enabled, rebuild with: -DTTMLIR_ENABLE_RUNTIME=ON or -DTTMLIR_ENABLE_RUNTIME_CPU=ON"
     )
@@ -4,6 +4,7 @@
 
 #include "tt/runtime/runtime.h"
 
+#include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -15,7 +16,47 @@ PYBIND11_MODULE(_C, m) {
 
   py::class_<tt::runtime::Device>(m, "Device");
   py::class_<tt::runtime::Event>(m, "Event");
-  py::class_<tt::runtime::Tensor>(m, "Tensor");
+  py::class_<tt::runtime::Tensor>(m, "Tensor", py::buffer_protocol())
+      .def_property_readonly(
+          "shape",
+          [](tt::runtime::Tensor const &tensor) { return tensor.desc.shape; })
+      .def_property_readonly(
+          "stride",
+          [](tt::runtime::Tensor const &tensor) { return tensor.desc.stride; })
+      .def_property_readonly("itemsize",
+                             [](tt::runtime::Tensor const &tensor) {
+                               return tensor.desc.itemsize;
+                             })
+      .def_property_readonly("data_type",
+                             [](tt::runtime::Tensor const &tensor) {
+                               return tensor.desc.dataType;
+                             })
+      // The raw bytes spanned by the tensor, viewed in place.
+      .def_buffer([](tt::runtime::Tensor &tensor) {
+        py::ssize_t size = tensor.desc.itemsize;
+        for (std::size_t i = 0; i < tensor.desc.shape.size(); ++i) {
+          if (tensor.desc.shape[i] == 0) {
+            size = 0;
+            break;
+          }
+          size += py::ssize_t(tensor.desc.shape[i] - 1) *
+                  tensor.desc.stride[i] * tensor.desc.itemsize;
+        }
+        return py::buffer_info(tensor.data.get(), 1,
+                               py::format_descriptor<std::uint8_t>::format(),
+                               size);
+      });
+  py::class_<tt::runtime::OpTraceEvent>(m, "OpTraceEvent")
+      .def_readonly("program_name", &tt::runtime::OpTraceEvent::programName)
+      .def_readonly("op_index", &tt::runtime::OpTraceEvent::opIndex)
+      .def_readonly("op_type", &tt::runtime::OpTraceEvent::opType)
+      .def_readonly("debug_info", &tt::runtime::OpTraceEvent::debugInfo)
+      .def_readonly("start_ns", &tt::runtime::OpTraceEvent::startNs)
+      .def_readonly("end_ns", &tt::runtime::OpTraceEvent::endNs)
+      .def_readonly("thread_id", &tt::runtime::OpTraceEvent::threadId);
+  py::class_<tt::runtime::ReplayReport>(m, "ReplayReport")
+      .def_readonly("latencies_ns", &tt::runtime::ReplayReport::latenciesNs)
+      .def_readonly("duration_ns", &tt::runtime::ReplayReport::durationNs);
   py::enum_<::tt::target::DataType>(m, "DataType")
       .value("Float32", ::tt::target::DataType::Float32)
       .value("Float16", ::tt::target::DataType::Float16)
@@ -29,6 +70,17 @@ PYBIND11_MODULE(_C, m) {
       .value("UInt32", ::tt::target::DataType::UInt32)
       .value("UInt16", ::tt::target::DataType::UInt16)
       .value("UInt8", ::tt::target::DataType::UInt8);
+  py::enum_<tt::runtime::DeviceRuntime>(m, "DeviceRuntime")
+      .value("Disabled", tt::runtime::DeviceRuntime::Disabled)
+      .value("TTNN", tt::runtime::DeviceRuntime::TTNN)
+      .value("CPU", tt::runtime::DeviceRuntime::CPU);
+
+  m.def("get_available_runtimes", &tt::runtime::getAvailableRuntimes,
+        "Get the runtimes this build was compiled with");
+  m.def("get_current_runtime", &tt::runtime::getCurrentRuntime,
+        "Get the runtime that executes submitted programs");
+  m.def("set_current_runtime", &tt::runtime::setCurrentRuntime,
+        py::arg("runtime"), "Select the runtime that executes programs");
 
   m.def("get_current_system_desc", &tt::runtime::getCurrentSystemDesc,
         "Get the current system descriptor");
@@ -47,7 +99,67 @@ PYBIND11_MODULE(_C, m) {
         py::arg("device_ids") = std::vector<int>{0},
         "Open a device for execution");
   m.def("close_device", &tt::runtime::closeDevice, "Close a device");
-  m.def("submit", &tt::runtime::submit, py::arg("device"),
-        py::arg("executable"), py::arg("program_index"), py::arg("inputs"),
-        py::arg("outputs"), "Submit a binary for execution");
+  m.def("submit",
+        py::overload_cast<tt::runtime::Device, tt::runtime::Binary,
+                          std::uint32_t,
+                          std::vector<tt::runtime::Tensor> const &,
+                          std::vector<tt::runtime::Tensor> const &,
+                          std::uint32_t>(&tt::runtime::submit),
+        py::arg("device"), py::arg("executable"), py::arg("program_index"),
+        py::arg("inputs"), py::arg("outputs"), py::arg("stream") = 0,
+        py::call_guard<py::gil_scoped_release>(),
+        "Submit a program of a binary for execution");
+  m.def("submit",
+        py::overload_cast<tt::runtime::Device, tt::runtime::Binary,
+                          std::string_view,
+                          std::vector<tt::runtime::Tensor> const &,
+                          std::vector<tt::runtime::Tensor> const &,
+                          std::uint32_t>(&tt::runtime::submit),
+        py::arg("device"), py::arg("executable"), py::arg("program_name"),
+        py::arg("inputs"), py::arg("outputs"), py::arg("stream") = 0,
+        py::call_guard<py::gil_scoped_release>(),
+        "Submit a program of a binary, selected by name, for execution");
+  m.def(
+      "submit",
+      [](tt::runtime::Device device, tt::runtime::Binary executable,
+         std::uint32_t programIndex,
+         std::vector<tt::runtime::Tensor> const &inputs, std::uint32_t stream) {
+        tt::runtime::Submission submission = tt::runtime::submit(
+            device, executable, programIndex, inputs, stream);
+        return std::make_pair(submission.event, submission.outputs);
+      },
+      py::arg("device"), py::arg("executable"), py::arg("program_index"),
+      py::arg("inputs"), py::arg("stream") = 0,
+      py::call_guard<py::gil_scoped_release>(),
+      "Submit a program of a binary for execution, returning the event and "
+      "the outputs allocated by the runtime");
+  m.def("set_host_arena_capacity", &tt::runtime::setHostArenaCapacity,
+        py::arg("bytes"),
+        "Set the bytes of free output buffers kept for reuse");
+  m.def("get_num_streams", &tt::runtime::getNumStreams,
+        "Get the number of logical streams per device");
+  m.def("wait", &tt::runtime::wait, py::arg("event"),
+        py::call_guard<py::gil_scoped_release>(),
+        "Block until a submission has finished");
+  m.def("poll", &tt::runtime::poll, py::arg("event"),
+        "Check whether a submission has finished without blocking");
+  m.def("start_capture", &tt::runtime::startCapture, py::arg("path"),
+        "Record every submission to a capture file");
+  m.def("stop_capture", &tt::runtime::stopCapture,
+        "Stop recording submissions");
+  m.def("replay_capture", &tt::runtime::replayCapture, py::arg("device"),
+        py::arg("path"), py::arg("preserve_timing") = true,
+        py::call_guard<py::gil_scoped_release>(),
+        "Re-issue the submissions of a capture file and report their "
+        "latencies");
+  m.def("set_host_thread_count", &tt::runtime::setHostThreadCount,
+        py::arg("num_threads"),
+        "Set the number of host threads used for layout conversions, 0 "
+        "restores the default");
+  m.def("set_op_trace_callback", &tt::runtime::setOpTraceCallback,
+        py::arg("callback"),
+        "Call callback with an OpTraceEvent after every operation, None "
+        "turns tracing off");
+  m.def("to_chrome_trace", &tt::runtime::toChromeTrace, py::arg("events"),
+        "Serialize OpTraceEvents as Chrome trace JSON");
 }
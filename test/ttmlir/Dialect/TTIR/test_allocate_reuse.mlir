@@ -0,0 +1,22 @@
+// RUN: ttmlir-opt --ttir-allocate="report-peak-usage=true" %s 2>&1 | FileCheck %s
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+#l1_ = #tt.memory_space<l1>
+#layout = #tt.layout<(d0, d1) -> (d0, d1), undef, <8x8>, memref<8x16xf32, #l1_>>
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 1048576, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  // CHECK: remark: peak l1 usage: 1024 bytes live, 1024 bytes planned, 1048576 bytes available
+  func.func @forward(%arg0: tensor<64x128xf32, #layout>, %arg1: tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout> {
+    // CHECK: "ttir.alloc"() <{address = 262144 : i64, {{.*}}size = 512 : i64}>
+    %0 = tensor.empty() : tensor<64x128xf32, #layout>
+    %1 = "ttir.multiply"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    // CHECK: "ttir.alloc"() <{address = 262656 : i64, {{.*}}size = 512 : i64}>
+    %2 = tensor.empty() : tensor<64x128xf32, #layout>
+    %3 = "ttir.add"(%1, %arg1, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    // CHECK: "ttir.dealloc"
+    // Dead buffer from the first multiply is reused.
+    // CHECK: "ttir.alloc"() <{address = 262144 : i64, {{.*}}size = 512 : i64}>
+    %4 = tensor.empty() : tensor<64x128xf32, #layout>
+    %5 = "ttir.add"(%3, %arg1, %4) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    // CHECK: "ttir.dealloc"
+    return %5 : tensor<64x128xf32, #layout>
+  }
+}
@@ -0,0 +1,44 @@
+// RUN: ttmlir-opt --ttir-layout --ttir-cost-model-report="grids=1,2" %s 2>&1 | FileCheck %s
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+#any_device_tile = #tt.operand_constraint<dram|l1|tile|any_device_tile>
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 1048576, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  func.func @add(%arg0: tensor<64x128xf32>, %arg1: tensor<64x128xf32>) -> tensor<64x128xf32> {
+    %0 = tensor.empty() : tensor<64x128xf32>
+    // 8 tiles, or 2 per core, at 32 FPU cycles each. Both inputs and the
+    // output shard sit in L1.
+    // CHECK: remark: ttir.add on 1x1: 10256 cycles, 98304 L1 bytes, 0 NOC bytes
+    // CHECK: remark: ttir.add on 2x2: 10064 cycles, 24576 L1 bytes, 0 NOC bytes
+    %1 = "ttir.add"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    return %1 : tensor<64x128xf32>
+  }
+
+  func.func @matmul(%arg0: tensor<64x128xf32>, %arg1: tensor<128x96xf32>) -> tensor<64x96xf32> {
+    %0 = tensor.empty() : tensor<64x96xf32>
+    // 2x3 output tiles over 4 K tiles on one core, 1x2 per core on 2x2. Every
+    // core pulls in its row and column panels.
+    // CHECK: remark: ttir.matmul on 1x1: 14096 cycles, 106496 L1 bytes, 81920 NOC bytes
+    // CHECK: remark: ttir.matmul on 2x2: 12048 cycles, 55296 L1 bytes, 196608 NOC bytes
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<64x128xf32>, tensor<128x96xf32>, tensor<64x96xf32>) -> tensor<64x96xf32>
+    return %1 : tensor<64x96xf32>
+  }
+
+  func.func @sum(%arg0: tensor<64x128xf32>) -> tensor<64x32xf32> {
+    %0 = tensor.empty() : tensor<64x32xf32>
+    // 8 input tiles split across the cores, partials gathered once there is
+    // more than one core.
+    // CHECK: remark: ttir.sum on 1x1: 10256 cycles, 40960 L1 bytes, 0 NOC bytes
+    // CHECK: remark: ttir.sum on 2x2: 10128 cycles, 10240 L1 bytes, 8192 NOC bytes
+    %1 = "ttir.sum"(%arg0, %0) <{dim_arg = [-1: i32], keep_dim = true, operand_constraints = [#any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x32xf32>) -> tensor<64x32xf32>
+    return %1 : tensor<64x32xf32>
+  }
+
+  func.func @softmax(%arg0: tensor<64x128xf32>) -> tensor<64x128xf32> {
+    %0 = tensor.empty() : tensor<64x128xf32>
+    // Three FPU and one SFPU pass per tile. Splitting the softmax dimension
+    // over 2 columns of cores exchanges the row partials.
+    // CHECK: remark: ttir.softmax on 1x1: 11280 cycles, 65536 L1 bytes, 0 NOC bytes
+    // CHECK: remark: ttir.softmax on 2x2: 10324 cycles, 16384 L1 bytes, 512 NOC bytes
+    %1 = "ttir.softmax"(%arg0, %0) <{dimension = -1 : si32, operand_constraints = [#any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    return %1 : tensor<64x128xf32>
+  }
+}
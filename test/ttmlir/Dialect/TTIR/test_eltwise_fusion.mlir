@@ -0,0 +1,40 @@
+// RUN: ttmlir-opt --ttir-eltwise-fusion --ttir-generic %s | FileCheck %s
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 1048576, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  // CHECK-LABEL: func.func @forward
+  func.func @forward(%arg0: tensor<64x128xf32>, %arg1: tensor<64x128xf32>) -> tensor<64x128xf32> {
+    // CHECK: "ttir.generic"(%arg0, %arg1, %[[OUT:[0-9]+]]) <{{.*}}operandSegmentSizes = array<i32: 2, 1>
+    // CHECK-NEXT: ^bb0(%[[A:[a-z0-9]+]]: tensor<64x128xf32>, %[[B:[a-z0-9]+]]: tensor<64x128xf32>, %[[DST:[a-z0-9]+]]: tensor<64x128xf32>):
+    // CHECK-NEXT: "ttir.kernel"(%[[A]], %[[B]], %[[DST]]) <{kind = @eltwise, op = @add
+    // CHECK-NEXT: "ttir.kernel"(%[[DST]], %[[DST]]) <{kind = @eltwise, op = @relu
+    // CHECK-NEXT: %[[R:[0-9]+]] = "ttir.kernel"(%[[DST]], %[[A]], %[[DST]]) <{kind = @eltwise, op = @mulitply
+    // CHECK-NEXT: "ttir.yield"(%[[R]])
+    // CHECK-NOT: "ttir.generic"
+    %0 = tensor.empty() : tensor<64x128xf32>
+    %1 = "ttir.add"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    %2 = tensor.empty() : tensor<64x128xf32>
+    %3 = "ttir.relu"(%1, %2) <{operandSegmentSizes = array<i32: 1, 1>, operand_constraints = [#any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    %4 = tensor.empty() : tensor<64x128xf32>
+    %5 = "ttir.multiply"(%3, %arg0, %4) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    return %5 : tensor<64x128xf32>
+  }
+
+  // A third distinct input starts a new generic.
+  // CHECK-LABEL: func.func @three_inputs
+  func.func @three_inputs(%arg0: tensor<64x128xf32>, %arg1: tensor<64x128xf32>, %arg2: tensor<64x128xf32>) -> tensor<64x128xf32> {
+    // CHECK: %[[FUSED:[0-9]+]] = "ttir.generic"(%arg0, %arg1, %{{[0-9]+}}) <{{.*}}operandSegmentSizes = array<i32: 2, 1>
+    // CHECK-NEXT: ^bb0(%[[A:[a-z0-9]+]]: tensor<64x128xf32>, %[[B:[a-z0-9]+]]: tensor<64x128xf32>, %[[DST:[a-z0-9]+]]: tensor<64x128xf32>):
+    // CHECK-NEXT: "ttir.kernel"(%[[A]], %[[B]], %[[DST]]) <{kind = @eltwise, op = @add
+    // CHECK-NEXT: %[[R:[0-9]+]] = "ttir.kernel"(%[[DST]], %[[DST]]) <{kind = @eltwise, op = @relu
+    // CHECK-NEXT: "ttir.yield"(%[[R]])
+    // CHECK: "ttir.generic"(%[[FUSED]], %arg2, %{{[0-9]+}}) <{{.*}}operandSegmentSizes = array<i32: 2, 1>
+    // CHECK: op = @mulitply
+    %0 = tensor.empty() : tensor<64x128xf32>
+    %1 = "ttir.add"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    %2 = tensor.empty() : tensor<64x128xf32>
+    %3 = "ttir.relu"(%1, %2) <{operandSegmentSizes = array<i32: 1, 1>, operand_constraints = [#any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    %4 = tensor.empty() : tensor<64x128xf32>
+    %5 = "ttir.multiply"(%3, %arg2, %4) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32>, tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+    return %5 : tensor<64x128xf32>
+  }
+}
@@ -0,0 +1,13 @@
+// RUN: ttmlir-opt --ttir-implicit-device --ttir-layout --ttir-grid-set %s | FileCheck %s
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 1048576, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  func.func @forward(%arg0: tensor<36x40xf32>, %arg1: tensor<36x40xf32>) -> tensor<36x40xf32> {
+    %0 = tensor.empty() : tensor<36x40xf32>
+    // 36 rows can not be split over 8 cores, the largest grid dividing the
+    // tensor is 6x8.
+    // CHECK: #[[LAYOUT:.*]] = #tt.layout<(d0, d1) -> (d0, d1), undef, <6x8>, memref<6x5xf32, #l1_>>
+    // CHECK: %[[C:.*]] = "ttir.multiply"[[C:.*]] -> tensor<36x40xf32, #[[LAYOUT]]>
+    %1 = "ttir.multiply"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<36x40xf32>, tensor<36x40xf32>, tensor<36x40xf32>) -> tensor<36x40xf32>
+    return %1 : tensor<36x40xf32>
+  }
+}
@@ -0,0 +1,27 @@
+// RUN: ttmlir-opt --ttir-spill-to-dram --ttir-allocate %s | FileCheck %s
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+#l1_ = #tt.memory_space<l1>
+#layout = #tt.layout<(d0, d1) -> (d0, d1), undef, <8x8>, memref<8x16xf32, #l1_>>
+// L1 only fits three 512 byte buffers above the 256KB base address, the
+// second add needs four live at once so %1 has to go to DRAM.
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 263680, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  func.func @forward(%arg0: tensor<64x128xf32, #layout>, %arg1: tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout> {
+    %0 = tensor.empty() : tensor<64x128xf32, #layout>
+    // CHECK: %[[MUL:.*]] = "ttir.multiply"
+    %1 = "ttir.multiply"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    // CHECK: %[[DRAM:.*]] = "ttir.alloc"() <{{.*}}memory_space = #dram
+    // CHECK: %[[SPILL:.*]] = "ttir.to_layout"(%[[MUL]], %[[DRAM]])
+    // CHECK: "ttir.dealloc"(%{{.*}})
+    %2 = tensor.empty() : tensor<64x128xf32, #layout>
+    %3 = "ttir.add"(%arg0, %arg1, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    %4 = tensor.empty() : tensor<64x128xf32, #layout>
+    %5 = "ttir.multiply"(%arg0, %arg1, %4) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    %6 = tensor.empty() : tensor<64x128xf32, #layout>
+    %7 = "ttir.add"(%3, %5, %6) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    %8 = tensor.empty() : tensor<64x128xf32, #layout>
+    // CHECK: %[[FILL:.*]] = "ttir.to_layout"(%[[SPILL]], %{{.*}})
+    // CHECK: "ttir.add"(%{{.*}}, %[[FILL]], %{{.*}})
+    %9 = "ttir.add"(%7, %1, %8) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>, tensor<64x128xf32, #layout>) -> tensor<64x128xf32, #layout>
+    return %9 : tensor<64x128xf32, #layout>
+  }
+}
@@ -0,0 +1,56 @@
+// RUN: ttmlir-opt --ttir-layout --ttnn-open-device --convert-ttir-to-ttnn %s | FileCheck %s
+#any_device_tile = #tt.operand_constraint<dram|l1|tile|any_device_tile>
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 1048576, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  // CHECK-LABEL: func.func @matmul_bias
+  func.func @matmul_bias(%arg0: tensor<1x128xbf16>, %arg1: tensor<128x96xbf16>, %arg2: tensor<1x96xbf16>) -> tensor<1x96xbf16> {
+    %0 = tensor.empty() : tensor<1x96xbf16>
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<1x128xbf16>, tensor<128x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    %2 = tensor.empty() : tensor<1x96xbf16>
+    // CHECK-NOT: "ttnn.add"
+    // CHECK: "ttnn.matmul"
+    // CHECK-SAME: operandSegmentSizes = array<i32: 1, 1, 1, 1>
+    // CHECK-NOT: "ttnn.add"
+    %3 = "ttir.add"(%1, %arg2, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<1x96xbf16>, tensor<1x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    return %3 : tensor<1x96xbf16>
+  }
+
+  // CHECK-LABEL: func.func @matmul_bias_relu
+  func.func @matmul_bias_relu(%arg0: tensor<1x128xbf16>, %arg1: tensor<128x96xbf16>, %arg2: tensor<1x96xbf16>) -> tensor<1x96xbf16> {
+    %0 = tensor.empty() : tensor<1x96xbf16>
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<1x128xbf16>, tensor<128x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    %2 = tensor.empty() : tensor<1x96xbf16>
+    %3 = "ttir.add"(%arg2, %1, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<1x96xbf16>, tensor<1x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    %4 = tensor.empty() : tensor<1x96xbf16>
+    // CHECK-NOT: "ttnn.add"
+    // CHECK: "ttnn.matmul"
+    // CHECK-SAME: activation = #ttnn.matmul_activation<relu>
+    // CHECK-NOT: "ttnn.relu"
+    %5 = "ttir.relu"(%3, %4) <{operandSegmentSizes = array<i32: 1, 1>, operand_constraints = [#any_device, #any_device]}> : (tensor<1x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    return %5 : tensor<1x96xbf16>
+  }
+
+  // ttnn broadcasts the matmul bias over rows, a full shape addend stays an add.
+  // CHECK-LABEL: func.func @matmul_full_bias
+  func.func @matmul_full_bias(%arg0: tensor<64x128xbf16>, %arg1: tensor<128x96xbf16>, %arg2: tensor<64x96xbf16>) -> tensor<64x96xbf16> {
+    %0 = tensor.empty() : tensor<64x96xbf16>
+    // CHECK: "ttnn.matmul"
+    // CHECK-SAME: operandSegmentSizes = array<i32: 1, 1, 0, 1>
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<64x128xbf16>, tensor<128x96xbf16>, tensor<64x96xbf16>) -> tensor<64x96xbf16>
+    %2 = tensor.empty() : tensor<64x96xbf16>
+    // CHECK: "ttnn.add"
+    %3 = "ttir.add"(%1, %arg2, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x96xbf16>, tensor<64x96xbf16>, tensor<64x96xbf16>) -> tensor<64x96xbf16>
+    return %3 : tensor<64x96xbf16>
+  }
+
+  // CHECK-LABEL: func.func @matmul_shared
+  func.func @matmul_shared(%arg0: tensor<64x128xbf16>, %arg1: tensor<128x96xbf16>, %arg2: tensor<64x96xbf16>) -> (tensor<64x96xbf16>, tensor<64x96xbf16>) {
+    %0 = tensor.empty() : tensor<64x96xbf16>
+    // CHECK: "ttnn.matmul"
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<64x128xbf16>, tensor<128x96xbf16>, tensor<64x96xbf16>) -> tensor<64x96xbf16>
+    %2 = tensor.empty() : tensor<64x96xbf16>
+    // CHECK: "ttnn.add"
+    %3 = "ttir.add"(%1, %arg2, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<64x96xbf16>, tensor<64x96xbf16>, tensor<64x96xbf16>) -> tensor<64x96xbf16>
+    return %1, %3 : tensor<64x96xbf16>, tensor<64x96xbf16>
+  }
+}
@@ -0,0 +1,38 @@
+// RUN: ttmlir-opt --ttir-layout --ttnn-open-device --convert-ttir-to-ttnn --convert-ttnn-to-emitc %s | FileCheck %s
+#any_device_tile = #tt.operand_constraint<dram|l1|tile|any_device_tile>
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 1048576, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  // CHECK-LABEL: func.func @matmul_bias_relu
+  func.func @matmul_bias_relu(%arg0: tensor<1x128xbf16>, %arg1: tensor<128x96xbf16>, %arg2: tensor<1x96xbf16>) -> tensor<1x96xbf16> {
+    %0 = tensor.empty() : tensor<1x96xbf16>
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<1x128xbf16>, tensor<128x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    %2 = tensor.empty() : tensor<1x96xbf16>
+    %3 = "ttir.add"(%1, %arg2, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<1x96xbf16>, tensor<1x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    %4 = tensor.empty() : tensor<1x96xbf16>
+    // CHECK: emitc.call_opaque "ttnn::operations::matmul::matmul"(%{{[^,]*}}, %{{[^,]*}}, %{{[^,)]*}})
+    // CHECK-SAME: {args = [0 : index, 1 : index, 2 : index, #emitc.opaque<"std::monostate{}">, #emitc.opaque<"ttnn::DRAM_MEMORY_CONFIG">, #emitc.opaque<"std::nullopt">, #emitc.opaque<"\22relu\22">]}
+    // CHECK-NOT: "ttnn::relu"
+    %5 = "ttir.relu"(%3, %4) <{operandSegmentSizes = array<i32: 1, 1>, operand_constraints = [#any_device, #any_device]}> : (tensor<1x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    return %5 : tensor<1x96xbf16>
+  }
+
+  // CHECK-LABEL: func.func @matmul_bias(
+  func.func @matmul_bias(%arg0: tensor<1x128xbf16>, %arg1: tensor<128x96xbf16>, %arg2: tensor<1x96xbf16>) -> tensor<1x96xbf16> {
+    %0 = tensor.empty() : tensor<1x96xbf16>
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<1x128xbf16>, tensor<128x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    %2 = tensor.empty() : tensor<1x96xbf16>
+    // CHECK: emitc.call_opaque "ttnn::operations::matmul::matmul"(%{{[^,]*}}, %{{[^,]*}}, %{{[^,)]*}})
+    // CHECK-SAME: {args = [0 : index, 1 : index, 2 : index, #emitc.opaque<"std::monostate{}">, #emitc.opaque<"ttnn::DRAM_MEMORY_CONFIG">, #emitc.opaque<"std::nullopt">, #emitc.opaque<"std::nullopt">]}
+    %3 = "ttir.add"(%1, %arg2, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<1x96xbf16>, tensor<1x96xbf16>, tensor<1x96xbf16>) -> tensor<1x96xbf16>
+    return %3 : tensor<1x96xbf16>
+  }
+
+  // CHECK-LABEL: func.func @matmul(
+  func.func @matmul(%arg0: tensor<64x128xbf16>, %arg1: tensor<128x96xbf16>) -> tensor<64x96xbf16> {
+    %0 = tensor.empty() : tensor<64x96xbf16>
+    // CHECK: emitc.call_opaque "ttnn::matmul"(%{{[^,]*}}, %{{[^,]*}}, %{{[^,)]*}})
+    // CHECK-NOT: args
+    %1 = "ttir.matmul"(%arg0, %arg1, %0) <{operand_constraints = [#any_device_tile, #any_device_tile, #any_device_tile]}> : (tensor<64x128xbf16>, tensor<128x96xbf16>, tensor<64x96xbf16>) -> tensor<64x96xbf16>
+    return %1 : tensor<64x96xbf16>
+  }
+}
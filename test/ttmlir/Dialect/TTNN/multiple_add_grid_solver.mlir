@@ -0,0 +1,36 @@
+// RUN: ttmlir-opt --ttir-to-ttnn-backend-pipeline="override-grid-sizes=add_1=4x4,add_3=4x4,add_4=8x8" %s | FileCheck %s
+#any_device = #tt.operand_constraint<dram|l1|scalar|tile|any_device|any_device_tile>
+module attributes {tt.system_desc = #tt.system_desc<[{arch = <wormhole_b0>, grid = 8x8, l1_size = 1048576, num_dram_channels = 12, dram_channel_size = 1048576, noc_l1_address_align_bytes = 16, pcie_address_align_bytes = 32, noc_dram_address_align_bytes = 32}], [0], [<pcie|host_mmio>], [<0, 0, 0, 0>]>} {
+  // CHECK: #[[SMALL:.*]] = #tt.layout<(d0, d1) -> (d0, d1), undef, <4x4>, memref<8x8xf32, #l1_>>
+  // CHECK: #[[LARGE:.*]] = #tt.layout<(d0, d1) -> (d0, d1), undef, <8x8>, memref<4x4xf32, #l1_>>
+  // CHECK-LABEL: func.func @forward
+  func.func @forward(%arg0: tensor<32x32xf32>, %arg1: tensor<32x32xf32>) -> tensor<32x32xf32> {
+    %0 = tensor.empty() : tensor<32x32xf32> loc(#loc1)
+    // CHECK: %[[ADD1:.*]] = "ttnn.add"{{.*}} -> tensor<32x32xf32, #[[SMALL]]>
+    %1 = "ttir.add"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<32x32xf32>, tensor<32x32xf32>, tensor<32x32xf32>) -> tensor<32x32xf32> loc(#loc1)
+    %2 = tensor.empty() : tensor<32x32xf32> loc(#loc2)
+    // Resharding %1 onto 8x8 costs more than running the second add on the
+    // same 4x4 grid, so it reads %1 as is.
+    // CHECK-NOT: "ttnn.to_memory_config"(%[[ADD1]]
+    // CHECK: "ttnn.add"(%[[ADD1]], {{.*}} -> tensor<32x32xf32, #[[SMALL]]>
+    %3 = "ttir.add"(%1, %arg0, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<32x32xf32>, tensor<32x32xf32>, tensor<32x32xf32>) -> tensor<32x32xf32> loc(#loc2)
+    return %3 : tensor<32x32xf32>
+  }
+
+  // CHECK-LABEL: func.func @reshard
+  func.func @reshard(%arg0: tensor<32x32xf32>, %arg1: tensor<32x32xf32>) -> tensor<32x32xf32> {
+    %0 = tensor.empty() : tensor<32x32xf32> loc(#loc3)
+    // CHECK: %[[ADD3:.*]] = "ttnn.add"{{.*}} -> tensor<32x32xf32, #[[SMALL]]>
+    %1 = "ttir.add"(%arg0, %arg1, %0) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<32x32xf32>, tensor<32x32xf32>, tensor<32x32xf32>) -> tensor<32x32xf32> loc(#loc3)
+    %2 = tensor.empty() : tensor<32x32xf32> loc(#loc4)
+    // Both grids are pinned, so %1 has to be moved onto 8x8 before use.
+    // CHECK: %[[MOVED:.*]] = "ttnn.to_memory_config"(%[[ADD3]], {{.*}} -> tensor<32x32xf32, #[[LARGE]]>
+    // CHECK: "ttnn.add"(%[[MOVED]], {{.*}} -> tensor<32x32xf32, #[[LARGE]]>
+    %3 = "ttir.add"(%1, %arg0, %2) <{operandSegmentSizes = array<i32: 2, 1>, operand_constraints = [#any_device, #any_device, #any_device]}> : (tensor<32x32xf32>, tensor<32x32xf32>, tensor<32x32xf32>) -> tensor<32x32xf32> loc(#loc4)
+    return %3 : tensor<32x32xf32>
+  }
+}
+#loc1 = loc("add_1")
+#loc2 = loc("add_2")
+#loc3 = loc("add_3")
+#loc4 = loc("add_4")